@@ -83,6 +83,7 @@ F90=$(FC) -ff90
 ##F_LIBS:=-lg2c # Linux g77, compat-gcc v3.2
 F_LIBS:=-lgfortran # Linux gfortran, gcc v4
 ##F_LIBS:=-lfortran # Solaris; IRIX
+THREAD_LIBS:=-lboost_thread -lboost_system -lpthread
 
 
 ##########
@@ -0,0 +1,163 @@
+// -*- C++ -*-
+// Implementation of class BroydenJacobian
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+BroydenJacobian_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <algorithm>
+#include "BroydenJacobian.h"
+#include "MathTools.h"
+
+
+using namespace jpw_nld::fortlib;
+using jpw_nld::index_t;
+
+
+//
+// Static variables
+//
+
+
+const double BroydenJacobian::DEFAULT_MIN_STEP_QUALITY(0.75);
+
+
+//
+// Typedefs
+//
+
+
+/////////////////////////
+
+//
+// BroydenJacobian Member Functions
+//
+
+
+BroydenJacobian::BroydenJacobian(index_t ndata_max, index_t nparm)
+    : m__nparams(nparm)
+    , m__maxUpdates(DEFAULT_MAX_UPDATES)
+    , m__minStepQuality(DEFAULT_MIN_STEP_QUALITY)
+    , m__haveJacobian(false)
+    , m__sinceRefresh(0)
+    , m__trialSteps(0)
+    , m__nRefreshes(0)
+    , m__nUpdates(0)
+    , m__jacob(ndata_max*nparm)
+    , m__lastX(nparm)
+    , m__lastF(ndata_max)
+    , m__dx(nparm)
+{}
+
+
+void BroydenJacobian::resize(index_t ndata_max)
+{
+    m__jacob.resize(ndata_max*m__nparams);
+    m__lastF.resize(ndata_max);
+    reset();
+}
+
+
+void BroydenJacobian::reset()
+{
+    m__haveJacobian = false;
+    m__sinceRefresh = 0;
+    m__trialSteps = 0;
+    m__nRefreshes = 0;
+    m__nUpdates = 0;
+}
+
+
+void BroydenJacobian::store(const double* x, const double* fvec,
+                            const double* fjac, int mm, int ld_fjac)
+{
+    for(index_t j=0; j<m__nparams; ++j) {
+        std::copy(fjac + j*ld_fjac, fjac + j*ld_fjac + mm,
+                  &m__jacob[j*mm]);
+    }
+    std::copy(x, x + m__nparams, m__lastX.begin());
+    std::copy(fvec, fvec + mm, m__lastF.begin());
+
+    m__haveJacobian = true;
+    m__sinceRefresh = 0;
+    m__trialSteps = 0;
+    ++m__nRefreshes;
+}
+
+
+bool BroydenJacobian::update(const double* x, const double* fvec,
+                             double* fjac, int mm, int ld_fjac)
+{
+    if( !m__haveJacobian || (m__sinceRefresh >= m__maxUpdates) ) {
+        return false;
+    }
+
+    double dxSq(0.0);
+    for(index_t j=0; j<m__nparams; ++j) {
+        m__dx[j] = x[j] - m__lastX[j];
+        dxSq += jpw_math::SQR(m__dx[j]);
+    }
+    if(dxSq == 0.0) {
+        return false;
+    }
+
+    // Judge the step by comparing the reduction in Chi^2 predicted by the
+    // old Jacobian with the actual one.
+    double chiSqOld(0.0), chiSqNew(0.0), chiSqPredicted(0.0);
+    for(int i=0; i<mm; ++i)
+    {
+        double jdx(0.0);
+        for(index_t j=0; j<m__nparams; ++j) {
+            jdx += m__jacob[i + j*mm]*m__dx[j];
+        }
+        chiSqOld += jpw_math::SQR(m__lastF[i]);
+        chiSqNew += jpw_math::SQR(fvec[i]);
+        chiSqPredicted += jpw_math::SQR(m__lastF[i] + jdx);
+    }
+    double predictedReduction = chiSqOld - chiSqPredicted;
+    if( (predictedReduction <= 0.0) ||
+        ((chiSqOld - chiSqNew) < m__minStepQuality*predictedReduction) )
+    {
+        return false;
+    }
+
+    // The rank-1 update itself.
+    for(int i=0; i<mm; ++i)
+    {
+        double jdx(0.0);
+        for(index_t j=0; j<m__nparams; ++j) {
+            jdx += m__jacob[i + j*mm]*m__dx[j];
+        }
+        double scaledErr = (fvec[i] - m__lastF[i] - jdx)/dxSq;
+        for(index_t j=0; j<m__nparams; ++j) {
+            m__jacob[i + j*mm] += scaledErr*m__dx[j];
+            fjac[i + j*ld_fjac] = m__jacob[i + j*mm];
+        }
+    }
+    std::copy(x, x + m__nparams, m__lastX.begin());
+    std::copy(fvec, fvec + mm, m__lastF.begin());
+
+    ++m__sinceRefresh;
+    m__trialSteps = 0;
+    ++m__nUpdates;
+    return true;
+}
+
+
+/////////////////////////
+//
+// End
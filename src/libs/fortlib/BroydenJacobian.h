@@ -0,0 +1,213 @@
+// -*- C++ -*-
+// Header file for class BroydenJacobian
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _BroydenJacobian_H_
+#define _BroydenJacobian_H_
+
+// Includes
+//
+#include <boost/utility.hpp>
+#include "jpw_nld.h"
+#include "FORTTypes.h"
+#include "Matrix.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace fortlib {
+
+
+  // Class BroydenJacobian
+  /**
+   * Approximates the Jacobian between full evaluations using Broyden's
+   * rank-1 secant update.
+   *
+   * \c lmder_() asks for a new Jacobian at the start of every iteration,
+   * right after it accepts a step from \f$ x_{k-1} \f$ to \f$ x_{k} \f$.
+   * Both ends of that step, and the residuals there, are already known.  So
+   * the previous Jacobian can be corrected along the step direction, at a
+   * cost of \f$ O(m\,n) \f$ multiply-adds instead of a full evaluation of
+   * the model's partial-derivatives:
+   * \f[
+   * J_{k} = J_{k-1} +
+   * \frac{\left(f_{k} - f_{k-1} - J_{k-1}\,\Delta x\right)\,
+   *       \Delta x^{T}}
+   *      {\Delta x^{T}\,\Delta x}
+   * \qquad \Delta x \equiv x_{k} - x_{k-1}
+   * \f]
+   *
+   * The approximation degrades with each update, so it's thrown away and
+   * the true Jacobian recomputed whenever:
+   * - the linear model built from \f$ J_{k-1} \f$ predicted the reduction in
+   *   \f$\chi^2\f$ poorly.  The \em step \em quality is the ratio of the
+   *   actual to the predicted reduction; any step whose quality is below
+   *   \c minStepQuality() triggers a refresh.
+   * - \c maxUpdates() consecutive updates have been made.
+   *
+   * This class needs its own copy of the Jacobian, since \c lmder_()
+   * overwrites the one it's given with its QR-factorization.
+   */
+  class BroydenJacobian : private boost::noncopyable
+  {
+  public:
+      /// Default value for \c maxUpdates().
+      static const unsigned DEFAULT_MAX_UPDATES=3;
+      /// Default value for \c minStepQuality().
+      static const double DEFAULT_MIN_STEP_QUALITY;
+      /// The number of trial steps \c lmder_() may take with an updated
+      /// Jacobian before \c countTrialStep() gives up on it.
+      static const unsigned MAX_TRIAL_STEPS=2;
+
+      /// Constructor
+      /**
+       * The arguments have the same meanings as those of the \c FitLM
+       * c'tor.
+       */
+      BroydenJacobian(index_t ndata_max, index_t nparm);
+
+      /// Destructor
+      ~BroydenJacobian() {}
+
+      /// Forget the stored Jacobian and zero the counters.
+      /**
+       * Call at the start of each fit.
+       */
+      void reset();
+
+      /// Change the maximum number of data points.
+      /**
+       * Only allocates memory if \a ndata_max is larger than any size used
+       * before.  Also calls \c reset().
+       */
+      void resize(index_t ndata_max);
+
+      /// Try to produce the Jacobian at \a x by updating the stored one.
+      /**
+       * \param x
+       * The current parameters, \f$ x_{k} \f$.
+       *
+       * \param fvec
+       * The \a mm residuals at \a x.
+       *
+       * \param fjac
+       * Destination of the updated Jacobian, in the layout required by \c
+       * FitLM::fit_function_ptr_t.  Left unaltered when this function
+       * returns \c false.
+       *
+       * \param mm
+       * The number of residuals.
+       *
+       * \param ld_fjac
+       * The leading dimension of \a fjac.
+       *
+       * \returns \c false when the Jacobian must be evaluated in full
+       * instead.  Pass the result of that evaluation to \c store().
+       */
+      bool update(const double* x, const double* fvec, double* fjac,
+                  int mm, int ld_fjac);
+
+      /// Keep a fully-evaluated Jacobian for use by later updates.
+      /**
+       * The arguments are the same as those of \c update(), except that \a
+       * fjac is an input.
+       */
+      void store(const double* x, const double* fvec, const double* fjac,
+                 int mm, int ld_fjac);
+
+      /// Forget the stored Jacobian, but keep the counters.
+      /**
+       * Forces the next Jacobian to be fully evaluated.
+       */
+      void invalidate()
+      {
+          m__haveJacobian = false;
+          m__sinceRefresh = 0;
+          m__trialSteps = 0;
+      }
+
+      /// Counts a trial step taken with the current Jacobian.
+      /**
+       * Call whenever \c lmder_() evaluates the function.  Every step that
+       * it rejects means another evaluation without a new Jacobian.
+       *
+       * \returns \c false if the current Jacobian is an update, and more
+       * than \c MAX_TRIAL_STEPS have been tried with it.  It's cheaper to
+       * restart the fit with a full evaluation than to keep shrinking the
+       * step.
+       */
+      bool countTrialStep()
+      {
+          ++m__trialSteps;
+          return ( !isApproximate() || (m__trialSteps <= MAX_TRIAL_STEPS) );
+      }
+
+      /// \c true if the last Jacobian handed to \c lmder_() came from \c
+      /// update(), rather than a full evaluation.
+      bool isApproximate() const
+      { return (m__sinceRefresh > 0); }
+
+      /// Maximum number of consecutive updates between full evaluations.
+      unsigned maxUpdates() const
+      { return m__maxUpdates; }
+
+      /// Sets \c maxUpdates().  \c 0 disables the updates completely.
+      void setMaxUpdates(unsigned n)
+      { m__maxUpdates = n; }
+
+      /// The step-quality threshold below which the Jacobian is refreshed.
+      double minStepQuality() const
+      { return m__minStepQuality; }
+
+      /// Sets \c minStepQuality().
+      void setMinStepQuality(double q)
+      { m__minStepQuality = q; }
+
+      /// The number of full evaluations passed to \c store() since the last
+      /// \c reset().
+      unsigned nRefreshes() const
+      { return m__nRefreshes; }
+
+      /// The number of successful calls to \c update() since the last \c
+      /// reset().
+      unsigned nUpdates() const
+      { return m__nUpdates; }
+
+  private:
+      index_t m__nparams;
+      unsigned m__maxUpdates;
+      double m__minStepQuality;
+      bool m__haveJacobian;
+      unsigned m__sinceRefresh;
+      unsigned m__trialSteps;
+      unsigned m__nRefreshes;
+      unsigned m__nUpdates;
+      dvector_t m__jacob;
+      dvector_t m__lastX;
+      dvector_t m__lastF;
+      dvector_t m__dx;
+  };
+
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_BroydenJacobian_H_
+/////////////////////////
+//
+// End
@@ -0,0 +1,131 @@
+// -*- C++ -*-
+// Implementation of class FDJacobian
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+FDJacobian_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "FDJacobian.h"
+
+
+using namespace jpw_nld::fortlib;
+using jpw_nld::index_t;
+
+
+//
+// Static variables
+//
+
+
+static const double FORWARD_REL_STEP =
+    std::sqrt(std::numeric_limits<double>::epsilon());
+static const double CENTRAL_REL_STEP =
+    std::pow(std::numeric_limits<double>::epsilon(), 1.0/3.0);
+
+
+//
+// Typedefs
+//
+
+
+/////////////////////////
+
+//
+// FDJacobian Member Functions
+//
+
+
+FDJacobian::FDJacobian(index_t ndata_max, index_t nparm)
+    : m__ndataMax(ndata_max)
+    , m__nparams(nparm)
+    , m__central(false)
+    , m__typicalSize(nparm, 1.0)
+    , m__steps(nparm)
+    , m__points(2*nparm*nparm)
+    , m__residuals(2*nparm*ndata_max)
+{}
+
+
+void FDJacobian::resize(index_t ndata_max)
+{
+    m__ndataMax = ndata_max;
+    m__residuals.resize(2*m__nparams*ndata_max);
+}
+
+
+void FDJacobian::prepare(const double* x)
+{
+    double relStep(m__central ? CENTRAL_REL_STEP : FORWARD_REL_STEP);
+    unsigned nEvals(nEvaluations());
+
+    for(unsigned k=0; k<nEvals; ++k) {
+        std::copy(x, x + m__nparams, &m__points[k*m__nparams]);
+    }
+
+    for(index_t j=0; j<m__nparams; ++j)
+    {
+        double h = relStep*std::max(std::fabs(x[j]), m__typicalSize[j]);
+        if(h == 0.0) {
+            h = relStep;
+        }
+
+        // Make (x+h) - x exact, so that the only error in the difference
+        // quotient comes from the function values.
+        volatile double xph = x[j] + h;
+        h = xph - x[j];
+        m__steps[j] = h;
+
+        if(m__central) {
+            m__points[2*j*m__nparams + j] = x[j] + h;
+            m__points[(2*j + 1)*m__nparams + j] = x[j] - h;
+        } else {
+            m__points[j*m__nparams + j] = x[j] + h;
+        }
+    }
+}
+
+
+void FDJacobian::assemble(const double* fvec, double* fjac,
+                          int mm, int ld_fjac) const
+{
+    for(index_t j=0; j<m__nparams; ++j)
+    {
+        double* jacCol = fjac + j*ld_fjac;
+        if(m__central) {
+            const double* fPlus = &m__residuals[2*j*m__ndataMax];
+            const double* fMinus = fPlus + m__ndataMax;
+            double inv2h = 0.5/m__steps[j];
+            for(int i=0; i<mm; ++i) {
+                jacCol[i] = (fPlus[i] - fMinus[i])*inv2h;
+            }
+        } else {
+            const double* fPlus = &m__residuals[j*m__ndataMax];
+            double invh = 1.0/m__steps[j];
+            for(int i=0; i<mm; ++i) {
+                jacCol[i] = (fPlus[i] - fvec[i])*invh;
+            }
+        }
+    }
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,177 @@
+// -*- C++ -*-
+// Header file for class FDJacobian
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _FDJacobian_H_
+#define _FDJacobian_H_
+
+// Includes
+//
+#include <boost/utility.hpp>
+#include "jpw_nld.h"
+#include "FORTTypes.h"
+#include "Matrix.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace fortlib {
+
+
+  // Class FDJacobian
+  /**
+   * Approximates the Jacobian by finite differences of the fit-function.
+   *
+   * The forward-difference approximation of the \f$ j^{th} \f$ column is:
+   * \f[
+   * J_{j} \approx \frac{f\left(x + h_{j}\,e_{j}\right) - f\left(x\right)}
+   *                    {h_{j}}
+   * \f]
+   * The central-difference approximation is:
+   * \f[
+   * J_{j} \approx \frac{f\left(x + h_{j}\,e_{j}\right) -
+   *                     f\left(x - h_{j}\,e_{j}\right)}
+   *                    {2\,h_{j}}
+   * \f]
+   * The former needs one function evaluation per parameter, since \c
+   * lmder_() already has \f$ f\left(x\right) \f$.  The latter needs two,
+   * but its truncation error is \f$ O(h^2) \f$ rather than \f$ O(h) \f$.
+   *
+   * The step sizes are chosen automatically:
+   * \f[
+   * h_{j} = \epsilon_{r}\,\max\left(\left|x_{j}\right|,\, s_{j}\right)
+   * \f]
+   * where \f$ s_{j} \f$ is the \c typicalSize() of the parameter.  The
+   * relative step, \f$ \epsilon_{r} \f$, balances truncation error against
+   * roundoff:  it's \f$ \sqrt{\epsilon} \f$ for forward differences and
+   * \f$ \sqrt[3]{\epsilon} \f$ for central ones, where \f$ \epsilon \f$ is
+   * the machine precision.  Each \f$ h_{j} \f$ is then adjusted so that
+   * \f$ x_{j} + h_{j} \f$ is exactly representable.
+   *
+   * Each function evaluation has its own parameter vector and residual
+   * buffer, so they can all run concurrently.  Usage:
+   * -# Call \c prepare() with the current parameters.
+   * -# Evaluate the fit-function at each \c point(), storing the result in
+   *    the corresponding \c residuals().  (There are \c nEvaluations() of
+   *    them.)
+   * -# Call \c assemble().
+   */
+  class FDJacobian : private boost::noncopyable
+  {
+  public:
+      /// Constructor
+      /**
+       * The arguments have the same meanings as those of the \c FitLM
+       * c'tor.
+       */
+      FDJacobian(index_t ndata_max, index_t nparm);
+
+      /// Destructor
+      ~FDJacobian() {}
+
+      /// Change the maximum number of data points.
+      /**
+       * Only allocates memory if \a ndata_max is larger than any size used
+       * before.
+       */
+      void resize(index_t ndata_max);
+
+      /// Select central (\c true) or forward (\c false) differences.
+      void setCentral(bool central)
+      { m__central = central; }
+
+      /// \c true if using central differences.
+      bool isCentral() const
+      { return m__central; }
+
+      /// The number of function evaluations per Jacobian.
+      unsigned nEvaluations() const
+      { return (m__central ? 2*m__nparams : m__nparams); }
+
+      /// Sets the typical magnitude of parameter \a j.
+      /**
+       * The step size never falls below a fixed fraction of this value, even
+       * when the parameter is near zero.  The default is \c 1.
+       */
+      void setTypicalSize(index_t j, double size)
+      { m__typicalSize[j] = size; }
+
+      /// The typical magnitude of parameter \a j.
+      double typicalSize(index_t j) const
+      { return m__typicalSize[j]; }
+
+      /// Chooses the step sizes and builds the parameter vectors at which
+      /// the fit-function must be evaluated.
+      /**
+       * \param x
+       * The current parameters.
+       */
+      void prepare(const double* x);
+
+      /// The parameters for the \a k<sup>th</sup> function evaluation.
+      /**
+       * Not \c const, since some fit-functions adjust their parameters.
+       */
+      fort_dvec_t point(unsigned k)
+      { return &m__points[k*m__nparams]; }
+
+      /// Where to store the residuals from the \a k<sup>th</sup> function
+      /// evaluation.
+      fort_dvec_t residuals(unsigned k)
+      { return &m__residuals[k*m__ndataMax]; }
+
+      /// The step size used for parameter \a j by the last \c prepare().
+      double step(index_t j) const
+      { return m__steps[j]; }
+
+      /// Computes the Jacobian from the function evaluations.
+      /**
+       * \param fvec
+       * The \a mm residuals at the parameters passed to \c prepare().
+       *
+       * \param fjac
+       * Destination of the Jacobian, in the layout required by \c
+       * FitLM::fit_function_ptr_t.
+       *
+       * \param mm
+       * The number of residuals.
+       *
+       * \param ld_fjac
+       * The leading dimension of \a fjac.
+       */
+      void assemble(const double* fvec, double* fjac,
+                    int mm, int ld_fjac) const;
+
+  private:
+      index_t m__ndataMax;
+      index_t m__nparams;
+      bool m__central;
+      dvector_t m__typicalSize;
+      dvector_t m__steps;
+      dvector_t m__points;
+      dvector_t m__residuals;
+  };
+
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_FDJacobian_H_
+/////////////////////////
+//
+// End
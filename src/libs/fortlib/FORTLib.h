@@ -40,47 +40,61 @@ namespace jpw_nld {
   {
    /// Invert a square matrix using Gauss-Jordan Elimination.
    /**
+    * 1x1, 2x2 and 4x4 matrices are inverted in closed form (the 4x4 one
+    * via its adjugate), since these are the sizes of the covariance
+    * matrices of the barrier models.  Larger matrices use Gauss-Jordan
+    * elimination with full pivoting.
+    *
     * \param dm
     * The square matrix to invert.
     *
     * \param dm_inv
-    * The resulting inverse matrix.
-   int sqmInvert_GJE(const dmatrix_t& dm, dmatrix_t& dm_inv);
+    * The resulting inverse matrix.  Unchanged if \a dm is singular.  May
+    * be the same object as \a dm.
+    *
+    * \returns \c 0 on success, nonzero if \a dm is (numerically)
+    * singular.
+    *
+    * \throws SizeMismatchError if \a dm isn't square.
     */
+   int sqmInvert_GJE(const dmatrix_t& dm, dmatrix_t& dm_inv);
 
    /// Invert a square matrix using Singular-Value Decomposition.
    /**
+    * Computes the pseudo-inverse of \a dm, using a one-sided Jacobi SVD.
+    * Singular values too small to distinguish from roundoff are treated
+    * as zero, so this also works on singular and ill-conditioned matrices,
+    * at a few times the cost of \c sqmInvert_GJE().
+    *
     * \param dm
     * The matrix to invert.
     *
     * \param dm_inv
-    * The resulting inverse matrix.
-   int sqmInvert_SVD(const dmatrix_t& dm, dmatrix_t& dm_inv);
+    * The resulting inverse matrix.  May be the same object as \a dm.
+    *
+    * \returns The number of singular values treated as zero, i.e. \c 0
+    * if \a dm_inv is the true inverse.
+    *
+    * \throws SizeMismatchError if \a dm isn't square.
     */
+   int sqmInvert_SVD(const dmatrix_t& dm, dmatrix_t& dm_inv);
   };
 
   /// Numeric sorting functions.
   namespace sort
   {
-   /**
-    * Exception thrown due to errors in the internal FORTRAN sort algorithm.
-    */
-   struct SortError : public std::runtime_error
-   {
-       SortError(const string& where, const string& fortFn, int errCode);
-   private:
-       string errMessage(const string& where,
-                         const string& fortFn, int errCode);
-   };
-
    /// Sort a list non-destructively, returning a list of sorted indices.
    /**
+    * New code should use \c jpw_math::argSort() or \c jpw_math::argTopK(),
+    * from \c "ArgSort.h", which return 0-based indices.
+    *
     * \param dlst
     * The vector to sort.
     *
     * \param idxarr
-    * The list to return the results in.  Iterating over \c
-    * dlst[idxarr[i]] will return the values of \c dlst in sorted order.
+    * The list to return the results in, resized to the size of \a dlst.
+    * The indices are 1-based, as FORTRAN's are:  iterating over \c
+    * dlst[idxarr[i]-1] will return the values of \c dlst in sorted order.
     *
     * \param dir
     * The sort direction.  A negative number sorts in descending order.  A
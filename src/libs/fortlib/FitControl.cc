@@ -0,0 +1,115 @@
+// -*- C++ -*-
+// Implementation of class FitControl
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+FitControl_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include "FitControl.h"
+#include "MathTools.h"
+#include "WallClock.h"
+
+
+using namespace jpw_nld::fortlib;
+using jpw_nld::index_t;
+
+
+//
+// Static variables
+//
+
+
+//
+// Typedefs
+//
+
+
+/////////////////////////
+
+//
+// FitControl Member Functions
+//
+
+
+FitControl::FitControl()
+    : m__timeBudget(0.0)
+    , m__startTime(0.0)
+    , m__extCancelFlag(0)
+    , m__cancelled(false)
+    , m__monitor(0)
+    , m__iterations(0)
+{}
+
+
+FitControl::FitControl(double timeBudget)
+    : m__timeBudget(timeBudget)
+    , m__startTime(0.0)
+    , m__extCancelFlag(0)
+    , m__cancelled(false)
+    , m__monitor(0)
+    , m__iterations(0)
+{}
+
+
+void FitControl::start()
+{
+    m__cancelled.store(false, boost::memory_order_relaxed);
+    m__iterations = 0;
+    m__startTime = jpw_nld::wallClock();
+}
+
+
+double FitControl::elapsed() const
+{
+    return (jpw_nld::wallClock() - m__startTime);
+}
+
+
+int FitControl::abortCode() const
+{
+    // The flags don't guard any data, so relaxed loads are enough.
+    if( m__cancelled.load(boost::memory_order_relaxed) ||
+        ( m__extCancelFlag &&
+          m__extCancelFlag->load(boost::memory_order_relaxed) ) )
+    {
+        return FitLM::Cancelled;
+    }
+    if( (m__timeBudget > 0.0) && (elapsed() > m__timeBudget) ) {
+        return FitLM::DeadlineExceeded;
+    }
+    return 0;
+}
+
+
+bool FitControl::reportProgress(const double* params, index_t nParams,
+                                const double* deltas, index_t nData)
+{
+    if(!m__monitor) {
+        return true;
+    }
+
+    double chiSq(0.0);
+    for(index_t i=0; i<nData; ++i) {
+        chiSq += jpw_math::SQR(deltas[i]);
+    }
+    return (*m__monitor)(m__iterations, chiSq, params, nParams);
+}
+
+
+/////////////////////////
+//
+// End
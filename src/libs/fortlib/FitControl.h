@@ -0,0 +1,212 @@
+// -*- C++ -*-
+// Header file for class FitControl
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _FitControl_H_
+#define _FitControl_H_
+
+// Includes
+//
+#include <boost/atomic.hpp>
+#include "jpw_nld.h"
+#include "FitLM.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace fortlib {
+
+
+  // Class FitControl
+  /**
+   * Per-fit time budget, cancellation and progress reporting for \c
+   * FitLM_Adapter (and its subclasses).
+   *
+   * The only way to stop \c lmder_() early is through the fit function:  it
+   * must set its \a actionCode argument to a negative number.  A \c
+   * FitControl passed to \c FitLM_Adapter::operator()() is checked by the
+   * adapter every time \c lmder_() calls the fit function.  When the time
+   * budget has run out or the fit has been cancelled, the adapter aborts
+   * the fit, and the fitter returns \c FitLM::DeadlineExceeded or \c
+   * FitLM::Cancelled, respectively.
+   *
+   * Aborting never loses the fit's progress.  \c lmder_() only moves its
+   * parameter vector once a trial step has reduced \f$\chi^2\f$, so the
+   * parameters returned after an abort are the best that the fit accepted.
+   * The fitter's \c deltas() correspond to those parameters.
+   *
+   * A \c FitControl may be reused for any number of fits.  The time budget
+   * is measured from the start of each fit.
+   *
+   * Apart from \c cancel(), none of the member functions are thread-safe.
+   * The flags are \c boost::atomic, so that a fit running on one thread
+   * sees a cancellation from another.
+   */
+  class FitControl
+  {
+  public:
+      /// Interface for progress callbacks.
+      /**
+       * Implement \c operator() in a subclass and register an instance with
+       * \c FitControl::setProgressMonitor().
+       */
+      struct ProgressMonitor
+      {
+          virtual ~ProgressMonitor() {}
+
+          /// Called once per iteration of the fit, and once more when it
+          /// terminates.
+          /**
+           * \param iteration
+           * The number of iterations so far, counting the one about to
+           * start.  (Each \c lmder_() iteration begins with a fresh
+           * Jacobian.)  The call made upon termination repeats the last
+           * value.
+           *
+           * \param chiSq
+           * The value of \f$\chi^2\f$ at \a params.
+           *
+           * \param params
+           * The \a nParams current best-fit parameters.  Must not be
+           * modified.
+           *
+           * \param nParams
+           * The number of tunable parameters.
+           *
+           * \returns \c false to cancel the fit.
+           */
+          virtual bool operator()(unsigned iteration, double chiSq,
+                                  const double* params,
+                                  index_t nParams) = 0;
+      };
+
+      /// Default Constructor
+      /**
+       * No time budget, no cancellation flag and no progress monitor.
+       */
+      FitControl();
+
+      /// Constructor setting the time budget.
+      /**
+       * \see setTimeBudget()
+       */
+      explicit FitControl(double timeBudget);
+
+      /// Destructor
+      ~FitControl() {}
+
+      /// Set the wall-clock time allowed for each fit, in seconds.
+      /**
+       * A value \<= 0 removes the time budget.
+       */
+      void setTimeBudget(double seconds)
+      { m__timeBudget = seconds; }
+
+      /// The time budget, in seconds; \c 0 means "none".
+      double timeBudget() const
+      { return (m__timeBudget > 0.0 ? m__timeBudget : 0.0); }
+
+      /// Watch an external cancellation flag.
+      /**
+       * The fit is cancelled as soon as \c *flag becomes \c true.  Use this
+       * to cancel several fits at once, from any thread.  Pass \c 0 to stop
+       * watching.
+       */
+      void setCancelFlag(const boost::atomic<bool>* flag)
+      { m__extCancelFlag = flag; }
+
+      /// Cancel the current (or next) fit.
+      /**
+       * Safe to call from another thread.  The request remains in effect
+       * until the next call to \c start().
+       */
+      void cancel()
+      { m__cancelled.store(true, boost::memory_order_relaxed); }
+
+      /// Register the progress callback.  Pass \c 0 to remove it.
+      /**
+       * The \c ProgressMonitor is not owned by this object.
+       */
+      void setProgressMonitor(ProgressMonitor* monitor)
+      { m__monitor = monitor; }
+
+      /// Starts the clock and resets the counters.
+      /**
+       * Called by the fitter at the start of each fit.
+       */
+      void start();
+
+      /// Checks for cancellation or an expired time budget.
+      /**
+       * Called by the fitter before each evaluation of the fit function.
+       *
+       * \returns \c 0 if the fit may continue, otherwise either \c
+       * FitLM::Cancelled or \c FitLM::DeadlineExceeded.
+       */
+      int abortCode() const;
+
+      /// Counts the start of a new iteration.
+      /**
+       * Called by the fitter every time the Jacobian is computed.
+       */
+      void countIteration()
+      { ++m__iterations; }
+
+      /// Notifies the progress monitor, if any.
+      /**
+       * \param params
+       * The current best-fit parameters.
+       *
+       * \param nParams
+       * The number of elements in \a params.
+       *
+       * \param deltas
+       * The \a nData residuals at \a params.
+       *
+       * \param nData
+       * The number of elements in \a deltas.
+       *
+       * \returns \c false if the monitor asked to cancel the fit.
+       */
+      bool reportProgress(const double* params, index_t nParams,
+                          const double* deltas, index_t nData);
+
+      /// The number of iterations since \c start().
+      unsigned iterations() const
+      { return m__iterations; }
+
+      /// Seconds of wall-clock time since \c start().
+      double elapsed() const;
+
+  private:
+      double m__timeBudget;
+      double m__startTime;
+      const boost::atomic<bool>* m__extCancelFlag;
+      boost::atomic<bool> m__cancelled;
+      ProgressMonitor* m__monitor;
+      unsigned m__iterations;
+  };
+
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_FitControl_H_
+/////////////////////////
+//
+// End
@@ -19,8 +19,15 @@ FitLM_cc__="RCS $Id: FitLM.cc 1864 2009-08-18 02:50:20Z candide $";
 
 // Includes
 //
+#include <cmath>
+#include <limits>
+#include <algorithm>
 #include "FitLM.h"
+#include "FitLM_WorkspacePool.h"
+#include "ProjectedLM.h"
+#include "FORTLib.h"
 #include "jpw_nld.h"
+#include "nld_exceptions.h"
 #include "MathTools.h"
 #include "Matrix.h"
 
@@ -30,6 +37,8 @@ FitLM_cc__="RCS $Id: FitLM.cc 1864 2009-08-18 02:50:20Z candide $";
 
 using namespace jpw_nld::fortlib;
 using jpw_nld::index_t;
+using jpw_nld::fortlib::square_matrix_inversion::sqmInvert_GJE;
+using jpw_nld::fortlib::square_matrix_inversion::sqmInvert_SVD;
 
 
 //
@@ -37,11 +46,39 @@ using jpw_nld::index_t;
 //
 
 
+// Diagonal elements of R smaller than this, relative to the largest one,
+// mark a parameter that the fit couldn't determine.
+static const double COVAR_TOL = std::numeric_limits<double>::epsilon();
+
+
 //
 // Typedefs
 //
 
 
+//
+// Local Functions
+//
+
+
+namespace {
+
+  ProjectedLM::StepRule_t stepRuleFor(FitLM::Backend_t backend)
+  {
+      switch(backend) {
+      case FitLM::Dogleg:
+          return ProjectedLM::Dogleg;
+      case FitLM::GaussNewton:
+          return ProjectedLM::GaussNewton;
+      default:
+          break;
+      }
+      return ProjectedLM::LevenbergMarquardt;
+  }
+
+} // end anon. namespace
+
+
 /////////////////////////
 
 
@@ -78,54 +115,57 @@ extern "C" {
 //
 
 
-FitLM::FitLM(fit_function_ptr_t ffp, index_t ndata_max, index_t nparm)
+FitLM::FitLM(fit_function_ptr_t ffp, index_t ndata_max, index_t nparm,
+             FitLM_WorkspacePool* pool)
     : m__ffp(ffp)
     , m__ndataMax(ndata_max)
     , m__nparams(nparm)
-    , m__jacobOut_requiresUpdate(false)
-    , m__wrksz(m__ndataMax + 5*m__nparams)
-    , m__ipvt(new int[m__nparams])
-    , m__workbuf(new double[m__wrksz])
-    , m__diag(new double[m__nparams])
-    , m__qtf(new double[m__nparams])
-    , m__wa1(new double[m__nparams])
-    , m__wa2(new double[m__nparams])
-    , m__wa3(new double[m__nparams])
-    , m__wa4(new double[m__ndataMax])
-    , m__jacobFlat(m__nparams*m__ndataMax)
-    , m__deltas(m__ndataMax)
-    , m__jacobOut(m__nparams, m__ndataMax)
+    , m__backend(MinpackLM)
+    , m__retainJacobian(false)
+    , m__haveJacobian(false)
+    , m__exportingJacobian(false)
+    , m__jacobOutStale(false)
+    , m__ndataLast(ndata_max)
+    , m__pool(pool)
+    , m__ws(pool ? pool->acquire(ndata_max, nparm)
+            : new FitLM_Workspace(ndata_max, nparm))
+    , m__projLM()
+    , m__nfev(0)
+    , m__njev(0)
+    , m__covar(m__nparams, m__nparams, 0.0)
+    , m__covarWork(m__nparams, m__nparams)
+    , m__jacobOut()
 { }
 
 
 FitLM::~FitLM()
 {
-    delete[] m__ipvt;
-    delete[] m__workbuf;
-    delete[] m__diag;
-    delete[] m__qtf;
-    delete[] m__wa1;
-    delete[] m__wa2;
-    delete[] m__wa3;
-    delete[] m__wa4;
+    if(m__pool) {
+        m__pool->release(m__ws);
+    } else {
+        delete m__ws;
+    }
 }
 
 
 FitLMStatus_t
 FitLM::operator()(int mm, dvector_t& xv, double errtol, double ptol,
-                  int maxiter, double factor)
+                  int maxiter, double factor, int nprint)
 {
     double gtol=0.0;
-    int mode=1, nprint=0;
-    int nfev, njev;
+    int mode=1;
     int inf=0;
+    m__nfev = 0;
+    m__njev = 0;
+    m__haveJacobian = false;
+    m__jacobOutStale = true;
 
     // Check to see if the parameters are correct.
     if( xv.empty() ||
         (xv.size() < static_cast<unsigned>(m__nparams)) ||
         (mm < m__nparams) || (m__ndataMax < mm) ||
         (errtol < 0.0) || (ptol < 0.0) || (maxiter < 0) ||
-        (m__wrksz < (mm+5*m__nparams)) || (factor < 0.0) )
+        (factor < 0.0) || (nprint < 0) )
     {
         return(InputError);
     }
@@ -138,12 +178,27 @@ FitLM::operator()(int mm, dvector_t& xv, double errtol, double ptol,
         factor=100.0;
     }
 
-    lmder_(m__ffp, &mm, &m__nparams, &xv[0], &m__deltas[0], &m__jacobFlat[0],
-           &m__ndataMax, &errtol, &ptol, &gtol, &maxiter, m__diag,
-           &mode, &factor, &nprint, &inf, &nfev, &njev, m__ipvt, m__qtf,
-           m__wa1, m__wa2, m__wa3, m__wa4);
+    FitLM_Workspace& ws(*m__ws);
+    if(m__projLM) {
+        inf = (*m__projLM)(m__ffp, mm, m__nparams, &xv[0], &ws.deltas()[0],
+                           &ws.jacobFlat()[0], m__ndataMax, errtol, ptol,
+                           maxiter, factor, nprint, m__nfev, m__njev,
+                           ws.wa4());
+    } else {
+        lmder_(m__ffp, &mm, &m__nparams, &xv[0], &ws.deltas()[0],
+               &ws.jacobFlat()[0], &m__ndataMax, &errtol, &ptol, &gtol,
+               &maxiter, ws.diag(), &mode, &factor, &nprint, &inf,
+               &m__nfev, &m__njev, ws.ipvt(), ws.qtf(),
+               ws.wa1(), ws.wa2(), ws.wa3(), ws.wa4());
+    }
 
-    m__jacobOut_requiresUpdate = true;
+    // The residuals past mm are left over from some earlier, larger fit.
+    std::fill(ws.deltas().begin() + mm, ws.deltas().end(), 0.0);
+    m__ndataLast = mm;
+    computeCovariance(inf);
+    if(m__retainJacobian && (inf > InputError)) {
+        retainFinalJacobian(mm, xv);
+    }
 
     if(inf == MachinePrec_LMAlg) {
         return MachinePrec;
@@ -152,6 +207,202 @@ FitLM::operator()(int mm, dvector_t& xv, double errtol, double ptol,
 }
 
 
+void FitLM::resize(index_t ndata_max)
+{
+    if(m__pool) {
+        // Lets the pool hand us a workspace that's already big enough.
+        m__pool->release(m__ws);
+        m__ws = 0;
+        m__ws = m__pool->acquire(ndata_max, m__nparams);
+    } else {
+        m__ws->resize(ndata_max, m__nparams);
+    }
+    m__ndataMax = ndata_max;
+    m__ndataLast = ndata_max;
+    m__haveJacobian = false;
+    m__jacobOutStale = true;
+    m__covar.wipe();
+}
+
+
+void FitLM::setBounds(const ParamBounds& bounds)
+{
+    if(bounds.size() != static_cast<index_t>(m__nparams)) {
+        throw SizeMismatchError("FitLM::setBounds():  "
+                                "Wrong number of parameters.");
+    }
+
+    if(bounds.unbounded()) {
+        clearBounds();
+    } else {
+        m__projLM.reset(new ProjectedLM(bounds, stepRuleFor(m__backend)));
+    }
+}
+
+
+void FitLM::clearBounds()
+{
+    if(m__backend == MinpackLM) {
+        m__projLM.reset();
+    } else {
+        m__projLM.reset(new ProjectedLM(ParamBounds(m__nparams),
+                                        stepRuleFor(m__backend)));
+    }
+}
+
+
+const ParamBounds* FitLM::bounds() const
+{
+    if( !m__projLM || m__projLM->bounds().unbounded() ) {
+        return 0;
+    }
+    return &(m__projLM->bounds());
+}
+
+
+void FitLM::setBackend(Backend_t backend)
+{
+    m__backend = backend;
+    if(m__projLM) {
+        if( (backend == MinpackLM) && !bounds() ) {
+            m__projLM.reset();
+        } else {
+            m__projLM->setStepRule(stepRuleFor(backend));
+        }
+    } else if(backend != MinpackLM) {
+        m__projLM.reset(new ProjectedLM(ParamBounds(m__nparams),
+                                        stepRuleFor(backend)));
+    }
+}
+
+
+const dmatrix_t& FitLM::jacobian()
+{
+    if(!m__jacobOut) {
+        m__jacobOut.reset(new dmatrix_t(m__nparams, m__ndataLast, 0.0));
+        m__jacobOutStale = true;
+    }
+    if(!m__jacobOutStale) {
+        return *m__jacobOut;
+    }
+
+    dmatrix_t& jOut(*m__jacobOut);
+    jOut.wipe(m__nparams, m__ndataLast);
+    if(m__haveJacobian) {
+        const dvector_t& jFlat(m__ws->jacobFlat());
+        for(int j=0; j<m__nparams; ++j) {
+            for(int i=0; i<m__ndataLast; ++i) {
+                jOut[j][i] = jFlat[i + m__ndataMax*j];
+            }
+        }
+    }
+    m__jacobOutStale = false;
+    return jOut;
+}
+
+
+void FitLM::retainFinalJacobian(int mm, dvector_t& xv)
+{
+    FitLM_Workspace& ws(*m__ws);
+    int iflag(ComputeJacobian);
+    m__exportingJacobian = true;
+    m__ffp(&mm, &m__nparams, &xv[0], &ws.deltas()[0], &ws.jacobFlat()[0],
+           &m__ndataMax, &iflag);
+    m__exportingJacobian = false;
+    m__haveJacobian = (iflag >= 0);
+}
+
+
+void FitLM::computeCovariance(int status)
+{
+    if(status <= InputError) {
+        m__covar.wipe(m__nparams, m__nparams);
+        return;
+    }
+
+    if(!m__projLM) {
+        covarFromR();
+        return;
+    }
+
+    const dvector_t& jtj(m__projLM->normalMatrix());
+    for(int i=0; i<m__nparams; ++i) {
+        for(int j=0; j<m__nparams; ++j) {
+            m__covarWork[i][j] = jtj[i*m__nparams + j];
+        }
+    }
+    if(sqmInvert_GJE(m__covarWork, m__covar)) {
+        sqmInvert_SVD(m__covarWork, m__covar);
+    }
+}
+
+
+// On return from lmder_(), the upper triangle of the first nparm rows of
+// the Jacobian holds R, where J*P = Q*R for the permutation P recorded in
+// ipvt.  So inverse(J^T*J) = P*inverse(R^T*R)*P^T.  This follows
+// MINPACK's covar().
+void FitLM::covarFromR()
+{
+    const int n(m__nparams);
+    const dvector_t& R(m__ws->jacobFlat());
+    const std::vector<int>& ipvt(m__ws->permutation());
+    // The working copy of R, stored column-major like the original.
+    m__covarWork.wipe();
+    double* r = &m__covarWork[0][0];
+    for(int j=0; j<n; ++j) {
+        for(int i=0; i<=j; ++i) {
+            r[i + n*j] = R[i + m__ndataMax*j];
+        }
+    }
+
+    // Invert R in place, stopping at the first negligible diagonal.
+    double tolr = COVAR_TOL*std::fabs(r[0]);
+    int rank(0);
+    for(int k=0; k<n; ++k)
+    {
+        if(std::fabs(r[k + n*k]) <= tolr) {
+            break;
+        }
+        r[k + n*k] = 1.0/r[k + n*k];
+        for(int j=0; j<k; ++j) {
+            double temp = r[k + n*k]*r[j + n*k];
+            r[j + n*k] = 0.0;
+            for(int i=0; i<=j; ++i) {
+                r[i + n*k] -= temp*r[i + n*j];
+            }
+        }
+        rank = k + 1;
+    }
+
+    // The upper triangle of inverse(R)*inverse(R)^T.
+    for(int k=0; k<rank; ++k)
+    {
+        for(int j=0; j<k; ++j) {
+            double temp = r[j + n*k];
+            for(int i=0; i<=j; ++i) {
+                r[i + n*j] += temp*r[i + n*k];
+            }
+        }
+        double temp = r[k + n*k];
+        for(int i=0; i<=k; ++i) {
+            r[i + n*k] *= temp;
+        }
+    }
+
+    // Undo the permutation (ipvt is 1-based).
+    for(int j=0; j<n; ++j)
+    {
+        int jj = ipvt[j] - 1;
+        for(int i=0; i<=j; ++i) {
+            int ii = ipvt[i] - 1;
+            double cij = ( (j < rank) ? r[i + n*j] : 0.0 );
+            m__covar[ii][jj] = cij;
+            m__covar[jj][ii] = cij;
+        }
+    }
+}
+
+
 /////////////////////////
 //
 // End
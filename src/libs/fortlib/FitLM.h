@@ -21,18 +21,26 @@
 // Includes
 //
 #include <boost/utility.hpp>
+#include <boost/scoped_ptr.hpp>
 #include "jpw_nld.h"
 #include "FORTTypes.h"
 #include "MathTools.h"
-// Alas, we need to include this directly.  The members "m__deltas" and
-// "m__f_jac" require a complete type.
+// Alas, we need to include this directly.  The members "m__covar" and
+// "m__covarWork" require a complete type.
 #include "Matrix.h"
+#include "FitLM_Workspace.h"
 
 
 // Enclosing namespace
 //
 namespace jpw_nld {
  namespace fortlib {
+
+  // Forward Declarations
+  class ParamBounds;
+  class ProjectedLM;
+  class FitLM_WorkspacePool;
+
   // Class FitLM
   /**
    * Wrapper around the FORTRAN function, \c lmder_().  Performs a nonlinear
@@ -143,6 +151,21 @@ namespace jpw_nld {
   public:
       /// The return status of the Levenberg-Marquardt algorithm.
       enum FitStatus_t {
+          /// The fit was stopped because it ran past its time budget.
+          /**
+           * Only returned by fits run with a \c FitControl.  The parameter
+           * vector holds the best parameters found before the deadline
+           * passed.
+           */
+          DeadlineExceeded=-4,
+          /// The fit was cancelled by the caller.
+          /**
+           * Only returned by fits run with a \c FitControl, either because
+           * its cancellation flag was raised or because its progress monitor
+           * asked to stop.  The parameter vector holds the best parameters
+           * found before cancellation.
+           */
+          Cancelled=-3,
           /// The fit function aborted while computing the Jacobians.
           ModelAbortedIn_fjac=-2,
           /// The fit function aborted while computing itself.
@@ -233,6 +256,14 @@ namespace jpw_nld {
        * is provided for use by fit-functions to make them more readable.
        */
       enum FitFnAction_t {
+          /// Tells the fit-function that an iteration has completed.
+          /**
+           * Only sent when the \a nprint argument of \c operator()() is
+           * positive.  Both the \a deltas and \a fnJacob arguments contain
+           * the values for the current (best) parameters, and must be left
+           * unaltered.
+           */
+          ReportProgress=0,
           /**
            * Tells the fit-function to compute the model being fit (or
            * function being solved).
@@ -249,6 +280,58 @@ namespace jpw_nld {
           ComputeJacobian=2,
       };
 
+      /// How \c FitLM_Adapter (and its subclasses) obtain the Jacobian.
+      enum JacobianMode_t {
+          /// Call the fit-function with \c ComputeJacobian every time.
+          AnalyticJacobian,
+          /// Use Broyden rank-1 updates between full evaluations.
+          /**
+           * The fit-function is only called with \c ComputeJacobian on the
+           * first iteration, and whenever the updated Jacobian stops
+           * predicting the fit's progress well.  The latter restarts the
+           * fit, within the same \a maxiter; \c iterations() and \c
+           * functionEvals() count every restart.
+           *
+           * \see BroydenJacobian
+           */
+          BroydenUpdate,
+          /// Approximate the Jacobian by forward differences.
+          /**
+           * The fit-function is never called with \c ComputeJacobian.
+           *
+           * \see FDJacobian
+           */
+          ForwardDifference,
+          /// Approximate the Jacobian by central differences.
+          /**
+           * Twice as many function evaluations as \c ForwardDifference,
+           * but more accurate.
+           *
+           * \see FDJacobian
+           */
+          CentralDifference,
+      };
+
+      /// The minimizer that \c operator()() runs.
+      /**
+       * Every back-end calls the fit-function the same way, and returns the
+       * same \c FitStatus_t codes.
+       */
+      enum Backend_t {
+          /// MINPACK's \c lmder_().  The default.
+          /**
+           * While there are bounds (see \c setBounds()), \c NativeLM is
+           * used instead.
+           */
+          MinpackLM,
+          /// \c ProjectedLM's Levenberg-Marquardt steps.
+          NativeLM,
+          /// \c ProjectedLM's Powell dogleg steps.
+          Dogleg,
+          /// \c ProjectedLM's Gauss-Newton steps, with a line search.
+          GaussNewton,
+      };
+
       /// Function pointer type for the fit function.
       /**
        * This is the function to minimize.  It should produce a vector of
@@ -350,8 +433,13 @@ namespace jpw_nld {
        * The number of parameters in \a ffp that you're fitting to.  This
        * number also defines the minimum number of data points you intend to
        * fit to.
+       *
+       * \param pool
+       * If not \c 0, the buffers used by the fit are borrowed from \a pool
+       * for the lifetime of this object, instead of being allocated.
        */
-      FitLM(fit_function_ptr_t ffp, index_t ndata_max, index_t nparm);
+      FitLM(fit_function_ptr_t ffp, index_t ndata_max, index_t nparm,
+            FitLM_WorkspacePool* pool=0);
       // FIXME:
       // Determine what happens if 'ndata_max' is larger than the size of your
       // dataset (the value of the 'mm' parameter to the "op()").
@@ -401,44 +489,172 @@ namespace jpw_nld {
        * maxiter==0, a value of <tt>maxiter=100*(<em>ndata_max</em>+1)</tt> is
        * used.
        *
+       * \param nprint
+       * If positive, the fit function is called with <tt>actionCode ==
+       * ReportProgress</tt> at the start of every \a nprint<sup>th</sup>
+       * iteration, and once more upon termination.  The default, \c 0,
+       * disables these calls.
+       *
        * \returns The error codes, which are the same that the FORTRAN
-       * routine, \c lmder_(), returns in its \c info parameter.
+       * routine, \c lmder_(), returns in its \c info parameter.  If the fit
+       * function aborted by setting its \a actionCode argument to a negative
+       * value, that value is returned instead.
        */
       FitStatus_t operator()(int mm, dvector_t& xv,
                              double errtol, double ptol,
-                             int maxiter, double factor);
+                             int maxiter, double factor, int nprint=0);
+
+      /// Change the maximum number of data points.
+      /**
+       * Equivalent to constructing a new object with \a ndata_max, but
+       * only allocates memory if \a ndata_max is larger than any size this
+       * object (or its \c FitLM_WorkspacePool) has used before.
+       *
+       * The results of the last fit are discarded.
+       */
+      void resize(index_t ndata_max);
+
+      /// The current maximum number of data points.
+      index_t ndataMax() const
+      { return m__ndataMax; }
+
+      /// Select the minimizer that \c operator()() runs.
+      void setBackend(Backend_t backend);
+
+      /// The current \c Backend_t.
+      Backend_t backend() const
+      { return m__backend; }
+
+      /// Restrict the parameters to the domain described by \a bounds.
+      /**
+       * Once set, \c operator()() runs a projected minimization (\c
+       * ProjectedLM) in place of \c lmder_(), using the steps of the
+       * current \c Backend_t.  The
+       * fit-function is never evaluated outside of the domain, and the
+       * initial parameters are moved into it before the fit starts.
+       *
+       * Passing a \c ParamBounds with every parameter unbounded is
+       * equivalent to calling \c clearBounds().
+       *
+       * \throws SizeMismatchError if \c bounds.size() isn't the number of
+       * tunable parameters.
+       */
+      void setBounds(const ParamBounds& bounds);
+
+      /// Remove the bounds.  \c operator()() goes back to using \c
+      /// lmder_(), unless another \c Backend_t has been selected.
+      void clearBounds();
+
+      /// The current bounds, or \c 0 if there are none.
+      const ParamBounds* bounds() const;
+
+      /// The number of iterations taken by the last run of \c operator().
+      /**
+       * Each iteration begins with a new Jacobian.
+       */
+      int iterations() const
+      { return m__njev; }
+
+      /// The number of function evaluations made by the last run of \c
+      /// operator().
+      int functionEvals() const
+      { return m__nfev; }
 
       /// Compute \f$\chi^2\f$ for the last run of \c operator().
       /**
        * Equivalent to running \c jpw_math::chiSquared() on \c deltas().
        */
       double chiSquared() const {
-          return jpw_math::chiSquared<dvector_t>(m__deltas);
+          return jpw_math::chiSquared<dvector_t>(m__ws->deltas());
       }
 
       /// Accessor function for the final value of \c deltas.
       /**
+       * Holds \c ndataMax() elements.  Those past the \a mm data points
+       * of the last run of \c operator()() are zero.
+       *
        * \see fit_function_ptr_t
        */
       const dvector_t& deltas() const
-      { return m__deltas; }
+      { return m__ws->deltas(); }
 
-      /// Accessor function for the Jacobian.
+      /// The covariance matrix of the parameters, from the last run of \c
+      /// operator().
       /**
-       * Note that it doesn't return the actual Jacobian (which is fed to the
-       * FORTRAN routine as a flat vector), but calls \c Matrix::swap() on an
-       * internal member.  So, it's a tad slower than a simple "return a
-       * member" accessor.
+       * This is \f$ \left(J^{T}J\right)^{-1} \f$, where \f$ J \f$ is the
+       * last Jacobian computed during the fit; i.e. the inverse of the
+       * curvature matrix that \c jpw_math::statistics::confidence_tg()
+       * expects.  Multiply it by <tt>chiSquared()/(mm - nparm)</tt> to
+       * estimate the covariance of the fitted parameters from the scatter
+       * of the data.
        *
-       * \see fit_function_ptr_t
+       * After a run of \c lmder_(), it's computed from the triangular
+       * factor of \f$ J \f$ that \c lmder_() leaves behind, the same way
+       * as MINPACK's \c covar, rather than by inverting \f$ J^{T}J \f$.
+       * Rows and columns of parameters that the fit couldn't determine
+       * (because \f$ J \f$ is rank-deficient) are zero.
+       *
+       * All zeros if the last fit returned an error status.
+       */
+      const dmatrix_t& covariance() const
+      { return m__covar; }
+
+      /// Keep the Jacobian at the fitted parameters, for \c jacobian().
+      /**
+       * Off by default.  When on, every successful run of \c operator()()
+       * ends with one extra evaluation of the Jacobian, at the best-fit
+       * parameters.  (The buffer the fit itself uses holds \c lmder_()'s
+       * triangular factor on return, not the Jacobian.)
+       *
+       * When off, the fit uses no memory for the Jacobian beyond its own
+       * work buffer.
        */
-      const dmatrix_t& jacobian() {
-          // Only call 'swap()' if we've run the LM-algorithm since the last
-          // call to this fn.
-          if(m__jacobOut_requiresUpdate) {
-              m__jacobOut.swap(m__jacobFlat);
-          }
-          return m__jacobOut;
+      void retainJacobian(bool retain)
+      { m__retainJacobian = retain; }
+
+      /// \c true if \c retainJacobian() is on.
+      bool retainsJacobian() const
+      { return m__retainJacobian; }
+
+      /// \c true if the last run of \c operator()() retained its Jacobian.
+      bool hasJacobian() const
+      { return m__haveJacobian; }
+
+      /// The Jacobian at the parameters returned by the last run of \c
+      /// operator()().
+      /**
+       * Row \c j holds the derivatives with respect to parameter \c j, one
+       * column per data point used in that fit.  (This is the transpose of
+       * the \a fnJacob layout in \c fit_function_ptr_t.)
+       *
+       * The matrix is only allocated and filled in on the first call after
+       * a fit; later calls return the same object unchanged.  All zeros
+       * unless \c hasJacobian() is \c true.
+       *
+       * \see retainJacobian()
+       */
+      const dmatrix_t& jacobian();
+
+  protected:
+      /// \c true while \c operator()() is evaluating the Jacobian at the
+      /// best-fit parameters for \c retainJacobian().
+      /**
+       * The fit is over by then, so the fit-function should compute the
+       * Jacobian directly, without any step-control bookkeeping.
+       */
+      bool exportingJacobian() const
+      { return m__exportingJacobian; }
+
+      /// Adds \a nfev and \a njev to \c functionEvals() and \c
+      /// iterations().
+      /**
+       * For a subclass whose fit takes several runs of \c operator()(),
+       * to report the whole fit.  Call it after the last run.
+       */
+      void addRunCounts(int nfev, int njev)
+      {
+          m__nfev += nfev;
+          m__njev += njev;
       }
 
   private:
@@ -447,20 +663,24 @@ namespace jpw_nld {
       int m__ndataMax;
       int m__nparams;
   private:
-      bool m__jacobOut_requiresUpdate;
-      int m__wrksz;
-      fort_ivec_t m__ipvt;
-      fort_dvec_t m__workbuf;
-      fort_dvec_t m__diag;
-      fort_dvec_t m__qtf;
-      fort_dvec_t m__wa1;
-      fort_dvec_t m__wa2;
-      fort_dvec_t m__wa3;
-      fort_dvec_t m__wa4;
-  protected:
-      dvector_t m__jacobFlat;
-      dvector_t m__deltas;
-      dmatrix_t m__jacobOut;
+      Backend_t m__backend;
+      bool m__retainJacobian;
+      bool m__haveJacobian;
+      bool m__exportingJacobian;
+      bool m__jacobOutStale;
+      int m__ndataLast;
+      FitLM_WorkspacePool* m__pool;
+      FitLM_Workspace* m__ws;
+      boost::scoped_ptr<ProjectedLM> m__projLM;
+      int m__nfev;
+      int m__njev;
+      dmatrix_t m__covar;
+      dmatrix_t m__covarWork;
+      boost::scoped_ptr<dmatrix_t> m__jacobOut;
+
+      void computeCovariance(int status);
+      void covarFromR();
+      void retainFinalJacobian(int mm, dvector_t& xv);
   };
 
 
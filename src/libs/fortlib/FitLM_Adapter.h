@@ -20,7 +20,13 @@
 
 // Includes
 //
+#include <boost/scoped_ptr.hpp>
 #include "FitLM.h"
+#include "FitLM_WorkspacePool.h"
+#include "FitControl.h"
+#include "BroydenJacobian.h"
+#include "FDJacobian.h"
+#include "ThreadTeam.h"
 
 
 // Enclosing namespace
@@ -74,7 +80,9 @@ namespace jpw_nld {
   *     - \a <tt>nData</tt>
   *       \n
   *       The number of data points to fit to.  Will always be identical to \c
-  *       fitData.size().
+  *       fitData.size().  For a \c PersistenceMap, that's the number of
+  *       valid elements:  the fit sees only its compacted fit domain, not
+  *       the full grid.
   *     - \a <tt>fitData</tt>
   *       \n
   *       This is the instance of \c D that was passed to
@@ -104,7 +112,8 @@ namespace jpw_nld {
   *     \n
   *     - \a <tt>fnJacob</tt>
   *       \n
-  *       An \a nParams by \a ldfjac matrix, flattened into a \c fort_dmat_t.
+  *       An \a nParams by \a ld_fnJac matrix, flattened into a \c
+  *       fort_dmat_t.
   *       You do not need to perform any memory-management on it, as it has
   *       been pre-allocated externally for
   *       \n
@@ -113,8 +122,12 @@ namespace jpw_nld {
   *       this.
   *     - \a <tt>ld_fnJac</tt>
   *       \n
-  *       The "long-dimension" of \a fnJacob.  Should always be identical to
-  *       \a nData.
+  *       The "long-dimension" of \a fnJacob.  It's the \c ndataMax() of
+  *       the fit's workspace, so <tt>ld_fnJac >= nData</tt>.  It's larger
+  *       whenever the workspace was sized for a larger fit (see \c
+  *       FitLM::resize() and \c FitLM_WorkspacePool), or the data has
+  *       invalid elements.  Column \c j of the Jacobian starts at
+  *       <tt>fnJacob + ld_fnJac*j</tt>.
   *     - \a <tt>actionCode</tt>
   *       \n
   *       An integer code for what the functor should compute.
@@ -122,6 +135,14 @@ namespace jpw_nld {
   *         while \a fnJacob will remain unaltered.
   *       - When equal to \c 2, \a deltas must be left alone and \a fnJacob
   *         must be calculated and filled in.
+  *       \n
+  *       The functor is never called with any other value.
+  *       \n
+  *       In the \c FitLM::ForwardDifference and \c
+  *       FitLM::CentralDifference \c JacobianMode_t, it's never called
+  *       with \c 2, and \a fnJacob is \c 0.  If those modes are combined
+  *       with a \c ThreadTeam, the functor is called concurrently, so
+  *       the function path (\a actionCode \c ==1) must be re-entrant.
   *
   * The typedefs \c fort_dvec_t and \c fort_dmat_t are defined in
   * "FORTTypes.h".
@@ -134,7 +155,7 @@ namespace jpw_nld {
   * Levenberg-Marquardt fits the data to the model.  The \ref LMNLLSqF
   * "documentation of FitLM" goes into the full details.
   *
-  * Although they're passed to your fit-functor, 3 of the arguments are
+  * Although they're passed to your fit-functor, 2 of the arguments are
   * redundant:
   * - \a <tt>nParams</tt>
   *   \n
@@ -150,14 +171,10 @@ namespace jpw_nld {
   *   fitData.size(), thereby optimizing away the function call.  Or, if
   *   you prefer, you could safely ignore it and hope that the compiler
   *   optimizes your \c fitData.size() calls.
-  * - \a <tt>ld_fnJac</tt>
-  *   \n
-  *   As stated earlier, the value of this argument will be identical to \a
-  *   nData.  It will also be identical to the inherited member \c
-  *   FitLM::m__ndata.
-  *   \n
-  *   So, if you wish, you could ignore both this and \a nData and just use \c
-  *   FitLM::m__ndata instead.
+  *
+  * \a <tt>ld_fnJac</tt>, however, is not redundant.  It can be larger than
+  * \a nData, so always offset the Jacobian's columns by \a ld_fnJac, and
+  * never by \a nData.
   *
   * <h4>Computing &ldquo;<em><tt>deltas</tt></em>&rdquo;</h4>
   *
@@ -270,7 +287,7 @@ namespace jpw_nld {
   *     \endcode
   *     Note the indexing used.  Remember that \c fnJacob has been \em
   *     flattened from a \a nParams by \a ld_fnJac 2-D matrix into a 1-D
-  *     array.  (While \a ld_fnJac might equal \a nData, you shouldn't count
+  *     array.  (While \a ld_fnJac might equal \a nData, you mustn't count
   *     on that.)
   *     \n
   * - Repeat for all '<tt>j</tt>'.
@@ -300,39 +317,14 @@ namespace jpw_nld {
        * This \c static member function calls the FitFunctor_t and Data_t
        * objects that were passed to the last FitLM_Adapter::operator()()
        * call.  Unfortunately, it works by using a \c static member field,
-       * making FitLM_Adapter and \b all of its subclasses inherently
-       * non-re-entrant.
-       *
-       * The details are a bit more complex, due to the template parameters.
-       * Every instantiated template class has its own copies of the
-       * template's \c static member fields.  They also have their own,
-       * separate implementations of each \c static member function.  So, each
-       * time you template-instantiate FitLM_Adapter with a different functor
-       * type (or data container type), you've created a completely separate
-       * version of the \c fit_function_adapter.  That means you can use
-       * object-instances of these two different template-instantiations
-       * simultaneously.  For example:
-       * \code
-       * class TrigModel;
-       * class LogarithmicModel;
-       *
-       * class FitLM_Adapter<TrigModel, std::vector> SpecialTrigFit
-       * {
-       *     // Declaration/Definition Omitted for Clarity
-       *     // :
-       *     // :
-       * };
+       * since \c lmder_() dictates the call-signature.
        *
-       * FitLM_Adapter<LogarithmicModel, std::vector> logfit;
-       * FitLM_Adapter<TrigModel, std::vector> trigfit;
-       * SpecialTrigFit child_trigfit;
-       * \endcode
-       * You could use \c logfit and \c trigfit at the same time (well, \em if
-       * the FORTRAN function, \c lmder_, is re-entrant).  In contrast, you
-       * \em cannot use \c trigfit and \c child_trigfit simultaneously.
-       *
-       * These are the issues that make \em \b this class potentially
-       * non-re-entrant.
+       * That field is thread-local:  each thread has its own copy.  So
+       * different FitLM_Adapter objects may run fits in different threads
+       * at the same time (\c lmder_() keeps no state between calls).  What
+       * remains non-re-entrant is a single object:  a FitLM_Adapter must
+       * not be used by two threads at once, nor from inside of its own
+       * fit-functor.
        */
       static void fit_function_adapter(fort_ivar_t neq, fort_ivar_t nvar,
                                        fort_dvec_t xvec, fort_dvec_t fvec,
@@ -357,6 +349,50 @@ namespace jpw_nld {
           // jpw_math::Matrix!  Oh Wait:  all we need to do is specialize
           // 'fit_function_adapter' on the 'Data_t' template parameter, and
           // put an assert [or static_assert] in the generic impl.
+
+          // The fit is over; FitLM only wants the Jacobian it retains.
+          if(m__activeThis->exportingJacobian()) {
+              m__activeThis->exportJacobian(*neq, *nvar, xvec, fvec, fjac,
+                                            *ldfjac, *iflag);
+              return;
+          }
+
+          // The FitControl, if any, gets first crack at every call.  The
+          // progress calls are meant for it alone; the functor never sees
+          // them.
+          FitControl* ctl = m__activeThis->m__control;
+          if(ctl) {
+              if(*iflag == ReportProgress) {
+                  if(!ctl->reportProgress(xvec, *nvar, fvec, *neq)) {
+                      *iflag = Cancelled;
+                  }
+                  return;
+              }
+
+              int abortCode = ctl->abortCode();
+              if(abortCode) {
+                  *iflag = abortCode;
+                  return;
+              }
+
+              if(*iflag == ComputeJacobian) {
+                  ctl->countIteration();
+              }
+          }
+
+          if( (*iflag == ComputeFunction) &&
+              m__activeThis->abandonBroydenUpdate() )
+          {
+              *iflag = BROYDEN_RESTART;
+              return;
+          }
+
+          if(*iflag == ComputeJacobian) {
+              m__activeThis->computeJacobian(*neq, *nvar, xvec, fvec, fjac,
+                                             *ldfjac, *iflag);
+              return;
+          }
+
           (*(m__activeThis->m__fitter))(*neq, *(m__activeThis->m__fitData),
                                         *nvar, xvec, fvec, fjac,
                                         *ldfjac, *iflag);
@@ -364,12 +400,25 @@ namespace jpw_nld {
 
   public:
       /// Default Constructor
-      explicit FitLM_Adapter(index_t ndata_max)
+      /**
+       * \a ndata_max and \a pool have the same meanings as in the \c
+       * FitLM c'tor.
+       */
+      explicit FitLM_Adapter(index_t ndata_max,
+                             FitLM_WorkspacePool* pool=0)
           : FitLM(Self_t::fit_function_adapter,
                   ndata_max,
-                  static_cast<index_t>(FitFunctor_t::N_PARAMETERS))
+                  static_cast<index_t>(FitFunctor_t::N_PARAMETERS),
+                  pool)
           , m__fitter(0)
           , m__fitData(0)
+          , m__control(0)
+          , m__jacobMode(AnalyticJacobian)
+          , m__broyden()
+          , m__nJacobEvals(0)
+          , m__nRestarts(0)
+          , m__fdJacobian()
+          , m__team(0)
       {}
 
       /// Destructor
@@ -378,6 +427,101 @@ namespace jpw_nld {
       using FitLM::chiSquared;
       using FitLM::deltas;
       using FitLM::jacobian;
+      using FitLM::covariance;
+      using FitLM::retainJacobian;
+      using FitLM::retainsJacobian;
+      using FitLM::hasJacobian;
+      using FitLM::setBackend;
+      using FitLM::backend;
+      using FitLM::setBounds;
+      using FitLM::clearBounds;
+      using FitLM::bounds;
+      using FitLM::iterations;
+      using FitLM::functionEvals;
+      using FitLM::ndataMax;
+
+      /// Change the maximum number of data points.
+      /**
+       * Resizes the buffers of the Jacobian engines, too.
+       *
+       * \see FitLM::resize()
+       */
+      void resize(index_t ndata_max)
+      {
+          FitLM::resize(ndata_max);
+          if(m__broyden) {
+              m__broyden->resize(ndata_max);
+          }
+          if(m__fdJacobian) {
+              m__fdJacobian->resize(ndata_max);
+          }
+      }
+
+      /// Select how the Jacobian is obtained during a fit.
+      /**
+       * The default is \c FitLM::AnalyticJacobian.
+       */
+      void setJacobianMode(JacobianMode_t mode)
+      {
+          if( (mode == BroydenUpdate) && !m__broyden ) {
+              m__broyden.reset(new BroydenJacobian(m__ndataMax,
+                                                   m__nparams));
+          }
+          if( isFiniteDifference(mode) ) {
+              if(!m__fdJacobian) {
+                  m__fdJacobian.reset(new FDJacobian(m__ndataMax,
+                                                     m__nparams));
+              }
+              m__fdJacobian->setCentral(mode == CentralDifference);
+          }
+          m__jacobMode = mode;
+      }
+
+      /// Run the function evaluations of a finite-difference Jacobian on
+      /// \a team.
+      /**
+       * The \c ThreadTeam is not owned by this object, and may be shared
+       * with other fitters.  Pass \c 0 to evaluate serially (the
+       * default).
+       *
+       * If the fit itself runs as a task of \a team, the Jacobian's
+       * evaluations run serially on that task's thread.
+       */
+      void setThreadTeam(ThreadTeam* team)
+      { m__team = team; }
+
+      /// The current \c JacobianMode_t.
+      JacobianMode_t jacobianMode() const
+      { return m__jacobMode; }
+
+      /// The Broyden-update engine, for tuning its refresh policy.
+      /**
+       * Only valid after calling
+       * <tt>setJacobianMode(FitLM::BroydenUpdate)</tt>.
+       */
+      BroydenJacobian& broydenJacobian()
+      { return *m__broyden; }
+
+      /// The finite-difference engine, for tuning its step sizes.
+      /**
+       * Only valid after selecting one of the finite-difference \c
+       * JacobianMode_t values.
+       */
+      FDJacobian& fdJacobian()
+      { return *m__fdJacobian; }
+
+      /// The number of times the functor computed the Jacobian during the
+      /// last fit.
+      unsigned jacobianEvals() const
+      { return m__nJacobEvals; }
+
+      /// The number of Jacobians produced by a Broyden update during the
+      /// last fit.
+      unsigned jacobianUpdates() const
+      {
+          return ( (m__jacobMode == BroydenUpdate) ?
+                   m__broyden->nUpdates() : 0 );
+      }
 
       /// Perform a nonlinear least-squares fit.
       /**
@@ -425,29 +569,250 @@ namespace jpw_nld {
                              const Data_t& theData, dvector_t& params0,
                              double errtol, double ptol,
                              int maxiter, double factor)
+      {
+          return runFit(theModel, theData, params0, errtol, ptol,
+                        maxiter, factor, 0);
+      }
+
+      /// Perform a nonlinear least-squares fit under the supervision of a
+      /// \c FitControl.
+      /**
+       * Identical to the other overload, but \a control is checked every
+       * time the LM algorithm calls \a theModel, and its progress monitor
+       * (if any) is called once per iteration.  Returns \c Cancelled or \c
+       * DeadlineExceeded if \a control stopped the fit.  Either way, \a
+       * params0 contains the best parameters found.
+       *
+       * A pointer to \a control is held for the duration of this function
+       * call.
+       */
+      FitStatus_t operator()(FitFunctor_t& theModel,
+                             const Data_t& theData, dvector_t& params0,
+                             double errtol, double ptol,
+                             int maxiter, double factor,
+                             FitControl& control)
+      {
+          control.start();
+          return runFit(theModel, theData, params0, errtol, ptol,
+                        maxiter, factor, &control);
+      }
+
+  protected:
+      /// As the \c FitControl overload of \c operator()(), but without
+      /// calling \c control.start().
+      /**
+       * For a subclass whose fit takes several runs:  the time budget,
+       * cancellation and iteration count of \a control then span all of
+       * them.
+       */
+      FitStatus_t resume(FitFunctor_t& theModel,
+                         const Data_t& theData, dvector_t& params0,
+                         double errtol, double ptol,
+                         int maxiter, double factor,
+                         FitControl& control)
+      {
+          return runFit(theModel, theData, params0, errtol, ptol,
+                        maxiter, factor, &control);
+      }
+
+  private:
+      static const unsigned MAX_BROYDEN_RESTARTS=4;
+      // Private abort code; must lie within the range of FitStatus_t.
+      static const int BROYDEN_RESTART=-10;
+      // One per thread; see fit_function_adapter().
+      static __thread Self_t* m__activeThis;
+      FitFunctor_t* m__fitter;
+      const Data_t* m__fitData;
+      FitControl* m__control;
+      JacobianMode_t m__jacobMode;
+      boost::scoped_ptr<BroydenJacobian> m__broyden;
+      unsigned m__nJacobEvals;
+      unsigned m__nRestarts;
+      boost::scoped_ptr<FDJacobian> m__fdJacobian;
+      ThreadTeam* m__team;
+
+      static bool isFiniteDifference(JacobianMode_t mode)
+      {
+          return ( (mode == ForwardDifference) ||
+                   (mode == CentralDifference) );
+      }
+
+      /// One function evaluation of a finite-difference Jacobian.
+      struct FDTask : public ThreadTeam::Task
+      {
+          FDTask(Self_t& adapter, int neq, int nvar)
+              : m__adapter(adapter)
+              , m__neq(neq)
+              , m__nvar(nvar)
+          {}
+
+          void operator()(unsigned k, unsigned)
+          {
+              FDJacobian& fd(*m__adapter.m__fdJacobian);
+              (*m__adapter.m__fitter)(m__neq, *m__adapter.m__fitData,
+                                      m__nvar, fd.point(k),
+                                      fd.residuals(k), 0, m__neq,
+                                      ComputeFunction);
+          }
+
+          Self_t& m__adapter;
+          int m__neq;
+          int m__nvar;
+      };
+
+      /// Fills in \a fjac by finite differences.
+      void finiteDiffJacobian(int neq, int nvar, fort_dvec_t xvec,
+                              fort_dvec_t fvec, fort_dmat_t fjac,
+                              int ldfjac, int& iflag)
+      {
+          m__fdJacobian->prepare(xvec);
+          FDTask task(*this, neq, nvar);
+          unsigned nEvals = m__fdJacobian->nEvaluations();
+          if(m__team) {
+              // Exceptions mustn't propagate through lmder_().
+              try {
+                  m__team->run(task, nEvals);
+              } catch(std::exception&) {
+                  iflag = ModelAbortedIn_fjac;
+                  return;
+              }
+          } else {
+              for(unsigned k=0; k<nEvals; ++k) {
+                  task(k, 0);
+              }
+          }
+          m__fdJacobian->assemble(fvec, fjac, neq, ldfjac);
+      }
+
+      /// \c true if lmder_() should be stopped and restarted, because the
+      /// Broyden-updated Jacobian isn't producing acceptable steps.
+      bool abandonBroydenUpdate()
+      {
+          return ( (m__jacobMode == BroydenUpdate) &&
+                   (m__nRestarts < MAX_BROYDEN_RESTARTS) &&
+                   !m__broyden->countTrialStep() );
+      }
+
+      /// \c true if the fit that returned \a status must be rerun.
+      /**
+       * Either it was stopped by \c abandonBroydenUpdate(), or it claims to
+       * have converged using an updated Jacobian.  A poor update can make
+       * \c lmder_() think so, since it tests convergence using the
+       * reduction in \f$\chi^2\f$ predicted by the Jacobian.
+       */
+      bool needsBroydenRestart(FitStatus_t status) const
+      {
+          if( (m__jacobMode != BroydenUpdate) ||
+              (m__nRestarts >= MAX_BROYDEN_RESTARTS) )
+          {
+              return false;
+          }
+          return ( (status == BROYDEN_RESTART) ||
+                   ( (status > InputError) && (status < MachinePrec) &&
+                     m__broyden->isApproximate() ) );
+      }
+
+      /// Fills in \a fjac at the best-fit parameters, for \c
+      /// FitLM::jacobian().
+      void exportJacobian(int neq, int nvar, fort_dvec_t xvec,
+                          fort_dvec_t fvec, fort_dmat_t fjac,
+                          int ldfjac, int& iflag)
+      {
+          if( isFiniteDifference(m__jacobMode) ) {
+              finiteDiffJacobian(neq, nvar, xvec, fvec, fjac, ldfjac, iflag);
+              return;
+          }
+          // Not a Broyden update, which would only approximate it.
+          (*m__fitter)(neq, *m__fitData, nvar, xvec, fvec, fjac,
+                       ldfjac, iflag);
+      }
+
+      /// Fills in \a fjac according to the current \c JacobianMode_t.
+      void computeJacobian(int neq, int nvar, fort_dvec_t xvec,
+                           fort_dvec_t fvec, fort_dmat_t fjac,
+                           int ldfjac, int& iflag)
+      {
+          if( isFiniteDifference(m__jacobMode) ) {
+              finiteDiffJacobian(neq, nvar, xvec, fvec, fjac, ldfjac, iflag);
+              return;
+          }
+
+          if(m__jacobMode == BroydenUpdate) {
+              if(m__broyden->update(xvec, fvec, fjac, neq, ldfjac)) {
+                  return;
+              }
+          }
+
+          (*m__fitter)(neq, *m__fitData, nvar, xvec, fvec, fjac,
+                       ldfjac, iflag);
+          ++m__nJacobEvals;
+
+          if( (m__jacobMode == BroydenUpdate) && (iflag >= 0) ) {
+              m__broyden->store(xvec, fvec, fjac, neq, ldfjac);
+          }
+      }
+
+      FitStatus_t runFit(FitFunctor_t& theModel,
+                         const Data_t& theData, dvector_t& params0,
+                         double errtol, double ptol,
+                         int maxiter, double factor, FitControl* control)
       {
           m__fitter = &theModel;
           m__fitData = &theData;
+          m__control = control;
+          m__nJacobEvals = 0;
+          m__nRestarts = 0;
+          if(m__broyden) {
+              m__broyden->reset();
+          }
           m__activeThis = this;
+          if(maxiter == 0) {
+              // The default of FitLM::operator()().
+              maxiter = 100*(this->m__nparams + 1);
+          }
           FitStatus_t retval
               = this->FitLM::operator()(theData.size(), params0, errtol,
-                                        ptol, maxiter, factor);
+                                        ptol, maxiter, factor,
+                                        (control ? 1 : 0));
+          int nfev(this->functionEvals());
+          int njev(this->iterations());
+
+          // Restarting the fit always begins with a full evaluation of the
+          // Jacobian.  Each restart gets what's left of maxiter, which must
+          // cover the two evaluations that lmder_() always makes.
+          while( needsBroydenRestart(retval) && (nfev + 2 <= maxiter) )
+          {
+              if(retval == BROYDEN_RESTART) {
+                  // The call that abandoned the update never reached the
+                  // model.
+                  --nfev;
+              }
+              ++m__nRestarts;
+              m__broyden->invalidate();
+              retval = this->FitLM::operator()(theData.size(), params0,
+                                               errtol, ptol, maxiter - nfev,
+                                               factor, (control ? 1 : 0));
+              nfev += this->functionEvals();
+              njev += this->iterations();
+          }
+          if(retval == BROYDEN_RESTART) {
+              // Abandoned, with nothing left of maxiter to restart with.
+              retval = IterationOverflow;
+          }
+          this->addRunCounts(nfev - this->functionEvals(),
+                             njev - this->iterations());
           m__activeThis = 0;
+          m__control = 0;
           m__fitData = 0;
           m__fitter = 0;
           return retval;
       }
 
-  private:
-      static const Self_t* m__activeThis;
-      FitFunctor_t* m__fitter;
-      const Data_t* m__fitData;
-
       // Assignment Operator
       FitLM_Adapter& operator=(const FitLM_Adapter& other);
   };
   template<typename F, typename D>
-  const FitLM_Adapter<F,D>*
+  __thread FitLM_Adapter<F,D>*
   FitLM_Adapter<F,D>::m__activeThis=0;
 
  }; //end namespace
@@ -0,0 +1,88 @@
+// -*- C++ -*-
+// Implementation of class FitLM_Workspace
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+FitLM_Workspace_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include "FitLM_Workspace.h"
+
+
+using namespace jpw_nld::fortlib;
+using jpw_nld::index_t;
+
+
+//
+// Static variables
+//
+
+
+//
+// Typedefs
+//
+
+
+/////////////////////////
+
+//
+// FitLM_Workspace Member Functions
+//
+
+
+FitLM_Workspace::FitLM_Workspace(index_t ndata_max, index_t nparm)
+    : m__ndataMax(0)
+    , m__nparams(0)
+    , m__nAllocations(0)
+    , m__ipvt()
+    , m__nparmBufs()
+    , m__wa4()
+    , m__jacobFlat()
+    , m__deltas()
+{
+    resize(ndata_max, nparm);
+}
+
+
+void FitLM_Workspace::resize(index_t ndata_max, index_t nparm)
+{
+    if(!fits(ndata_max, nparm)) {
+        ++m__nAllocations;
+    }
+
+    m__ndataMax = ndata_max;
+    m__nparams = nparm;
+    m__ipvt.resize(nparm);
+    m__nparmBufs.resize(5*nparm);
+    m__wa4.resize(ndata_max);
+    m__jacobFlat.resize(ndata_max*nparm);
+    m__deltas.resize(ndata_max);
+}
+
+
+bool FitLM_Workspace::fits(index_t ndata_max, index_t nparm) const
+{
+    return ( (m__ipvt.capacity() >= nparm) &&
+             (m__nparmBufs.capacity() >= 5*nparm) &&
+             (m__wa4.capacity() >= ndata_max) &&
+             (m__jacobFlat.capacity() >= ndata_max*nparm) &&
+             (m__deltas.capacity() >= ndata_max) );
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,151 @@
+// -*- C++ -*-
+// Header file for class FitLM_Workspace
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _FitLM_Workspace_H_
+#define _FitLM_Workspace_H_
+
+// Includes
+//
+#include <vector>
+#include <boost/utility.hpp>
+#include "jpw_nld.h"
+#include "FORTTypes.h"
+#include "Matrix.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace fortlib {
+
+
+  // Class FitLM_Workspace
+  /**
+   * The work arrays of \c lmder_(), plus the residual and Jacobian buffers
+   * that \c FitLM passes to it.
+   *
+   * A workspace can be re-targeted to a new problem size with \c resize().
+   * The buffers are only reallocated when the new size exceeds their
+   * capacity, so a workspace sized for the largest map in a run serves
+   * every smaller one without touching the heap.
+   *
+   * Each \c FitLM owns a workspace, or borrows one from a \c
+   * FitLM_WorkspacePool.
+   */
+  class FitLM_Workspace : private boost::noncopyable
+  {
+  public:
+      /// Constructor
+      /**
+       * The arguments have the same meanings as those of the \c FitLM
+       * c'tor.
+       */
+      FitLM_Workspace(index_t ndata_max, index_t nparm);
+
+      /// Destructor
+      ~FitLM_Workspace() {}
+
+      /// Re-target the workspace to a new problem size.
+      /**
+       * The contents of the buffers are undefined afterwards.
+       */
+      void resize(index_t ndata_max, index_t nparm);
+
+      /// \c true if \c resize(ndata_max, nparm) would not allocate.
+      bool fits(index_t ndata_max, index_t nparm) const;
+
+      /// The current maximum number of data points.
+      index_t ndataMax() const
+      { return m__ndataMax; }
+
+      /// The current number of parameters.
+      index_t nParams() const
+      { return m__nparams; }
+
+      /// The number of \c double elements the buffers can hold without
+      /// reallocating.
+      size_t capacity() const
+      {
+          return ( m__jacobFlat.capacity() + m__deltas.capacity()
+                   + m__wa4.capacity() + m__nparmBufs.capacity() );
+      }
+
+      /// The number of times that \c resize() (or the c'tor) had to
+      /// allocate memory.
+      unsigned nAllocations() const
+      { return m__nAllocations; }
+
+      /// \name Buffers passed to \c lmder_()
+      //@{
+      fort_ivec_t ipvt()
+      { return &m__ipvt[0]; }
+      fort_dvec_t diag()
+      { return &m__nparmBufs[0]; }
+      fort_dvec_t qtf()
+      { return &m__nparmBufs[m__nparams]; }
+      fort_dvec_t wa1()
+      { return &m__nparmBufs[2*m__nparams]; }
+      fort_dvec_t wa2()
+      { return &m__nparmBufs[3*m__nparams]; }
+      fort_dvec_t wa3()
+      { return &m__nparmBufs[4*m__nparams]; }
+      fort_dvec_t wa4()
+      { return &m__wa4[0]; }
+      //@}
+
+      /// The \c ndataMax() by \c nParams() Jacobian buffer, in the layout
+      /// required by \c FitLM::fit_function_ptr_t.
+      dvector_t& jacobFlat()
+      { return m__jacobFlat; }
+
+      /// Overloaded version returning a const object.
+      const dvector_t& jacobFlat() const
+      { return m__jacobFlat; }
+
+      /// The \c ndataMax() residuals.
+      dvector_t& deltas()
+      { return m__deltas; }
+
+      /// Overloaded version returning a const object.
+      const dvector_t& deltas() const
+      { return m__deltas; }
+
+      /// \c lmder_()'s column permutation.  (1-based.)
+      const std::vector<int>& permutation() const
+      { return m__ipvt; }
+
+  private:
+      index_t m__ndataMax;
+      index_t m__nparams;
+      unsigned m__nAllocations;
+      std::vector<int> m__ipvt;
+      // diag, qtf, wa1, wa2 and wa3, one after another.
+      dvector_t m__nparmBufs;
+      dvector_t m__wa4;
+      dvector_t m__jacobFlat;
+      dvector_t m__deltas;
+  };
+
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_FitLM_Workspace_H_
+/////////////////////////
+//
+// End
@@ -0,0 +1,154 @@
+// -*- C++ -*-
+// Implementation of class FitLM_WorkspacePool
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+FitLM_WorkspacePool_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <boost/thread/locks.hpp>
+#include "FitLM_WorkspacePool.h"
+#include "FitLM_Workspace.h"
+
+
+using namespace jpw_nld::fortlib;
+using jpw_nld::index_t;
+
+
+//
+// Static variables
+//
+
+
+//
+// Typedefs
+//
+
+
+typedef boost::unique_lock<boost::mutex> lock_t;
+
+
+/////////////////////////
+
+//
+// FitLM_WorkspacePool Member Functions
+//
+
+
+FitLM_WorkspacePool::FitLM_WorkspacePool()
+    : m__mutex()
+    , m__nAllocations(0)
+    , m__all()
+    , m__idle()
+{}
+
+
+FitLM_WorkspacePool::~FitLM_WorkspacePool()
+{
+    for(size_t k=0; k<m__all.size(); ++k) {
+        delete m__all[k];
+    }
+}
+
+
+FitLM_Workspace* FitLM_WorkspacePool::acquire(index_t ndata_max,
+                                              index_t nparm)
+{
+    FitLM_Workspace* ws(0);
+    {
+        lock_t lock(m__mutex);
+
+        // The smallest idle workspace that fits, else the largest one.
+        size_t iBest(m__idle.size());
+        bool bestFits(false);
+        for(size_t k=0; k<m__idle.size(); ++k)
+        {
+            bool kFits = m__idle[k]->fits(ndata_max, nparm);
+            bool better(true);
+            if(iBest < m__idle.size()) {
+                size_t kCapacity = m__idle[k]->capacity();
+                size_t bestCapacity = m__idle[iBest]->capacity();
+                if(kFits != bestFits) {
+                    better = kFits;
+                } else if(kFits) {
+                    better = (kCapacity < bestCapacity);
+                } else {
+                    better = (kCapacity > bestCapacity);
+                }
+            }
+            if(better) {
+                iBest = k;
+                bestFits = kFits;
+            }
+        }
+
+        if(iBest == m__idle.size()) {
+            ws = new FitLM_Workspace(ndata_max, nparm);
+            m__nAllocations += ws->nAllocations();
+            m__all.push_back(ws);
+            // So that release() never allocates.
+            m__idle.reserve(m__all.size());
+            return ws;
+        }
+
+        ws = m__idle[iBest];
+        m__idle[iBest] = m__idle.back();
+        m__idle.pop_back();
+        if(!bestFits) {
+            ++m__nAllocations;
+        }
+    }
+
+    // The workspace is ours alone now, so resize it outside of the lock.
+    ws->resize(ndata_max, nparm);
+    return ws;
+}
+
+
+void FitLM_WorkspacePool::release(FitLM_Workspace* ws)
+{
+    if(!ws) {
+        return;
+    }
+    lock_t lock(m__mutex);
+    m__idle.push_back(ws);
+}
+
+
+size_t FitLM_WorkspacePool::size() const
+{
+    lock_t lock(m__mutex);
+    return m__all.size();
+}
+
+
+size_t FitLM_WorkspacePool::nIdle() const
+{
+    lock_t lock(m__mutex);
+    return m__idle.size();
+}
+
+
+unsigned FitLM_WorkspacePool::nAllocations() const
+{
+    lock_t lock(m__mutex);
+    return m__nAllocations;
+}
+
+
+/////////////////////////
+//
+// End
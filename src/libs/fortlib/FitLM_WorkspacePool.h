@@ -0,0 +1,109 @@
+// -*- C++ -*-
+// Header file for class FitLM_WorkspacePool
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _FitLM_WorkspacePool_H_
+#define _FitLM_WorkspacePool_H_
+
+// Includes
+//
+#include <vector>
+#include <boost/utility.hpp>
+#include <boost/thread/mutex.hpp>
+#include "jpw_nld.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace fortlib {
+
+  // Forward Declarations
+  class FitLM_Workspace;
+
+
+  // Class FitLM_WorkspacePool
+  /**
+   * Lends \c FitLM_Workspace objects to \c FitLM instances, so that fitters
+   * created for each job in a long run reuse the same large buffers.
+   *
+   * Pass the pool to the \c FitLM (or \c FitLM_Adapter) c'tor.  The fitter
+   * borrows a workspace for its lifetime, returning it to the pool when
+   * destroyed.  In steady state, the pool holds one workspace per
+   * concurrently-live fitter, each grown to the largest problem it has
+   * seen, and no fit allocates a new one.
+   *
+   * \c acquire() prefers the smallest idle workspace that's already big
+   * enough.  Failing that, it grows the largest idle one.  It only creates
+   * a new workspace when none are idle.
+   *
+   * All member functions are thread-safe.  The pool must outlive every
+   * fitter using it.
+   *
+   * Link with <tt>$(THREAD_LIBS)</tt> when using this class.
+   */
+  class FitLM_WorkspacePool : private boost::noncopyable
+  {
+  public:
+      /// Constructor
+      FitLM_WorkspacePool();
+
+      /// Destructor
+      /**
+       * Deletes every workspace, including any that are still lent out.
+       */
+      ~FitLM_WorkspacePool();
+
+      /// Borrow a workspace, resized to \a ndata_max and \a nparm.
+      /**
+       * The arguments have the same meanings as those of the \c FitLM
+       * c'tor.  The workspace belongs to the caller until passed to \c
+       * release().
+       */
+      FitLM_Workspace* acquire(index_t ndata_max, index_t nparm);
+
+      /// Return a workspace obtained from \c acquire().
+      void release(FitLM_Workspace* ws);
+
+      /// The number of workspaces the pool has created.
+      size_t size() const;
+
+      /// The number of workspaces not currently lent out.
+      size_t nIdle() const;
+
+      /// The number of calls to \c acquire() that had to allocate memory,
+      /// either for a new workspace or to grow an idle one.
+      /**
+       * Stops increasing once the pool has reached its steady state.
+       */
+      unsigned nAllocations() const;
+
+  private:
+      mutable boost::mutex m__mutex;
+      unsigned m__nAllocations;
+      std::vector<FitLM_Workspace*> m__all;
+      std::vector<FitLM_Workspace*> m__idle;
+  };
+
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_FitLM_WorkspacePool_H_
+/////////////////////////
+//
+// End
@@ -0,0 +1,389 @@
+// -*- C++ -*-
+// Implementation of the square_matrix_inversion functions
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+MatrixInverters_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include "Matrix.h"
+#include "MathTools.h"
+#include "nld_exceptions.h"
+
+#include "details/Matrix.tcc"
+
+#include "FORTLib.h"
+
+
+//
+// Using Decls.
+//
+using namespace jpw_nld::fortlib;
+using namespace jpw_nld::fortlib::square_matrix_inversion;
+
+
+//
+// Static variables
+//
+
+
+static const double EPSMCH = std::numeric_limits<double>::epsilon();
+
+// The one-sided Jacobi SVD stops once no pair of columns has a cosine
+// larger than this, or after this many sweeps.
+static const double JACOBI_TOL = EPSMCH;
+static const unsigned MAX_JACOBI_SWEEPS = 60;
+
+
+//
+// Local Functions
+//
+
+
+namespace {
+
+  // Each of these takes 'a' and 'ainv' as flat, row-major arrays of n*n
+  // elements, and returns false if 'a' is (numerically) singular.  On
+  // failure, 'ainv' is unchanged.
+
+  // The determinant is compared against the product of the rows' norms
+  // (Hadamard's bound), so the test doesn't depend on the matrix's scale.
+  bool isSingular(double det, double hadamard)
+  {
+      return ( std::fabs(det) <= EPSMCH*hadamard );
+  }
+
+
+  double rowNormProduct(unsigned n, const double* a)
+  {
+      double prod(1.0);
+      for(unsigned i=0; i<n; ++i) {
+          double sumSq(0.0);
+          for(unsigned j=0; j<n; ++j) {
+              sumSq += jpw_math::SQR(a[i*n + j]);
+          }
+          prod *= std::sqrt(sumSq);
+      }
+      return prod;
+  }
+
+
+  bool invert1(const double* a, double* ainv)
+  {
+      if(a[0] == 0.0) {
+          return false;
+      }
+      ainv[0] = 1.0/a[0];
+      return true;
+  }
+
+
+  bool invert2(const double* a, double* ainv)
+  {
+      double det = a[0]*a[3] - a[1]*a[2];
+      if(isSingular(det, rowNormProduct(2, a))) {
+          return false;
+      }
+      double invDet = 1.0/det;
+      double a0 = a[0];
+      ainv[0] = a[3]*invDet;
+      ainv[1] = -a[1]*invDet;
+      ainv[2] = -a[2]*invDet;
+      ainv[3] = a0*invDet;
+      return true;
+  }
+
+
+  // The adjugate, built from the 2x2 minors of the top and bottom pairs of
+  // rows.
+  bool invert4(const double* a, double* ainv)
+  {
+      double s0 = a[0]*a[5] - a[4]*a[1];
+      double s1 = a[0]*a[6] - a[4]*a[2];
+      double s2 = a[0]*a[7] - a[4]*a[3];
+      double s3 = a[1]*a[6] - a[5]*a[2];
+      double s4 = a[1]*a[7] - a[5]*a[3];
+      double s5 = a[2]*a[7] - a[6]*a[3];
+
+      double c5 = a[10]*a[15] - a[14]*a[11];
+      double c4 = a[9]*a[15] - a[13]*a[11];
+      double c3 = a[9]*a[14] - a[13]*a[10];
+      double c2 = a[8]*a[15] - a[12]*a[11];
+      double c1 = a[8]*a[14] - a[12]*a[10];
+      double c0 = a[8]*a[13] - a[12]*a[9];
+
+      double det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+      if(isSingular(det, rowNormProduct(4, a))) {
+          return false;
+      }
+      double invDet = 1.0/det;
+
+      double r[16];
+      r[0] = ( a[5]*c5 - a[6]*c4 + a[7]*c3)*invDet;
+      r[1] = (-a[1]*c5 + a[2]*c4 - a[3]*c3)*invDet;
+      r[2] = ( a[13]*s5 - a[14]*s4 + a[15]*s3)*invDet;
+      r[3] = (-a[9]*s5 + a[10]*s4 - a[11]*s3)*invDet;
+
+      r[4] = (-a[4]*c5 + a[6]*c2 - a[7]*c1)*invDet;
+      r[5] = ( a[0]*c5 - a[2]*c2 + a[3]*c1)*invDet;
+      r[6] = (-a[12]*s5 + a[14]*s2 - a[15]*s1)*invDet;
+      r[7] = ( a[8]*s5 - a[10]*s2 + a[11]*s1)*invDet;
+
+      r[8] = ( a[4]*c4 - a[5]*c2 + a[7]*c0)*invDet;
+      r[9] = (-a[0]*c4 + a[1]*c2 - a[3]*c0)*invDet;
+      r[10] = ( a[12]*s4 - a[13]*s2 + a[15]*s0)*invDet;
+      r[11] = (-a[8]*s4 + a[9]*s2 - a[11]*s0)*invDet;
+
+      r[12] = (-a[4]*c3 + a[5]*c1 - a[6]*c0)*invDet;
+      r[13] = ( a[0]*c3 - a[1]*c1 + a[2]*c0)*invDet;
+      r[14] = (-a[12]*s3 + a[13]*s1 - a[14]*s0)*invDet;
+      r[15] = ( a[8]*s3 - a[9]*s1 + a[10]*s0)*invDet;
+
+      std::copy(r, r + 16, ainv);
+      return true;
+  }
+
+
+  // Gauss-Jordan elimination with full pivoting.
+  bool invertGJE(unsigned n, const double* a, double* ainv)
+  {
+      std::vector<double> w(a, a + n*n);
+      std::vector<unsigned> rowOf(n), colOf(n);
+      std::vector<bool> used(n, false);
+
+      double maxAbs(0.0);
+      for(unsigned k=0; k<n*n; ++k) {
+          maxAbs = std::max(maxAbs, std::fabs(w[k]));
+      }
+      double tiny = n*EPSMCH*maxAbs;
+
+      for(unsigned k=0; k<n; ++k)
+      {
+          // Find the pivot among the unused rows and columns.
+          double big(-1.0);
+          unsigned ip(0), jp(0);
+          for(unsigned i=0; i<n; ++i) {
+              if(used[i]) {
+                  continue;
+              }
+              for(unsigned j=0; j<n; ++j) {
+                  if( !used[j] && (std::fabs(w[i*n + j]) > big) ) {
+                      big = std::fabs(w[i*n + j]);
+                      ip = i;
+                      jp = j;
+                  }
+              }
+          }
+          if(big <= tiny) {
+              return false;
+          }
+          used[jp] = true;
+
+          // Move the pivot onto the diagonal.
+          if(ip != jp) {
+              for(unsigned j=0; j<n; ++j) {
+                  std::swap(w[ip*n + j], w[jp*n + j]);
+              }
+          }
+          rowOf[k] = ip;
+          colOf[k] = jp;
+
+          double pivInv = 1.0/w[jp*n + jp];
+          w[jp*n + jp] = 1.0;
+          for(unsigned j=0; j<n; ++j) {
+              w[jp*n + j] *= pivInv;
+          }
+          for(unsigned i=0; i<n; ++i) {
+              if(i == jp) {
+                  continue;
+              }
+              double factor = w[i*n + jp];
+              w[i*n + jp] = 0.0;
+              for(unsigned j=0; j<n; ++j) {
+                  w[i*n + j] -= w[jp*n + j]*factor;
+              }
+          }
+      }
+
+      // Undo the row interchanges by swapping columns, in reverse order.
+      for(unsigned k=n; k-- > 0; ) {
+          if(rowOf[k] != colOf[k]) {
+              for(unsigned i=0; i<n; ++i) {
+                  std::swap(w[i*n + rowOf[k]], w[i*n + colOf[k]]);
+              }
+          }
+      }
+
+      std::copy(w.begin(), w.end(), ainv);
+      return true;
+  }
+
+
+  void checkSquare(const char* who, const dmatrix_t& dm)
+  {
+      if( (dm.nRows() != dm.nColumns()) || !dm.nRows() ) {
+          throw jpw_nld::SizeMismatchError(std::string(who) +
+                                           "():  Matrix is not square.");
+      }
+  }
+
+} // end anon. namespace
+
+
+/////////////////////////
+
+//
+// General Function Definitions
+//
+
+
+int square_matrix_inversion::sqmInvert_GJE(const dmatrix_t& dm,
+                                           dmatrix_t& dm_inv)
+{
+    checkSquare("sqmInvert_GJE", dm);
+    unsigned n(dm.nRows());
+    const double* a = &(dm.as_1D()[0]);
+
+    // The fixed-size cases work in a local array, so they never touch the
+    // heap when 'dm_inv' already has the right shape.
+    if( (n == 1) || (n == 2) || (n == 4) )
+    {
+        double ainv[16];
+        bool ok = ( (n == 1) ? invert1(a, ainv)
+                    : ( (n == 2) ? invert2(a, ainv) : invert4(a, ainv) ) );
+        if(!ok) {
+            return 1;
+        }
+        dm_inv.wipe(n, n);
+        for(unsigned i=0; i<n; ++i) {
+            for(unsigned j=0; j<n; ++j) {
+                dm_inv[i][j] = ainv[i*n + j];
+            }
+        }
+        return 0;
+    }
+
+    std::vector<double> ainv(n*n);
+    if(!invertGJE(n, a, &ainv[0])) {
+        return 1;
+    }
+    dmatrix_t result(ainv, n, n);
+    dm_inv.swap(result);
+    return 0;
+}
+
+
+int square_matrix_inversion::sqmInvert_SVD(const dmatrix_t& dm,
+                                           dmatrix_t& dm_inv)
+{
+    checkSquare("sqmInvert_SVD", dm);
+    unsigned n(dm.nRows());
+
+    // One-sided Jacobi:  rotate the columns of u=dm until they're
+    // orthogonal, accumulating the rotations in v.  Then dm = u*v^T, the
+    // singular values are the norms of the columns of u, and the
+    // pseudo-inverse is v*diag(1/sigma^2)*u^T.  Stored column-major.
+    std::vector<double> u(n*n), v(n*n, 0.0);
+    for(unsigned i=0; i<n; ++i) {
+        for(unsigned j=0; j<n; ++j) {
+            u[j*n + i] = dm[i][j];
+        }
+        v[i*n + i] = 1.0;
+    }
+
+    bool rotated(true);
+    for(unsigned sweep=0; rotated && (sweep<MAX_JACOBI_SWEEPS); ++sweep)
+    {
+        rotated = false;
+        for(unsigned p=0; p+1<n; ++p) {
+            for(unsigned q=p+1; q<n; ++q)
+            {
+                double* up = &u[p*n];
+                double* uq = &u[q*n];
+                double alpha(0.0), beta(0.0), gamma(0.0);
+                for(unsigned i=0; i<n; ++i) {
+                    alpha += up[i]*up[i];
+                    beta += uq[i]*uq[i];
+                    gamma += up[i]*uq[i];
+                }
+                if( std::fabs(gamma) <= JACOBI_TOL*std::sqrt(alpha*beta) ) {
+                    continue;
+                }
+                rotated = true;
+
+                double zeta = (beta - alpha)/(2.0*gamma);
+                double t = ( (zeta >= 0.0 ? 1.0 : -1.0)/
+                             (std::fabs(zeta) + std::sqrt(1.0 + zeta*zeta)) );
+                double c = 1.0/std::sqrt(1.0 + t*t);
+                double s = c*t;
+                double* vp = &v[p*n];
+                double* vq = &v[q*n];
+                for(unsigned i=0; i<n; ++i) {
+                    double tmp = up[i];
+                    up[i] = c*tmp - s*uq[i];
+                    uq[i] = s*tmp + c*uq[i];
+                    tmp = vp[i];
+                    vp[i] = c*tmp - s*vq[i];
+                    vq[i] = s*tmp + c*vq[i];
+                }
+            }
+        }
+    }
+
+    // Singular values, squared, and the cutoff below which they're treated
+    // as zero.
+    std::vector<double> sigmaSq(n);
+    double maxSigmaSq(0.0);
+    for(unsigned j=0; j<n; ++j) {
+        double sumSq(0.0);
+        for(unsigned i=0; i<n; ++i) {
+            sumSq += jpw_math::SQR(u[j*n + i]);
+        }
+        sigmaSq[j] = sumSq;
+        maxSigmaSq = std::max(maxSigmaSq, sumSq);
+    }
+    double cutoff = jpw_math::SQR(n*EPSMCH)*maxSigmaSq;
+
+    int nDropped(0);
+    std::vector<double> ainv(n*n, 0.0);
+    for(unsigned k=0; k<n; ++k)
+    {
+        if( (sigmaSq[k] <= cutoff) || (sigmaSq[k] == 0.0) ) {
+            ++nDropped;
+            continue;
+        }
+        double scale = 1.0/sigmaSq[k];
+        for(unsigned i=0; i<n; ++i) {
+            double vik = v[k*n + i]*scale;
+            for(unsigned j=0; j<n; ++j) {
+                ainv[i*n + j] += vik*u[k*n + j];
+            }
+        }
+    }
+
+    dmatrix_t result(ainv, n, n);
+    dm_inv.swap(result);
+    return nDropped;
+}
+
+
+/////////////////////////
+//
+// End
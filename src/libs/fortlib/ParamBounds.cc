@@ -0,0 +1,150 @@
+// -*- C++ -*-
+// Implementation of class ParamBounds
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+ParamBounds_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <cmath>
+#include <limits>
+#include "ParamBounds.h"
+
+
+using namespace jpw_nld::fortlib;
+using jpw_nld::index_t;
+
+
+//
+// Static variables
+//
+
+
+static const double INF = std::numeric_limits<double>::infinity();
+
+
+//
+// Typedefs
+//
+
+
+/////////////////////////
+
+//
+// ParamBounds Member Functions
+//
+
+
+ParamBounds::ParamBounds(index_t nParams)
+    : m__kind(nParams, Unbounded)
+    , m__lower(nParams, -INF)
+    , m__upper(nParams, INF)
+{}
+
+
+bool ParamBounds::unbounded() const
+{
+    for(index_t j=0; j<m__kind.size(); ++j) {
+        if(m__kind[j] != Unbounded) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void ParamBounds::setUnbounded(index_t j)
+{
+    m__kind[j] = Unbounded;
+    m__lower[j] = -INF;
+    m__upper[j] = INF;
+}
+
+
+void ParamBounds::setLower(index_t j, double lower)
+{
+    if(m__kind[j] == Periodic) {
+        m__upper[j] = INF;
+    }
+    m__kind[j] = Bounded;
+    m__lower[j] = lower;
+}
+
+
+void ParamBounds::setUpper(index_t j, double upper)
+{
+    if(m__kind[j] == Periodic) {
+        m__lower[j] = -INF;
+    }
+    m__kind[j] = Bounded;
+    m__upper[j] = upper;
+}
+
+
+void ParamBounds::setPeriodic(index_t j, double lower, double period)
+{
+    m__kind[j] = Periodic;
+    m__lower[j] = lower;
+    m__upper[j] = lower + period;
+}
+
+
+void ParamBounds::setReflected(index_t j, double lower, double upper)
+{
+    m__kind[j] = Reflected;
+    m__lower[j] = lower;
+    m__upper[j] = upper;
+}
+
+
+void ParamBounds::project(double* x) const
+{
+    for(index_t j=0; j<m__kind.size(); ++j)
+    {
+        switch(m__kind[j])
+        {
+        case Reflected:
+            x[j] = std::fabs(x[j]);
+            // Fall through
+        case Bounded:
+            if(x[j] < m__lower[j]) {
+                x[j] = m__lower[j];
+            } else if(x[j] > m__upper[j]) {
+                x[j] = m__upper[j];
+            }
+            break;
+
+        case Periodic:
+            if( (x[j] < m__lower[j]) || (x[j] >= m__upper[j]) ) {
+                double period = m__upper[j] - m__lower[j];
+                x[j] -= period*std::floor((x[j] - m__lower[j])/period);
+                // Roundoff can leave x[j] exactly at the upper end.
+                if(x[j] >= m__upper[j]) {
+                    x[j] = m__lower[j];
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+
+/////////////////////////
+//
+// End
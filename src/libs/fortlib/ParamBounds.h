@@ -0,0 +1,155 @@
+// -*- C++ -*-
+// Header file for class ParamBounds
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _ParamBounds_H_
+#define _ParamBounds_H_
+
+// Includes
+//
+#include <vector>
+#include <limits>
+#include "jpw_nld.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace fortlib {
+
+
+  // Class ParamBounds
+  /**
+   * The domain of each tunable parameter of a model.
+   *
+   * Each parameter is one of:
+   * - unbounded (the default);
+   * - bounded, with a lower bound, an upper bound, or both.  (A missing
+   *   bound is stored as \f$\pm\infty\f$.);
+   * - periodic, with the model's value unchanged when the parameter shifts
+   *   by a whole period.  The parameter is kept within
+   *   <tt>[lower(), lower()+period())</tt>;
+   * - reflected, with the model's value unchanged when the parameter
+   *   changes sign.  Its magnitude is bounded, and it's kept on the
+   *   positive branch.
+   *
+   * \c FitLM uses these to run a projected Levenberg-Marquardt fit, which
+   * never evaluates the fit-function outside of the domain.
+   */
+  class ParamBounds
+  {
+  public:
+      /// The kinds of bound.
+      enum BoundKind_t {
+          Unbounded,
+          Bounded,
+          Periodic,
+          Reflected,
+      };
+
+      /// Constructor
+      /**
+       * All \a nParams parameters start out unbounded.
+       */
+      explicit ParamBounds(index_t nParams=0);
+
+      /// Destructor
+      ~ParamBounds() {}
+
+      /// The number of parameters.
+      index_t size() const
+      { return m__kind.size(); }
+
+      /// \c true if every parameter is unbounded.
+      bool unbounded() const;
+
+      /// Remove the bounds on parameter \a j.
+      void setUnbounded(index_t j);
+
+      /// Set a lower bound on parameter \a j, keeping any upper bound.
+      void setLower(index_t j, double lower);
+
+      /// Set an upper bound on parameter \a j, keeping any lower bound.
+      void setUpper(index_t j, double upper);
+
+      /// Set both bounds on parameter \a j.
+      void setRange(index_t j, double lower, double upper)
+      {
+          setLower(j, lower);
+          setUpper(j, upper);
+      }
+
+      /// Make parameter \a j periodic, with values kept in
+      /// <tt>[lower, lower+period)</tt>.
+      void setPeriodic(index_t j, double lower, double period);
+
+      /// Make parameter \a j reflected, with its magnitude kept in
+      /// <tt>[lower, upper]</tt>.
+      /**
+       * \a lower must be non-negative.
+       */
+      void setReflected(index_t j, double lower,
+                        double upper=std::numeric_limits<double>::infinity());
+
+      /// The kind of bound on parameter \a j.
+      BoundKind_t kind(index_t j) const
+      { return m__kind[j]; }
+
+      /// The lower bound on parameter \a j.
+      /**
+       * \f$-\infty\f$ if there isn't one.  For a periodic parameter, the
+       * start of the period.
+       */
+      double lower(index_t j) const
+      { return m__lower[j]; }
+
+      /// The upper bound on parameter \a j.
+      /**
+       * \f$+\infty\f$ if there isn't one.  For a periodic parameter, the
+       * end of the period.
+       */
+      double upper(index_t j) const
+      { return m__upper[j]; }
+
+      /// Moves each element of \a x into the domain.
+      /**
+       * Bounded parameters are clamped to their bounds; periodic ones are
+       * shifted by a whole number of periods.  Reflected ones have their
+       * sign dropped, then are clamped.
+       *
+       * \a x must have at least \c size() elements.
+       */
+      void project(double* x) const;
+
+      /// Overload for \c std::vector
+      void project(std::vector<double>& x) const
+      { project(&x[0]); }
+
+  private:
+      std::vector<BoundKind_t> m__kind;
+      std::vector<double> m__lower;
+      std::vector<double> m__upper;
+  };
+
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_ParamBounds_H_
+/////////////////////////
+//
+// End
@@ -0,0 +1,596 @@
+// -*- C++ -*-
+// Implementation of class ProjectedLM
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+ProjectedLM_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "ProjectedLM.h"
+#include "MathTools.h"
+
+
+using namespace jpw_nld::fortlib;
+using jpw_nld::index_t;
+
+
+//
+// Static variables
+//
+
+
+static const double EPSMCH = std::numeric_limits<double>::epsilon();
+
+static const double DWARF = std::numeric_limits<double>::min();
+
+// Steps whose actual/predicted reduction ratio falls below this are
+// rejected.
+static const double MIN_ACCEPT_RATIO = 1.0e-4;
+
+// lmpar_() gives up refining the damping parameter after this many tries.
+static const unsigned MAX_LMPAR_ITERS = 10;
+
+
+//
+// Local Functions
+//
+
+
+namespace {
+
+  double enorm(int n, const double* v)
+  {
+      double sumSq(0.0);
+      for(int i=0; i<n; ++i) {
+          sumSq += jpw_math::SQR(v[i]);
+      }
+      return std::sqrt(sumSq);
+  }
+
+
+  // The factor by which lmder_() shrinks its trust region after a poor
+  // step.
+  double shrinkFactor(double actred, double dirder,
+                      double fnorm1, double fnorm)
+  {
+      double temp = ( (actred >= 0.0) ? 0.5 :
+                      0.5*dirder/(dirder + 0.5*actred) );
+      if( (0.1*fnorm1 >= fnorm) || (temp < 0.1) ) {
+          temp = 0.1;
+      }
+      return temp;
+  }
+
+} // end anon. namespace
+
+
+/////////////////////////
+
+//
+// ProjectedLM Member Functions
+//
+
+
+ProjectedLM::ProjectedLM(const ParamBounds& bounds, StepRule_t rule)
+    : m__bounds(bounds)
+    , m__rule(rule)
+    , m__n(bounds.size())
+    , m__diag(m__n)
+    , m__grad(m__n)
+    , m__jtj(m__n*m__n)
+    , m__chol(m__n*m__n)
+    , m__step(m__n)
+    , m__direction(m__n)
+    , m__xTrial(m__n)
+    , m__work(m__n)
+    , m__free()
+{
+    m__free.reserve(m__n);
+}
+
+
+int ProjectedLM::operator()(FitLM::fit_function_ptr_t fcn, int m, int n,
+                            double* x, double* fvec, double* fjac,
+                            int ldfjac, double ftol, double xtol,
+                            int maxfev, double factor, int nprint,
+                            int& nfev, int& njev, double* wa)
+{
+    nfev = 0;
+    njev = 0;
+    if( (static_cast<index_t>(n) != m__n) || (m < n) || (ldfjac < m) ||
+        (ftol < 0.0) || (xtol < 0.0) || (maxfev <= 0) || (factor <= 0.0) )
+    {
+        return FitLM::InputError;
+    }
+    // The residuals at the trial point.
+    double* fTrial = wa;
+
+    int info(0);
+    int iflag(FitLM::ComputeFunction);
+    m__bounds.project(x);
+    fcn(&m, &n, x, fvec, fjac, &ldfjac, &iflag);
+    nfev = 1;
+    double fnorm = enorm(m, fvec);
+
+    double par(0.0), delta(0.0), xnorm(0.0);
+    for(int iter=1; (iflag >= 0) && !info; ++iter)
+    {
+        iflag = FitLM::ComputeJacobian;
+        fcn(&m, &n, x, fvec, fjac, &ldfjac, &iflag);
+        ++njev;
+        if(iflag < 0) {
+            break;
+        }
+
+        if( (nprint > 0) && ((iter - 1)%nprint == 0) ) {
+            iflag = FitLM::ReportProgress;
+            fcn(&m, &n, x, fvec, fjac, &ldfjac, &iflag);
+            if(iflag < 0) {
+                break;
+            }
+        }
+
+        // The normal equations and the gradient.
+        for(index_t j=0; j<m__n; ++j)
+        {
+            const double* colj = fjac + j*ldfjac;
+            double gj(0.0);
+            for(int i=0; i<m; ++i) {
+                gj += colj[i]*fvec[i];
+            }
+            m__grad[j] = gj;
+
+            for(index_t k=0; k<=j; ++k) {
+                const double* colk = fjac + k*ldfjac;
+                double ajk(0.0);
+                for(int i=0; i<m; ++i) {
+                    ajk += colj[i]*colk[i];
+                }
+                m__jtj[j*m__n + k] = ajk;
+                m__jtj[k*m__n + j] = ajk;
+            }
+        }
+
+        // Scaling, as lmder_() does it with mode==1.
+        for(index_t j=0; j<m__n; ++j) {
+            double colNorm = std::sqrt(m__jtj[j*m__n + j]);
+            if(iter == 1) {
+                m__diag[j] = ( (colNorm == 0.0) ? 1.0 : colNorm );
+            } else {
+                m__diag[j] = std::max(m__diag[j], colNorm);
+            }
+        }
+        if(iter == 1) {
+            xnorm = scaledNorm(x);
+            delta = factor*xnorm;
+            if(delta == 0.0) {
+                delta = factor;
+            }
+        }
+
+        // The active set.
+        m__free.clear();
+        for(index_t j=0; j<m__n; ++j) {
+            // A reflected parameter is already on its positive branch.
+            bool pinned = ( ((m__bounds.kind(j) == ParamBounds::Bounded) ||
+                             (m__bounds.kind(j) == ParamBounds::Reflected)) &&
+                            ( ((x[j] <= m__bounds.lower(j)) &&
+                               (m__grad[j] > 0.0)) ||
+                              ((x[j] >= m__bounds.upper(j)) &&
+                               (m__grad[j] < 0.0)) ) );
+            if(!pinned) {
+                m__free.push_back(j);
+            }
+        }
+        if( m__free.empty() || (fnorm == 0.0) ) {
+            info = FitLM::MachinePrec;
+            break;
+        }
+
+        // The Gauss-Newton step doesn't change until the next Jacobian.
+        if(m__rule != LevenbergMarquardt) {
+            gaussNewtonStep();
+        }
+
+        // Inner loop:  find an acceptable step.
+        double ratio(0.0);
+        double alpha(1.0);
+        while( (ratio < MIN_ACCEPT_RATIO) && !info )
+        {
+            switch(m__rule) {
+            case Dogleg:
+                par = doglegStep(delta);
+                break;
+            case GaussNewton:
+                for(index_t j=0; j<m__n; ++j) {
+                    m__step[j] = alpha*m__direction[j];
+                }
+                break;
+            default:
+                par = lmParameter(delta, par);
+                break;
+            }
+
+            // Project the trial point.  Bounded parameters are clamped,
+            // and the step adjusted to match.  Reflected ones are clamped
+            // on whichever branch the step lands.  Periodic and reflected
+            // ones keep the unwrapped (unreflected) step for the prediction
+            // below.
+            for(index_t j=0; j<m__n; ++j) {
+                double xt = x[j] + m__step[j];
+                switch(m__bounds.kind(j))
+                {
+                case ParamBounds::Bounded:
+                    xt = std::min(std::max(xt, m__bounds.lower(j)),
+                                  m__bounds.upper(j));
+                    m__step[j] = xt - x[j];
+                    break;
+                case ParamBounds::Reflected:
+                {
+                    double mag = std::min(std::max(std::fabs(xt),
+                                                   m__bounds.lower(j)),
+                                          m__bounds.upper(j));
+                    xt = ( (xt < 0.0) ? -mag : mag );
+                    m__step[j] = xt - x[j];
+                    break;
+                }
+                default:
+                    break;
+                }
+                m__xTrial[j] = xt;
+            }
+            double pnorm = scaledNorm(&m__step[0]);
+            m__bounds.project(m__xTrial);
+            if(iter == 1) {
+                delta = std::min(delta, pnorm);
+            }
+
+            iflag = FitLM::ComputeFunction;
+            fcn(&m, &n, &m__xTrial[0], fTrial, fjac, &ldfjac,
+                &iflag);
+            ++nfev;
+            if(iflag < 0) {
+                break;
+            }
+            double fnorm1 = enorm(m, fTrial);
+
+            // Actual and predicted relative reductions in the sum of
+            // squares, and the directional derivative.  The latter two use
+            // the projected step.
+            double actred(-1.0);
+            if(0.1*fnorm1 < fnorm) {
+                actred = 1.0 - jpw_math::SQR(fnorm1/fnorm);
+            }
+            double gDotStep(0.0), quad(0.0);
+            for(index_t j=0; j<m__n; ++j) {
+                double ajs(0.0);
+                for(index_t k=0; k<m__n; ++k) {
+                    ajs += m__jtj[j*m__n + k]*m__step[k];
+                }
+                gDotStep += m__grad[j]*m__step[j];
+                quad += m__step[j]*ajs;
+            }
+            double fnormSq = jpw_math::SQR(fnorm);
+            double prered = -(2.0*gDotStep + quad)/fnormSq;
+            double dirder = gDotStep/fnormSq;
+            ratio = ( (prered != 0.0) ? actred/prered : 0.0 );
+
+            // Update the trust region, as lmder_() does.  The line search
+            // shrinks its step by the same factor, and uses the length of
+            // the next trial step in place of the radius.
+            if(m__rule == GaussNewton) {
+                delta = pnorm;
+                if(ratio < MIN_ACCEPT_RATIO) {
+                    double temp = shrinkFactor(actred, dirder, fnorm1, fnorm);
+                    alpha *= temp;
+                    delta *= temp;
+                }
+            } else if(ratio <= 0.25) {
+                double temp = shrinkFactor(actred, dirder, fnorm1, fnorm);
+                delta = temp*std::min(delta, 10.0*pnorm);
+                par /= temp;
+            } else if( (par == 0.0) || (ratio >= 0.75) ) {
+                delta = 2.0*pnorm;
+                par *= 0.5;
+            }
+
+            if(ratio >= MIN_ACCEPT_RATIO) {
+                std::copy(m__xTrial.begin(), m__xTrial.end(), x);
+                std::copy(fTrial, fTrial + m, fvec);
+                fnorm = fnorm1;
+                xnorm = scaledNorm(x);
+            }
+
+            // Convergence tests.
+            if( (std::fabs(actred) <= ftol) && (prered <= ftol) &&
+                (0.5*ratio <= 1.0) )
+            {
+                info = FitLM::Success_SumSq;
+            }
+            if(delta <= xtol*xnorm) {
+                info += FitLM::Success_dParam;
+            }
+            if(info) {
+                break;
+            }
+
+            // Termination tests.
+            if(nfev >= maxfev) {
+                info = FitLM::IterationOverflow;
+            } else if( (std::fabs(actred) <= EPSMCH) &&
+                       (prered <= EPSMCH) && (0.5*ratio <= 1.0) )
+            {
+                info = FitLM::UnderflowError_SumSq;
+            } else if(delta <= EPSMCH*xnorm) {
+                info = FitLM::UnderflowError_dParam;
+            }
+        }
+    }
+
+    if(iflag < 0) {
+        info = iflag;
+    }
+    if(nprint > 0) {
+        iflag = FitLM::ReportProgress;
+        fcn(&m, &n, x, fvec, fjac, &ldfjac, &iflag);
+    }
+    return info;
+}
+
+
+// Finds the damping parameter whose step has a scaled length within 10% of
+// the trust-region radius, \a delta, starting from the estimate, \a par.
+// This is lmpar_() from MINPACK, using a Cholesky decomposition of the
+// normal equations over the free parameters, in place of a QR.
+//
+// Leaves the corresponding (unprojected) step in m__step.
+double ProjectedLM::lmParameter(double delta, double par)
+{
+    // Try the Gauss-Newton step first.
+    double dxnorm(0.0), fp(0.0), parl(0.0);
+    if(solveStep(0.0)) {
+        dxnorm = scaledNorm(&m__step[0]);
+        fp = dxnorm - delta;
+        if(fp <= 0.1*delta) {
+            return 0.0;
+        }
+        parl = (fp/delta)/newtonDenominator(dxnorm);
+    }
+
+    double gnorm(0.0);
+    for(index_t a=0; a<m__free.size(); ++a) {
+        index_t j = m__free[a];
+        gnorm += jpw_math::SQR(m__grad[j]/m__diag[j]);
+    }
+    gnorm = std::sqrt(gnorm);
+    double paru = gnorm/delta;
+    if(paru == 0.0) {
+        paru = DWARF/std::min(delta, 0.1);
+    }
+
+    par = std::min(std::max(par, parl), paru);
+    if( (par == 0.0) && (dxnorm > 0.0) ) {
+        par = gnorm/dxnorm;
+    }
+
+    for(unsigned iter=1; ; ++iter)
+    {
+        if(par == 0.0) {
+            par = std::max(DWARF, 0.001*paru);
+        }
+        if(!solveStep(par)) {
+            // Roundoff; only possible for a tiny par.
+            parl = par;
+            par *= 10.0;
+            continue;
+        }
+
+        dxnorm = scaledNorm(&m__step[0]);
+        double fpOld = fp;
+        fp = dxnorm - delta;
+        if( (std::fabs(fp) <= 0.1*delta) ||
+            ((parl == 0.0) && (fp <= fpOld) && (fpOld < 0.0)) ||
+            (iter == MAX_LMPAR_ITERS) )
+        {
+            break;
+        }
+
+        // Newton correction.
+        double parc = (fp/delta)/newtonDenominator(dxnorm);
+        if(fp > 0.0) {
+            parl = std::max(parl, par);
+        } else if(fp < 0.0) {
+            paru = std::min(paru, par);
+        }
+        par = std::max(parl, par + parc);
+    }
+    return par;
+}
+
+
+// Powell's dogleg step for the trust-region radius, \a delta, using the
+// Gauss-Newton step left in m__direction by gaussNewtonStep().  Leaves the
+// step in m__step.
+//
+// Returns 0 if it's the Gauss-Newton step, and 1 if the trust region cut
+// it short.  (The same meaning that "par == 0" has for lmParameter().)
+double ProjectedLM::doglegStep(double delta)
+{
+    if(scaledNorm(&m__direction[0]) <= delta) {
+        std::copy(m__direction.begin(), m__direction.end(), m__step.begin());
+        return 0.0;
+    }
+
+    // The steepest-descent direction in the scaled parameters.
+    std::fill(m__step.begin(), m__step.end(), 0.0);
+    double gnormSq(0.0);
+    for(index_t a=0; a<m__free.size(); ++a) {
+        index_t j = m__free[a];
+        m__step[j] = -m__grad[j]/jpw_math::SQR(m__diag[j]);
+        gnormSq += jpw_math::SQR(m__grad[j]/m__diag[j]);
+    }
+    double gnorm = std::sqrt(gnormSq);
+
+    // |J*step|^2, to find the Cauchy point.
+    double curv(0.0);
+    for(index_t j=0; j<m__n; ++j) {
+        double ajs(0.0);
+        for(index_t k=0; k<m__n; ++k) {
+            ajs += m__jtj[j*m__n + k]*m__step[k];
+        }
+        curv += m__step[j]*ajs;
+    }
+
+    // The Cauchy point lies outside of the region:  take the steepest-
+    // descent step to its edge.
+    if( (curv <= 0.0) || (gnormSq*gnorm >= delta*curv) ) {
+        for(index_t j=0; j<m__n; ++j) {
+            m__step[j] *= delta/gnorm;
+        }
+        return 1.0;
+    }
+
+    // Otherwise, walk from the Cauchy point towards the Gauss-Newton step,
+    // stopping at the edge of the region.
+    double t = gnormSq/curv;
+    double a(0.0), b(0.0), c(-jpw_math::SQR(delta));
+    for(index_t j=0; j<m__n; ++j) {
+        m__step[j] *= t;
+        double u = m__diag[j]*m__step[j];
+        double v = m__diag[j]*(m__direction[j] - m__step[j]);
+        a += v*v;
+        b += u*v;
+        c += u*u;
+    }
+    double beta = (-b + std::sqrt(b*b - a*c))/a;
+    for(index_t j=0; j<m__n; ++j) {
+        m__step[j] += beta*(m__direction[j] - m__step[j]);
+    }
+    return 1.0;
+}
+
+
+// Puts the Gauss-Newton step over the free parameters into m__direction.
+// A singular J^T*J gets just enough damping to make it solvable.
+void ProjectedLM::gaussNewtonStep()
+{
+    double mu(0.0);
+    while(!solveStep(mu)) {
+        mu = ( (mu == 0.0) ? EPSMCH : 10.0*mu );
+    }
+    std::copy(m__step.begin(), m__step.end(), m__direction.begin());
+}
+
+
+// Solves (J^T*J + mu*D^2)*step = -grad over the free parameters, by
+// Cholesky decomposition.  The pinned parameters get a zero step.
+//
+// Returns false if the system isn't positive-definite.
+bool ProjectedLM::solveStep(double mu)
+{
+    index_t nf = m__free.size();
+
+    for(index_t a=0; a<nf; ++a) {
+        index_t j = m__free[a];
+        for(index_t b=0; b<=a; ++b) {
+            m__chol[a*nf + b] = m__jtj[j*m__n + m__free[b]];
+        }
+        m__chol[a*nf + a] += mu*jpw_math::SQR(m__diag[j]);
+    }
+
+    // In-place Cholesky:  lower triangle of m__chol becomes L.
+    for(index_t a=0; a<nf; ++a) {
+        for(index_t b=0; b<=a; ++b) {
+            double sum = m__chol[a*nf + b];
+            for(index_t k=0; k<b; ++k) {
+                sum -= m__chol[a*nf + k]*m__chol[b*nf + k];
+            }
+            if(a == b) {
+                if(sum <= 0.0) {
+                    return false;
+                }
+                m__chol[a*nf + a] = std::sqrt(sum);
+            } else {
+                m__chol[a*nf + b] = sum/m__chol[b*nf + b];
+            }
+        }
+    }
+
+    // Forward-, then back-substitution.
+    for(index_t a=0; a<nf; ++a) {
+        m__work[a] = -m__grad[m__free[a]];
+    }
+    forwardSubst();
+    for(index_t a=nf; a-- > 0; ) {
+        double sum = m__work[a];
+        for(index_t k=a+1; k<nf; ++k) {
+            sum -= m__chol[k*nf + a]*m__work[k];
+        }
+        m__work[a] = sum/m__chol[a*nf + a];
+    }
+
+    std::fill(m__step.begin(), m__step.end(), 0.0);
+    for(index_t a=0; a<nf; ++a) {
+        m__step[m__free[a]] = m__work[a];
+    }
+    return true;
+}
+
+
+// Replaces m__work with L^{-1}*m__work, using the factor left by
+// solveStep().
+void ProjectedLM::forwardSubst()
+{
+    index_t nf = m__free.size();
+    for(index_t a=0; a<nf; ++a) {
+        double sum = m__work[a];
+        for(index_t k=0; k<a; ++k) {
+            sum -= m__chol[a*nf + k]*m__work[k];
+        }
+        m__work[a] = sum/m__chol[a*nf + a];
+    }
+}
+
+
+// The denominator of lmpar_()'s Newton correction:  the squared norm of
+// L^{-1}*D^2*step/|D*step|, for the step and factor left by solveStep().
+double ProjectedLM::newtonDenominator(double dxnorm)
+{
+    for(index_t a=0; a<m__free.size(); ++a) {
+        index_t j = m__free[a];
+        m__work[a] = jpw_math::SQR(m__diag[j])*m__step[j]/dxnorm;
+    }
+    forwardSubst();
+    return jpw_math::SQR(enorm(m__free.size(), &m__work[0]));
+}
+
+
+double ProjectedLM::scaledNorm(const double* v) const
+{
+    double sumSq(0.0);
+    for(index_t j=0; j<m__n; ++j) {
+        sumSq += jpw_math::SQR(m__diag[j]*v[j]);
+    }
+    return std::sqrt(sumSq);
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,174 @@
+// -*- C++ -*-
+// Header file for class ProjectedLM
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _ProjectedLM_H_
+#define _ProjectedLM_H_
+
+// Includes
+//
+#include <boost/utility.hpp>
+#include "jpw_nld.h"
+#include "FitLM.h"
+#include "ParamBounds.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace fortlib {
+
+
+  // Class ProjectedLM
+  /**
+   * A projected Levenberg-Marquardt minimizer, for parameters with bounds.
+   *
+   * \c FitLM uses this in place of \c lmder_() whenever it has bounds (see
+   * \c FitLM::setBounds()).  It takes the same fit-function, the same
+   * arguments and returns the same status codes as \c lmder_(), so the
+   * switch is transparent to the fit-function.
+   *
+   * Each iteration:
+   * -# Computes the Jacobian, \f$ J \f$, and the gradient, \f$ g = J^{T}f
+   *    \f$.
+   * -# Holds fixed each parameter that sits on one of its bounds with the
+   *    gradient pointing out of the domain.  (The "active set.")
+   * -# Solves \f$ \left(J^{T}J + \mu D^{2}\right)\delta = -g \f$ for the
+   *    remaining parameters, where \f$ D \f$ holds the running maximum of
+   *    the column-norms of \f$ J \f$.  The damping, \f$ \mu \f$, is
+   *    chosen to keep \f$ |D\delta| \f$ within a trust region, exactly as
+   *    \c lmder_() does.
+   * -# Projects \f$ x + \delta \f$ back onto the domain, and judges the
+   *    projected step by the ratio of the actual to the predicted reduction
+   *    in \f$\chi^2\f$.  The trust region is resized using \c lmder_()'s
+   *    rules; rejected steps are retried in a smaller region.
+   *
+   * With no bound active, the iterates match those of \c lmder_() up to
+   * roundoff.  (The step comes from a Cholesky decomposition of the normal
+   * equations instead of a QR decomposition of \f$ J \f$.  That's fine
+   * for the handful of parameters in a typical model.)
+   *
+   * Periodic parameters are never clamped.  Accepted steps are wrapped
+   * back into their period, which leaves the fit-function's value
+   * unchanged.  So, unlike an in-place \c MOD_1 inside of the fit-function,
+   * the wrap never disturbs the minimizer's bookkeeping.  Reflected
+   * parameters are treated the same way:  clamped on whichever branch a
+   * step lands, then moved back to the positive one.
+   *
+   * The convergence tests mirror those of \c lmder_() (with \a gtol \c
+   * =0).  A return value of \c FitLM::MachinePrec also means that every
+   * parameter is pinned to a bound.
+   *
+   * The step itself can come from one of three rules (see \c
+   * setStepRule()).  All of them share the active set, the projection and
+   * the acceptance and convergence tests above:
+   * - \c LevenbergMarquardt:  the damped step described above.
+   * - \c Dogleg:  Powell's dogleg.  The Gauss-Newton step if it lies
+   *   within the trust region; otherwise the point where the path from
+   *   the Cauchy point (the minimum along the scaled gradient) to the
+   *   Gauss-Newton step leaves the region.  No search for \f$ \mu \f$, so
+   *   each trial step costs one Cholesky decomposition at most.
+   * - \c GaussNewton:  the undamped Gauss-Newton step, shortened by a
+   *   backtracking line search instead of a trust region.  Each search
+   *   starts from the full step; rejected trials shrink it by the same
+   *   factor \c lmder_() uses to shrink its trust region.
+   */
+  class ProjectedLM : private boost::noncopyable
+  {
+  public:
+      /// How each trial step is chosen.
+      enum StepRule_t {
+          /// The Levenberg-Marquardt step, as in \c lmder_().
+          LevenbergMarquardt,
+          /// Powell's dogleg step.
+          Dogleg,
+          /// The Gauss-Newton step, with a backtracking line search.
+          GaussNewton,
+      };
+
+      /// Constructor
+      explicit ProjectedLM(const ParamBounds& bounds,
+                           StepRule_t rule=LevenbergMarquardt);
+
+      /// Destructor
+      ~ProjectedLM() {}
+
+      /// The parameter bounds.
+      const ParamBounds& bounds() const
+      { return m__bounds; }
+
+      /// Select how each trial step is chosen.
+      void setStepRule(StepRule_t rule)
+      { m__rule = rule; }
+
+      /// The current \c StepRule_t.
+      StepRule_t stepRule() const
+      { return m__rule; }
+
+      /// Minimize the sum of squares of \a fcn.
+      /**
+       * The arguments have the same meanings as those of \c lmder_(), and
+       * \a n must equal \c bounds().size().  \a x is projected onto the
+       * domain before the first evaluation.  \a wa is a work array of \a m
+       * elements, like \c lmder_()'s \a wa4.
+       *
+       * \returns The same \a info codes as \c lmder_().
+       */
+      int operator()(FitLM::fit_function_ptr_t fcn, int m, int n,
+                     double* x, double* fvec, double* fjac, int ldfjac,
+                     double ftol, double xtol, int maxfev, double factor,
+                     int nprint, int& nfev, int& njev, double* wa);
+
+      /// \f$ J^{T}J \f$, from the last Jacobian used by \c operator().
+      /**
+       * A symmetric \a n by \a n matrix, flattened row by row.
+       */
+      const dvector_t& normalMatrix() const
+      { return m__jtj; }
+
+  private:
+      double lmParameter(double delta, double par);
+      double doglegStep(double delta);
+      void gaussNewtonStep();
+      bool solveStep(double mu);
+      void forwardSubst();
+      double newtonDenominator(double dxnorm);
+      double scaledNorm(const double* v) const;
+
+      ParamBounds m__bounds;
+      StepRule_t m__rule;
+      index_t m__n;
+      dvector_t m__diag;
+      dvector_t m__grad;
+      dvector_t m__jtj;
+      dvector_t m__chol;
+      dvector_t m__step;
+      // The Gauss-Newton step, or the scaled gradient direction.
+      dvector_t m__direction;
+      dvector_t m__xTrial;
+      dvector_t m__work;
+      std::vector<index_t> m__free;
+  };
+
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_ProjectedLM_H_
+/////////////////////////
+//
+// End
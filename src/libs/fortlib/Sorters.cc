@@ -20,9 +20,9 @@ Sorters_cc__="RCS $Id: Sorters.cc 1864 2009-08-18 02:50:20Z candide $";
 // Includes
 //
 #include <string>
-#include <algorithm>
-#include <boost/lexical_cast.hpp>
+#include <functional>
 #include "Matrix.h"
+#include "ArgSort.h"
 
 #include "details/Matrix.tcc"
 
@@ -33,9 +33,7 @@ Sorters_cc__="RCS $Id: Sorters.cc 1864 2009-08-18 02:50:20Z candide $";
 // Using Decls.
 //
 using std::string;
-using std::runtime_error;
 using std::length_error;
-using boost::lexical_cast;
 
 using namespace jpw_nld::fortlib;
 
@@ -50,49 +48,6 @@ using namespace jpw_nld::fortlib;
 //
 
 
-/////////////////////////
-
-
-//
-// External FORTRAN Functions
-//
-
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-    extern void dpsort_(double *, int *, int *, int *, int *);
-#ifdef __cplusplus
-}; /* end extern "C" */
-#endif
-
-
-/////////////////////////
-
-//
-// Exception Class Member Functions
-//
-
-inline string
-sort::SortError::errMessage(const string& where,
-                            const string& fortFn, int errCode)
-{
-    string mesg("While executing ");
-    mesg += where;
-    mesg += "():\n\tFatal error in FORTRAN subroutine ";
-    mesg += fortFn;
-    mesg += "() - Error #";
-    mesg += lexical_cast<string>(errCode);
-    return mesg;
-}
-
-
-sort::SortError::SortError(const string& where,
-                           const string& fortFn, int errCode)
-    : runtime_error(errMessage(where, fortFn, errCode))
-{}
-
-
 /////////////////////////
 
 //
@@ -104,18 +59,15 @@ sort::SortError::SortError(const string& where,
    altering the original list of values. */
 void sort::byIndex(const dvector_t& dlst, ivector_t& idxarr, int dir)
 {
-    int kflag(1);
     if(dir < 0) {
-        kflag = -1;
+        jpw_math::argSort(dlst, idxarr, std::greater<double>());
+    } else {
+        jpw_math::argSort(dlst, idxarr);
     }
 
-    int err(0);
-    int nn(dlst.size());
-    std::fill(idxarr.begin(), idxarr.end(), 0);
-    dpsort_(const_cast<double*>(&dlst[0]), &nn, &idxarr[0], &kflag, &err);
-
-    if(err) {
-        throw SortError("jpw_nld::fortlib::sort::byIndex", "dpsort", err);
+    // The 1-based indices of the SLATEC routine this replaced.
+    for(ivector_t::size_type i=0; i<idxarr.size(); ++i) {
+        ++idxarr[i];
     }
 }
 
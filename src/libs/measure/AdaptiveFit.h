@@ -0,0 +1,376 @@
+// -*- C++ -*-
+// Header file for class AdaptiveFit
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _AdaptiveFit_H_
+#define _AdaptiveFit_H_
+
+// Includes
+//
+#include <limits>
+#include <boost/utility.hpp>
+#include <boost/scoped_ptr.hpp>
+#include "jpw_nld.h"
+#include "ThreadTeam.h"
+#include "PersistenceMap.h"
+#include "WarmStartIndex.h"
+#include "FitLM_BarrierAdapter.h"
+#include "MultiStartLM.h"
+#include "FitGA.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace measure {
+
+
+ // Class AdaptiveFit
+ /**
+  * Fits a \c PersistenceMap with the cheapest strategy that works,
+  * escalating to more expensive ones only when needed.
+  *
+  * The strategies, or "tiers," are tried in this order:
+  * -# \c WarmLM:  a single \c FitLM_BarrierAdapter fit from the caller's
+  *    starting point, or from the closest entry of a \c WarmStartIndex
+  *    (see \c setWarmStartIndex()).  Skipped if there's neither.
+  * -# \c MultiStart:  a \c MultiStartLM run from \c nRandomStarts()
+  *    random points (plus the result of the first tier, if any).
+  * -# \c GeneticAlgorithm:  a \c FitGA run, followed by an LM fit from
+  *    its best member.
+  *
+  * A tier succeeds if its best fit converged and passes the
+  * \f$\chi^2\f$ quality gate.  A fit has converged if its \c
+  * FitStatus_t is a success, an underflow, or \c MachinePrec (i.e.,
+  * anything above \c InputError except \c IterationOverflow).  The gate
+  * compares the reduced \f$\chi^2\f$, \f$\chi^2 / (N - p)\f$ for \f$N\f$
+  * data and \f$p\f$ parameters, with \c maxReducedChiSq().  It's off by
+  * default, in which case only the \c FitStatus_t counts.  Set it to a
+  * small multiple of the variance of the noise in the maps.
+  *
+  * \c tier() reports which tier succeeded, and \c nSolved() keeps count
+  * of them over many fits.
+  *
+  * Translation units \#including this header should also
+  * <tt>\#include&nbsp;"details/BarrierModels.tcc"</tt> and
+  * <tt>\#include&nbsp;"details/FitGA.tcc"</tt>.  Link with
+  * <tt>$(THREAD_LIBS)</tt>.
+  */
+  template<class F_POL_T=policy::Full>
+  class AdaptiveFit : private boost::noncopyable
+  {
+  public:
+      typedef MultiStartLM<F_POL_T> MultiStart_t;
+      typedef typename MultiStart_t::Adapter_t Adapter_t;
+      typedef typename Adapter_t::Model_t Model_t;
+      typedef typename Adapter_t::FitStatus_t FitStatus_t;
+      typedef optimize::FitGA<Model_t, PersistenceMap> FitGA_t;
+
+      static const index_t N_PARAMETERS=Model_t::N_PARAMETERS;
+
+      /// The strategies, cheapest first.
+      enum Tier_t {
+          /// No tier succeeded.
+          NoTier=0,
+          WarmLM,
+          MultiStart,
+          GeneticAlgorithm,
+          N_TIERS
+      };
+
+      /// The default for \c nRandomStarts().
+      static const unsigned DEFAULT_N_RANDOM_STARTS=8;
+
+      /// Constructor
+      /**
+       * \param nData
+       * The size of the maps that will be fit.
+       *
+       * \param team
+       * The threads to run the \c MultiStart tier, and the \c FitGA's
+       * evaluations, on.  If \c 0, both run on the calling thread.  Not
+       * owned by this object.
+       */
+      explicit AdaptiveFit(tslen_t nData, ThreadTeam* team=0)
+          : m__multiStart(nData, team)
+          , m__team(team)
+          , m__theGA()
+          , m__warmIndex(0)
+          , m__maxWarmDistance(0.0)
+          , m__maxReducedChiSq(0.0)
+          , m__nRandomStarts(DEFAULT_N_RANDOM_STARTS)
+          , m__tier(NoTier)
+          , m__status(fortlib::FitLM::InputError)
+          , m__chiSq(0.0)
+          , m__best()
+          , m__nData(nData)
+      {
+          resetCounts();
+      }
+
+      /// Destructor
+      ~AdaptiveFit() {}
+
+      /// The \c MultiStartLM used by the \c MultiStart tier.
+      /**
+       * Its \c adapter(0) runs the LM fits of the other tiers.  Configure
+       * its adapters through \c MultiStartLM::adapter().
+       */
+      MultiStart_t& multiStart()
+      { return m__multiStart; }
+
+      /// Take the starting point of the \c WarmLM tier from \a index.
+      /**
+       * Used whenever \c operator()() gets no starting point.  The closest
+       * entry is only used if its distance from the map being fit is at
+       * most \a maxDistance (see \c WarmStartIndex::nearest()).  Every fit
+       * that succeeds is inserted into \a index.
+       *
+       * The \c WarmStartIndex is not owned by this object.  Pass \c 0 to
+       * stop using it.
+       */
+      void setWarmStartIndex(WarmStartIndex* index, double maxDistance)
+      {
+          m__warmIndex = index;
+          m__maxWarmDistance = maxDistance;
+      }
+
+      /// Set the largest reduced \f$\chi^2\f$ that passes the quality
+      /// gate.
+      /**
+       * A value \<= 0 turns the gate off (the default).
+       */
+      void setMaxReducedChiSq(double maxRedChiSq)
+      { m__maxReducedChiSq = maxRedChiSq; }
+
+      /// The largest reduced \f$\chi^2\f$ that passes the quality gate,
+      /// or \c 0 if it's off.
+      double maxReducedChiSq() const
+      { return (m__maxReducedChiSq > 0.0 ? m__maxReducedChiSq : 0.0); }
+
+      /// Set the number of random starting points of the \c MultiStart
+      /// tier.
+      /**
+       * With \a n == 0, the tier is skipped, unless there's a result from
+       * the \c WarmLM tier to restart.
+       */
+      void setNRandomStarts(unsigned n)
+      { m__nRandomStarts = n; }
+
+      /// The number of random starting points of the \c MultiStart tier.
+      unsigned nRandomStarts() const
+      { return m__nRandomStarts; }
+
+      /// Fit \a theData.
+      /**
+       * \param params
+       * On entry, the starting point of the \c WarmLM tier.  If it's
+       * empty, the \c WarmStartIndex (if any) supplies one instead.  On
+       * return, the best parameters found by any tier.
+       *
+       * \param theData
+       * The map to fit.
+       *
+       * \param factor
+       * As for \c FitLM_BarrierAdapter::operator()().
+       *
+       * \returns The tier that succeeded, or \c NoTier.  In the latter
+       * case, \a params holds the best fit found anyway.
+       */
+      Tier_t operator()(dvector_t& params, const PersistenceMap& theData,
+                        double factor)
+      {
+          m__tier = NoTier;
+          m__status = fortlib::FitLM::InputError;
+          m__chiSq = std::numeric_limits<double>::max();
+          m__best.clear();
+          m__nData = theData.size();
+          Adapter_t& fitter(m__multiStart.adapter(0));
+
+          // Tier 1:  LM from a warm start.
+          if( (params.size() != static_cast<size_t>(N_PARAMETERS)) &&
+              m__warmIndex )
+          {
+              double distance;
+              if( !m__warmIndex->nearest(theData, params, distance) ||
+                  (distance > m__maxWarmDistance) )
+              {
+                  params.clear();
+              }
+          }
+          if(params.size() == static_cast<size_t>(N_PARAMETERS)) {
+              FitStatus_t status = fitter(params, theData, factor);
+              consider(params, status, fitter.chiSquared());
+              if(succeeded(WarmLM)) {
+                  return finish(params, theData);
+              }
+          }
+
+          // Tier 2:  LM from many starting points.
+          m__multiStart.clearStarts();
+          if(!m__best.empty()) {
+              m__multiStart.addStart(m__best);
+          }
+          m__multiStart.addRandomStarts(m__nRandomStarts);
+          if(m__multiStart.nStarts()) {
+              m__multiStart(params, theData, factor);
+              const typename MultiStart_t::StartResult&
+                  result(m__multiStart.results()[bestStart()]);
+              consider(result.params, result.status, result.chiSq);
+              if(succeeded(MultiStart)) {
+                  return finish(params, theData);
+              }
+          }
+
+          // Tier 3:  the GA, polished by LM.
+          if(!m__theGA) {
+              m__theGA.reset(new FitGA_t);
+              m__theGA->setThreadTeam(m__team);
+          }
+          (*m__theGA)(params, theData, fitter.theModel());
+          FitStatus_t status = fitter(params, theData, factor);
+          consider(params, status, fitter.chiSquared());
+          succeeded(GeneticAlgorithm);
+          return finish(params, theData);
+      }
+
+      /// The tier that succeeded in the last call to \c operator()(), or
+      /// \c NoTier.
+      Tier_t tier() const
+      { return m__tier; }
+
+      /// The \c FitStatus_t of the best fit found by the last call to \c
+      /// operator()().
+      FitStatus_t status() const
+      { return m__status; }
+
+      /// \f$\chi^2\f$ of the best fit found by the last call to \c
+      /// operator()().
+      double chiSquared() const
+      { return m__chiSq; }
+
+      /// The number of fits solved by \a tier (or not solved at all, for
+      /// \c NoTier) since the last \c resetCounts().
+      unsigned nSolved(Tier_t tier) const
+      { return m__nSolved[tier]; }
+
+      /// Zeroes the counts returned by \c nSolved().
+      void resetCounts()
+      {
+          for(unsigned t=0; t<N_TIERS; ++t) {
+              m__nSolved[t] = 0;
+          }
+      }
+
+      /// \c true if \a status counts as converged.
+      static bool converged(FitStatus_t status)
+      {
+          return ( (status > fortlib::FitLM::InputError) &&
+                   (status != fortlib::FitLM::IterationOverflow) );
+      }
+
+  private:
+      MultiStart_t m__multiStart;
+      ThreadTeam* m__team;
+      // Only built if it's ever needed.
+      boost::scoped_ptr<FitGA_t> m__theGA;
+      WarmStartIndex* m__warmIndex;
+      double m__maxWarmDistance;
+      double m__maxReducedChiSq;
+      unsigned m__nRandomStarts;
+      unsigned m__nSolved[N_TIERS];
+
+      // The state of the current (or last) fit.
+      Tier_t m__tier;
+      FitStatus_t m__status;
+      double m__chiSq;
+      dvector_t m__best;
+      tslen_t m__nData;
+
+      // Keeps the fit in 'params' if it beats the best so far.  Converged
+      // fits beat unconverged ones.
+      void consider(const dvector_t& params, FitStatus_t status,
+                    double chiSq)
+      {
+          bool better = ( m__best.empty() ||
+                          (converged(status) && !converged(m__status)) ||
+                          ( (converged(status) == converged(m__status)) &&
+                            (chiSq < m__chiSq) ) );
+          if(better) {
+              m__best = params;
+              m__status = status;
+              m__chiSq = chiSq;
+          }
+      }
+
+      // Checks the best fit against the gates, crediting 'tier' if it
+      // passes.
+      bool succeeded(Tier_t tier)
+      {
+          if(!converged(m__status)) {
+              return false;
+          }
+          if(m__maxReducedChiSq > 0.0) {
+              double dof = ( (m__nData > static_cast<tslen_t>(N_PARAMETERS))
+                             ? (m__nData - N_PARAMETERS) : 1 );
+              if(m__chiSq/dof > m__maxReducedChiSq) {
+                  return false;
+              }
+          }
+          m__tier = tier;
+          return true;
+      }
+
+      Tier_t finish(dvector_t& params, const PersistenceMap& theData)
+      {
+          params = m__best;
+          m__best.clear();
+          ++m__nSolved[m__tier];
+          if( m__warmIndex && (m__tier != NoTier) ) {
+              m__warmIndex->insert(theData, params, m__chiSq);
+          }
+          return m__tier;
+      }
+
+      // The start that produced the MultiStartLM's best fit.
+      unsigned bestStart() const
+      {
+          const std::vector<typename MultiStart_t::StartResult>&
+              results(m__multiStart.results());
+          unsigned iBest(0);
+          for(unsigned k=1; k<results.size(); ++k)
+          {
+              bool better = ( (converged(results[k].status) &&
+                               !converged(results[iBest].status)) ||
+                              ( (converged(results[k].status) ==
+                                 converged(results[iBest].status)) &&
+                                (results[k].chiSq < results[iBest].chiSq) ) );
+              if(better) {
+                  iBest = k;
+              }
+          }
+          return iBest;
+      }
+  };
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_AdaptiveFit_H_
+/////////////////////////
+//
+// End
@@ -23,9 +23,11 @@
 #include <cmath>
 #include <vector>
 #include <boost/utility.hpp>
+#include <boost/atomic.hpp>
 #include "FORTTypes.h"
 // For the FitLM::FitFnAction_t enum.
 #include "FitLM.h"
+#include "ParamBounds.h"
 #include "MathTools.h"
 
 
@@ -257,28 +259,43 @@ namespace jpw_nld {
       static const index_t N_PARAMETERS=Policy_t::N_PARAMETERS;
 
       /// Default Constructor
-      explicit BarrierModel(tslen_t nData)
+      /**
+       * \a nData, the size of the maps the model will be used with, is
+       * unused.  The work buffer used by \c chiSquared() is sized to each
+       * map on demand.  (So a model that's only called by a \c FitLM_Adapter
+       * never allocates it at all.)
+       */
+      explicit BarrierModel(tslen_t /*nData*/)
           : m__callcount(0)
-          , m__wrkJac(nData)
-          , m__wrkErrs(nData)
+          , m__wrkJac()
+          , m__wrkErrs()
       {}
 
       /// Accessor fn. for the # of times the model was called.
+      /**
+       * The count is exact even when the model is called from several
+       * threads at once.
+       */
       tslen_t callcount() const {
-          return m__callcount;
+          return m__callcount.load(boost::memory_order_relaxed);
       }
 
       /// Resets to zero the counter that tracks the # of times the model was
       /// called.
       void clearCallcount() {
-          m__callcount = 0;
+          m__callcount.store(0, boost::memory_order_relaxed);
       }
 
       /// The model, C++-style.
+      /**
+       * Fills \a deltas with the residuals at the \c theMap.size() valid
+       * elements of \a theMap, in the order of \c
+       * PersistenceMap::valid_as_1D().
+       */
       void operator()(const PersistenceMap& theMap,
                       dvector_t& fitParams, dvector_t& deltas)
       {
-          calculate<dvector_t>(theMap, fitParams, deltas, m__wrkJac,
+          calculate<dvector_t>(theMap, fitParams, deltas, m__wrkJac, 0,
                                FitLM::ComputeFunction);
       }
 
@@ -288,26 +305,27 @@ namespace jpw_nld {
        * Equivalent to calling running \c jpw_math::chiSquared() on the \a
        * deltas you passed to a call to
        * \c operator()(const PersistenceMap&, dvector_t&, dvector_t&).
+       *
+       * To use this function, you must
+       * <tt>\#include&nbsp;"BarrierModels.tcc"</tt>.
        */
-      double chiSquared(const PersistenceMap& theMap, dvector_t& fitParams)
-      {
-          calculate<dvector_t>(theMap, fitParams, m__wrkErrs, m__wrkJac,
-                               FitLM::ComputeFunction);
-          return jpw_math::chiSquared<dvector_t>(m__wrkErrs);
-      }
+      double chiSquared(const PersistenceMap& theMap, dvector_t& fitParams);
 
       /// The model, in the form required by \c FitLM_Adapter.
       /**
        * Not all of the args are used.
+       *
+       * Re-entrant when \a actionCode is \c FitLM::ComputeFunction, so it
+       * may be used with a multi-threaded finite-difference Jacobian.
        */
       void operator()(int /*neq*/, const PersistenceMap& theMap,
                       int /*nvar*/, fortlib::fort_dvec_t fitParams,
                       fortlib::fort_dvec_t deltas,
                       fortlib::fort_dmat_t fnJacob,
-                      int /*ld_fnJac*/, int actionCode)
+                      int ld_fnJac, int actionCode)
       {
-          calculate<fortlib::fort_dvec_t>(theMap, fitParams,
-                                          deltas, fnJacob, actionCode);
+          calculate<fortlib::fort_dvec_t>(theMap, fitParams, deltas,
+                                          fnJacob, ld_fnJac, actionCode);
       }
 
       /// Fill \a params with "constrained" random values.
@@ -318,14 +336,37 @@ namespace jpw_nld {
        * To use this function, you must
        * <tt>\#include&nbsp;"BarrierModels.tcc"</tt>.  This is done to promote
        * inlining it.
+       *
+       * Uses the \c drand48() pRNG.
        */
       static void randomParams(dvector_t& params);
 
+      /// Fill \a params with "constrained" random values drawn from \a
+      /// rng.
+      /**
+       * As above, but \a rng is a \c jpw_math::statistics::PhiloxRNG (or
+       * anything else with the same \c uniform() and \c range() member
+       * functions).  With the same \a rng, the results are the same as
+       * for the other overload after the same draws from \c drand48().
+       */
+      template<class RNG>
+      static void randomParams(dvector_t& params, RNG& rng);
+
+      /// Fill \a bounds with the natural range of each of the model's
+      /// parameters.
+      /**
+       * \c FitLM_BarrierAdapter passes these to \c FitLM::setBounds().
+       *
+       * To use this function, you must
+       * <tt>\#include&nbsp;"BarrierModels.tcc"</tt>.
+       */
+      static void paramBounds(fortlib::ParamBounds& bounds);
+
       /// Restrict \a params according to their natural ranges.
       /**
        * The model's parameters won't necessarily have infinite range.  This
-       * function takes any parameter that is out of range and readjusts it so
-       * that it remains in-bounds.
+       * function takes any parameter that is out of range and moves it back
+       * into the range given by \c paramBounds().
        *
        * It's not used by any of the member functions in this class [which
        * handles out-of-range values in a different way], but has been
@@ -337,6 +378,21 @@ namespace jpw_nld {
        */
       static void limitParams(dvector_t& params);
 
+      /// Replace \a params with the equivalent set that's unique to each
+      /// model.
+      /**
+       * Several sets of parameters give the same model:  it only uses the
+       * cosine of the amplitude parameter and the squares of the width and
+       * tau.  This function picks the representative with those three in
+       * <tt>[0, pi]</tt>, <tt>[0, inf)</tt> and <tt>[0, inf)</tt>,
+       * respectively, then applies \c limitParams().  Use it to compare the
+       * results of different fits.
+       *
+       * To use this function, you must
+       * <tt>\#include&nbsp;"BarrierModels.tcc"</tt>.
+       */
+      static void canonicalParams(dvector_t& params);
+
       /// Given the "normal" barrier amplitude parameter, returns its rescaled
       /// equivalent.
       /**
@@ -399,7 +455,9 @@ namespace jpw_nld {
       }
 
   protected:
-      tslen_t m__callcount;
+      boost::atomic<tslen_t> m__callcount;
+      // Stands in for the Jacobian when computing the function, which never
+      // touches it.  So it's always empty.
       dvector_t m__wrkJac;
       dvector_t m__wrkErrs;
 
@@ -407,6 +465,10 @@ namespace jpw_nld {
       /**
        * It increments m__callcount every time it's invoked.
        *
+       * Column \c k of the Jacobian starts at <tt>fnJacob[k*ldJacob]</tt>.
+       * \a ldJacob is at least \c theMap.size(), and is unused when
+       * computing the function.
+       *
        * \tparam VT&nbsp;&nbsp;
        * Will be either \c fortlib::fort_dvec_t or \c dvector_t [which is just
        * a \c typedef to <tt>std::vector&lt;double&gt;</tt>].  Don't use any
@@ -447,7 +509,8 @@ namespace jpw_nld {
        */
       template<typename VT>
       void calculate(const PersistenceMap& theMap,
-                     VT& fitParams, VT& deltas, VT& fnJacob, int actionCode);
+                     VT& fitParams, VT& deltas, VT& fnJacob, int ldJacob,
+                     int actionCode);
   };
 
 
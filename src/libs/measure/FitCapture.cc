@@ -0,0 +1,380 @@
+// -*- C++ -*-
+// Implementation of class FitCapture
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+FitCapture_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <cstring>
+#include <fstream>
+#include "FitCapture.h"
+#include "nld_exceptions.h"
+#include "statistics.h"
+#include "WallClock.h"
+
+#include "details/Matrix.tcc"
+
+
+using std::string;
+
+using namespace jpw_nld;
+using namespace jpw_nld::measure;
+
+
+//
+// Static variables
+//
+
+
+// First bytes of a saved capture, and the version of the format.
+static const char FILE_TAG[] = "FitCapture";
+static const unsigned FILE_VERSION = 1;
+
+
+//
+// Typedefs
+//
+
+
+/////////////////////////
+
+//
+// Local Functions
+//
+
+
+namespace {
+
+  template<typename T>
+  inline void writeRaw(std::ostream& ost, const T& val)
+  {
+      ost.write(reinterpret_cast<const char*>(&val), sizeof(T));
+  }
+
+  template<typename T>
+  inline void readRaw(std::istream& ist, T& val)
+  {
+      ist.read(reinterpret_cast<char*>(&val), sizeof(T));
+  }
+
+  void writeVector(std::ostream& ost, const dvector_t& v)
+  {
+      unsigned n(v.size());
+      writeRaw(ost, n);
+      if(n) {
+          ost.write(reinterpret_cast<const char*>(&v[0]),
+                    n*sizeof(double));
+      }
+  }
+
+  void readVector(std::istream& ist, dvector_t& v)
+  {
+      unsigned n(0);
+      readRaw(ist, n);
+      if(!ist) {
+          return;
+      }
+      v.resize(n);
+      if(n) {
+          ist.read(reinterpret_cast<char*>(&v[0]), n*sizeof(double));
+      }
+  }
+
+} // end anon. namespace
+
+
+/////////////////////////
+
+//
+// FitCapture Member Functions
+//
+
+
+FitCapture::FitCapture()
+    : m__fitter(LevenbergMarquardt)
+    , m__nParams(0)
+    , m__theMap(1)
+    , m__startParams()
+    , m__errorTolerance(0.0)
+    , m__paramTolerance(0.0)
+    , m__maxIterations(0)
+    , m__factor(0.0)
+    , m__backend(0)
+    , m__jacobianMode(0)
+    , m__timeBudget(0.0)
+    , m__bounds()
+    , m__populationSize(0)
+    , m__nGenerations(0)
+    , m__nMutate(0)
+    , m__nElite(0)
+    , m__wideXoverWeightX1000(0)
+    , m__stallGenerations(0)
+    , m__meanStallGenerations(0)
+    , m__stallTolerance(0.0)
+    , m__minDiversity(0.0)
+    , m__initialPopulationSize(0)
+    , m__initialSampling(0)
+    , m__rngSeed(0)
+    , m__rngStream(0)
+    , m__status(0)
+    , m__chiSq(0.0)
+    , m__fittedParams()
+    , m__iterations(0)
+    , m__functionEvals(0)
+    , m__seconds(0.0)
+    , m__startTime(0.0)
+{
+    m__randState[0] = m__randState[1] = m__randState[2] = 0;
+}
+
+
+void FitCapture::begin(Fitter_t whichFitter, index_t nParameters,
+                       const dvector_t& params0)
+{
+    m__fitter = whichFitter;
+    m__nParams = nParameters;
+    m__startParams = params0;
+    jpw_math::statistics::save_rand_state(m__randState);
+
+    m__status = 0;
+    m__chiSq = 0.0;
+    m__fittedParams.clear();
+    m__iterations = 0;
+    m__functionEvals = 0;
+    m__seconds = 0.0;
+    m__startTime = wallClock();
+}
+
+
+void FitCapture::finish(int fitStatus, double fitChiSq,
+                        const dvector_t& fitParams,
+                        unsigned nIterations, unsigned nFunctionEvals)
+{
+    m__seconds = wallClock() - m__startTime;
+    m__status = fitStatus;
+    m__chiSq = fitChiSq;
+    m__fittedParams = fitParams;
+    m__iterations = nIterations;
+    m__functionEvals = nFunctionEvals;
+}
+
+
+void FitCapture::recordLMSettings(double errorTolerance,
+                                  double paramTolerance, int maxIterations,
+                                  double factor, int backend,
+                                  int jacobianMode, double timeBudget,
+                                  const fortlib::ParamBounds* theBounds)
+{
+    m__errorTolerance = errorTolerance;
+    m__paramTolerance = paramTolerance;
+    m__maxIterations = maxIterations;
+    m__factor = factor;
+    m__backend = backend;
+    m__jacobianMode = jacobianMode;
+    m__timeBudget = timeBudget;
+    m__bounds = ( theBounds ? *theBounds : fortlib::ParamBounds() );
+}
+
+
+void FitCapture::recordGASettings(unsigned populationSize,
+                                  unsigned nGenerations, unsigned nMutate,
+                                  unsigned nElite,
+                                  unsigned wideXoverWeightX1000)
+{
+    m__populationSize = populationSize;
+    m__nGenerations = nGenerations;
+    m__nMutate = nMutate;
+    m__nElite = nElite;
+    m__wideXoverWeightX1000 = wideXoverWeightX1000;
+}
+
+
+void FitCapture::recordGAStoppingRules(unsigned stallGenerations,
+                                       unsigned meanStallGenerations,
+                                       double stallTolerance,
+                                       double minDiversity)
+{
+    m__stallGenerations = stallGenerations;
+    m__meanStallGenerations = meanStallGenerations;
+    m__stallTolerance = stallTolerance;
+    m__minDiversity = minDiversity;
+}
+
+
+void FitCapture::restoreRandState() const
+{
+    jpw_math::statistics::restore_rand_state(m__randState);
+}
+
+
+void FitCapture::save(const string& filename) const
+{
+    std::ofstream outFile(filename.c_str(),
+                          std::ios::out | std::ios::binary);
+    if(!outFile) {
+        throw FileNotFound("FitCapture::save():  Can't open \""
+                           + filename + "\" for writing.");
+    }
+
+    outFile.write(FILE_TAG, sizeof(FILE_TAG));
+    writeRaw(outFile, FILE_VERSION);
+
+    int fitterCode(m__fitter);
+    writeRaw(outFile, fitterCode);
+    writeRaw(outFile, m__nParams);
+    writeVector(outFile, m__startParams);
+    outFile.write(reinterpret_cast<const char*>(m__randState),
+                  sizeof(m__randState));
+    m__theMap.write(outFile);
+
+    writeRaw(outFile, m__errorTolerance);
+    writeRaw(outFile, m__paramTolerance);
+    writeRaw(outFile, m__maxIterations);
+    writeRaw(outFile, m__factor);
+    writeRaw(outFile, m__backend);
+    writeRaw(outFile, m__jacobianMode);
+    writeRaw(outFile, m__timeBudget);
+    index_t nBounds(m__bounds.size());
+    writeRaw(outFile, nBounds);
+    for(index_t j=0; j<nBounds; ++j) {
+        int kind(m__bounds.kind(j));
+        writeRaw(outFile, kind);
+        writeRaw(outFile, m__bounds.lower(j));
+        writeRaw(outFile, m__bounds.upper(j));
+    }
+
+    writeRaw(outFile, m__populationSize);
+    writeRaw(outFile, m__nGenerations);
+    writeRaw(outFile, m__nMutate);
+    writeRaw(outFile, m__nElite);
+    writeRaw(outFile, m__wideXoverWeightX1000);
+    writeRaw(outFile, m__stallGenerations);
+    writeRaw(outFile, m__meanStallGenerations);
+    writeRaw(outFile, m__stallTolerance);
+    writeRaw(outFile, m__minDiversity);
+    writeRaw(outFile, m__initialPopulationSize);
+    writeRaw(outFile, m__initialSampling);
+    writeRaw(outFile, m__rngSeed);
+    writeRaw(outFile, m__rngStream);
+
+    writeRaw(outFile, m__status);
+    writeRaw(outFile, m__chiSq);
+    writeVector(outFile, m__fittedParams);
+    writeRaw(outFile, m__iterations);
+    writeRaw(outFile, m__functionEvals);
+    writeRaw(outFile, m__seconds);
+
+    if(!outFile) {
+        throw FileNotFound("FitCapture::save():  Error writing \""
+                           + filename + "\".");
+    }
+}
+
+
+void FitCapture::load(const string& filename)
+{
+    std::ifstream inFile(filename.c_str(), std::ios::in | std::ios::binary);
+    if(!inFile) {
+        throw FileNotFound("FitCapture::load():  Can't open \""
+                           + filename + "\".");
+    }
+
+    char tag[sizeof(FILE_TAG)];
+    unsigned version(0);
+    inFile.read(tag, sizeof(tag));
+    readRaw(inFile, version);
+    if( !inFile || std::memcmp(tag, FILE_TAG, sizeof(tag)) ||
+        (version != FILE_VERSION) )
+    {
+        throw InvalidArgError("FitCapture::load():  \"" + filename
+                              + "\" is not a saved FitCapture.");
+    }
+
+    int fitterCode(0);
+    readRaw(inFile, fitterCode);
+    m__fitter = static_cast<Fitter_t>(fitterCode);
+    readRaw(inFile, m__nParams);
+    readVector(inFile, m__startParams);
+    inFile.read(reinterpret_cast<char*>(m__randState),
+                sizeof(m__randState));
+    bool mapOK = (inFile && m__theMap.read(inFile));
+
+    readRaw(inFile, m__errorTolerance);
+    readRaw(inFile, m__paramTolerance);
+    readRaw(inFile, m__maxIterations);
+    readRaw(inFile, m__factor);
+    readRaw(inFile, m__backend);
+    readRaw(inFile, m__jacobianMode);
+    readRaw(inFile, m__timeBudget);
+    index_t nBounds(0);
+    readRaw(inFile, nBounds);
+    m__bounds = fortlib::ParamBounds(inFile ? nBounds : 0);
+    for(index_t j=0; inFile && (j<nBounds); ++j)
+    {
+        int kind(0);
+        double lower(0.0), upper(0.0);
+        readRaw(inFile, kind);
+        readRaw(inFile, lower);
+        readRaw(inFile, upper);
+        switch(kind)
+        {
+        case fortlib::ParamBounds::Bounded:
+            m__bounds.setRange(j, lower, upper);
+            break;
+        case fortlib::ParamBounds::Periodic:
+            m__bounds.setPeriodic(j, lower, upper - lower);
+            break;
+        case fortlib::ParamBounds::Reflected:
+            m__bounds.setReflected(j, lower, upper);
+            break;
+        default:
+            m__bounds.setUnbounded(j);
+            break;
+        }
+    }
+
+    readRaw(inFile, m__populationSize);
+    readRaw(inFile, m__nGenerations);
+    readRaw(inFile, m__nMutate);
+    readRaw(inFile, m__nElite);
+    readRaw(inFile, m__wideXoverWeightX1000);
+    readRaw(inFile, m__stallGenerations);
+    readRaw(inFile, m__meanStallGenerations);
+    readRaw(inFile, m__stallTolerance);
+    readRaw(inFile, m__minDiversity);
+    readRaw(inFile, m__initialPopulationSize);
+    readRaw(inFile, m__initialSampling);
+    readRaw(inFile, m__rngSeed);
+    readRaw(inFile, m__rngStream);
+
+    readRaw(inFile, m__status);
+    readRaw(inFile, m__chiSq);
+    readVector(inFile, m__fittedParams);
+    readRaw(inFile, m__iterations);
+    readRaw(inFile, m__functionEvals);
+    readRaw(inFile, m__seconds);
+
+    if(!inFile || !mapOK) {
+        throw InvalidArgError("FitCapture::load():  \"" + filename
+                              + "\" is truncated.");
+    }
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,333 @@
+// -*- C++ -*-
+// Header file for class FitCapture
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _FitCapture_H_
+#define _FitCapture_H_
+
+// Includes
+//
+#include <string>
+#include "jpw_nld.h"
+#include "ParamBounds.h"
+#include "PersistenceMap.h"
+#include "PhiloxRNG.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace measure {
+
+
+  // Class FitCapture
+  /**
+   * Everything needed to rerun one fit of a \c PersistenceMap offline:
+   * the map itself, the starting parameters, the state of the pRNGs, and
+   * the fitter's settings.  It also holds the fit's outcome and
+   * wall-clock time, for comparison with the rerun.
+   *
+   * Capturing is opt-in.  Register a \c FitCapture with \c
+   * FitLM_BarrierAdapter::setCapture() or \c optimize::FitGA::setCapture(),
+   * and each fit overwrites it.  Since the time is recorded, a caller can
+   * keep only the slow fits:
+   * \code
+   *   measure::FitCapture capture;
+   *   fitter.setCapture(&capture);
+   *   status = fitter(params, theMap, factor);
+   *   if(capture.seconds() > tooSlow) {
+   *       capture.save(someUniqueFilename);
+   *   }
+   * \endcode
+   *
+   * \c save() writes a compact binary file, in the machine's byte order.
+   * The \c fitreplay program in \c utests/fitbench reruns it.
+   */
+  class FitCapture
+  {
+  public:
+      /// The fitter that was captured.
+      enum Fitter_t {
+          LevenbergMarquardt=1,
+          GeneticAlgorithm=2
+      };
+
+      /// Default Constructor
+      /**
+       * Until the first fit, \c theMap is a 1x1 map and the other members
+       * are zeroed.
+       */
+      FitCapture();
+
+      /// Destructor
+      ~FitCapture() {}
+
+      /// Starts a capture.
+      /**
+       * Called by the fitter before it begins.  Records the arguments and
+       * the state of the \c drand48() pRNG, clears the outcome and starts
+       * the clock.
+       *
+       * \param nParameters
+       * The \c N_PARAMETERS of the \c BarrierModel being fit.  It
+       * identifies the model's policy class.
+       */
+      void begin(Fitter_t whichFitter, index_t nParameters,
+                 const dvector_t& params0);
+
+      /// Records the map being fit.
+      void recordData(const PersistenceMap& data)
+      { m__theMap = data; }
+
+      /// Fallback for fitters of other data types; records nothing.
+      template<class D>
+      void recordData(const D&) {}
+
+      /// Records the settings of a Levenberg-Marquardt fit.
+      /**
+       * \param theBounds
+       * \c 0 if the fit was unbounded.
+       */
+      void recordLMSettings(double errorTolerance, double paramTolerance,
+                            int maxIterations, double factor, int backend,
+                            int jacobianMode, double timeBudget,
+                            const fortlib::ParamBounds* theBounds);
+
+      /// Records the sizes of a \c FitGA run.
+      void recordGASettings(unsigned populationSize, unsigned nGenerations,
+                            unsigned nMutate, unsigned nElite,
+                            unsigned wideXoverWeightX1000);
+
+      /// Records the stopping rules of a \c FitGA run.
+      void recordGAStoppingRules(unsigned stallGenerations,
+                                 unsigned meanStallGenerations,
+                                 double stallTolerance, double minDiversity);
+
+      /// Records how a \c FitGA run drew its initial population.
+      void recordGAInitialPopulation(unsigned initialPopulationSize,
+                                     unsigned initialSampling)
+      {
+          m__initialPopulationSize = initialPopulationSize;
+          m__initialSampling = initialSampling;
+      }
+
+      /// Records the \c PhiloxRNG a \c FitGA run used.
+      void recordRandomStream(jpw_math::statistics::PhiloxRNG::seed_t seed,
+                              jpw_math::statistics::PhiloxRNG::seed_t stream)
+      {
+          m__rngSeed = seed;
+          m__rngStream = stream;
+      }
+
+      /// Finishes a capture.
+      /**
+       * Called by the fitter once it's done.  Records the outcome and the
+       * wall-clock time since \c begin().
+       */
+      void finish(int fitStatus, double fitChiSq,
+                  const dvector_t& fitParams,
+                  unsigned nIterations, unsigned nFunctionEvals);
+
+      /// Puts the \c drand48() pRNG back into its state at \c begin().
+      void restoreRandState() const;
+
+      /// Write the capture to \a filename, replacing its contents.
+      /**
+       * \throws FileNotFound if \a filename can't be opened.
+       */
+      void save(const std::string& filename) const;
+
+      /// Replace the contents of this object with those of \a filename.
+      /**
+       * \throws FileNotFound if \a filename can't be opened.
+       * \throws InvalidArgError if \a filename isn't a saved capture (or
+       * was saved on a machine with a different byte order), or is
+       * truncated.
+       */
+      void load(const std::string& filename);
+
+      /// \name Inputs
+      /// @{
+      Fitter_t fitter() const
+      { return m__fitter; }
+
+      /// The \c N_PARAMETERS of the \c BarrierModel.
+      index_t nParams() const
+      { return m__nParams; }
+
+      const PersistenceMap& theMap() const
+      { return m__theMap; }
+
+      const dvector_t& startParams() const
+      { return m__startParams; }
+
+      /// See \c jpw_math::statistics::save_rand_state().
+      const unsigned short* randState() const
+      { return m__randState; }
+      /// @}
+
+      /// \name Levenberg-Marquardt Settings
+      /// Arguments of \c FitLM_Adapter::operator(), plus the fitter's
+      /// state.  Zero when \c fitter() is \c GeneticAlgorithm.
+      /// @{
+      double errorTolerance() const
+      { return m__errorTolerance; }
+
+      double paramTolerance() const
+      { return m__paramTolerance; }
+
+      int maxIterations() const
+      { return m__maxIterations; }
+
+      double factor() const
+      { return m__factor; }
+
+      /// A \c FitLM::Backend_t.
+      int backend() const
+      { return m__backend; }
+
+      /// A \c FitLM::JacobianMode_t.
+      int jacobianMode() const
+      { return m__jacobianMode; }
+
+      /// The \c FitControl::timeBudget(); \c 0 if there was none.
+      double timeBudget() const
+      { return m__timeBudget; }
+
+      /// Empty if the fit was unbounded.
+      const fortlib::ParamBounds& bounds() const
+      { return m__bounds; }
+      /// @}
+
+      /// \name Genetic Algorithm Settings
+      /// The \c FitGA runtime settings, template arguments and stopping
+      /// rules.  Zero when \c fitter() is \c LevenbergMarquardt.
+      /// @{
+      unsigned populationSize() const
+      { return m__populationSize; }
+
+      unsigned nGenerations() const
+      { return m__nGenerations; }
+
+      unsigned nMutate() const
+      { return m__nMutate; }
+
+      unsigned nElite() const
+      { return m__nElite; }
+
+      unsigned wideXoverWeightX1000() const
+      { return m__wideXoverWeightX1000; }
+
+      unsigned stallGenerations() const
+      { return m__stallGenerations; }
+
+      unsigned meanStallGenerations() const
+      { return m__meanStallGenerations; }
+
+      double stallTolerance() const
+      { return m__stallTolerance; }
+
+      double minDiversity() const
+      { return m__minDiversity; }
+
+      unsigned initialPopulationSize() const
+      { return m__initialPopulationSize; }
+
+      /// A \c jpw_math::statistics::QuasiRandomSet::Method_t.
+      unsigned initialSampling() const
+      { return m__initialSampling; }
+
+      /// The seed of the \c PhiloxRNG the \c FitGA used.
+      jpw_math::statistics::PhiloxRNG::seed_t rngSeed() const
+      { return m__rngSeed; }
+
+      /// The stream of the \c PhiloxRNG the \c FitGA used.
+      jpw_math::statistics::PhiloxRNG::seed_t rngStream() const
+      { return m__rngStream; }
+      /// @}
+
+      /// \name Outcome
+      /// @{
+      /// A \c FitLM::FitStatus_t, or the \c FitGA::StopReason_t.
+      int status() const
+      { return m__status; }
+
+      double chiSq() const
+      { return m__chiSq; }
+
+      const dvector_t& fittedParams() const
+      { return m__fittedParams; }
+
+      /// LM iterations or GA generations.
+      unsigned iterations() const
+      { return m__iterations; }
+
+      unsigned functionEvals() const
+      { return m__functionEvals; }
+
+      double seconds() const
+      { return m__seconds; }
+      /// @}
+
+  private:
+      Fitter_t m__fitter;
+      index_t m__nParams;
+      PersistenceMap m__theMap;
+      dvector_t m__startParams;
+      unsigned short m__randState[3];
+
+      double m__errorTolerance;
+      double m__paramTolerance;
+      int m__maxIterations;
+      double m__factor;
+      int m__backend;
+      int m__jacobianMode;
+      double m__timeBudget;
+      fortlib::ParamBounds m__bounds;
+
+      unsigned m__populationSize;
+      unsigned m__nGenerations;
+      unsigned m__nMutate;
+      unsigned m__nElite;
+      unsigned m__wideXoverWeightX1000;
+      unsigned m__stallGenerations;
+      unsigned m__meanStallGenerations;
+      double m__stallTolerance;
+      double m__minDiversity;
+      unsigned m__initialPopulationSize;
+      unsigned m__initialSampling;
+      jpw_math::statistics::PhiloxRNG::seed_t m__rngSeed;
+      jpw_math::statistics::PhiloxRNG::seed_t m__rngStream;
+
+      int m__status;
+      double m__chiSq;
+      dvector_t m__fittedParams;
+      unsigned m__iterations;
+      unsigned m__functionEvals;
+      double m__seconds;
+
+      double m__startTime;
+  };
+
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_FitCapture_H_
+/////////////////////////
+//
+// End
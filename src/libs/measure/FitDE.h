@@ -0,0 +1,345 @@
+// -*- C++ -*-
+// Header file for template class FitDE
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _FitDE_H_
+#define _FitDE_H_
+
+// Includes
+//
+#include <algorithm>
+#include <boost/utility.hpp>
+#include "jpw_nld.h"
+#include "Vector_fwd.h"
+#include "ThreadTeam.h"
+#include "ThreadModels.h"
+#include "PhiloxRNG.h"
+#include "QuasiRandom.h"
+#include "FitControl.h"  // for 'FitControl::ProgressMonitor'
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace optimize {
+  // Using decls.
+  //
+  using std::vector;
+  using jpw_math::dvector_t;
+  using jpw_math::statistics::PhiloxRNG;
+  using jpw_math::statistics::QuasiRandomSet;
+
+
+  // Class FitDE
+  /**
+   * Optimize a function via Differential Evolution:  Storn & Price,
+   * "Differential Evolution - A Simple and Efficient Heuristic for Global
+   * Optimization over Continuous Spaces", J. Global Optim. 11, 341
+   * (1997).
+   *
+   * Each generation, every member \f$x_i\f$ of the population competes
+   * with a trial vector.  The trial takes each parameter either from
+   * \f$x_i\f$ or, with probability \c crossover() (and for at least one
+   * parameter), from a mutant made of other members:
+   * - \c Rand1:  \f$x_{r1} + F (x_{r2} - x_{r3})\f$
+   * - \c Best1:  \f$x_{best} + F (x_{r1} - x_{r2})\f$
+   * - \c CurrentToBest1:  \f$x_i + F (x_{best} - x_i) + F (x_{r1} -
+   *   x_{r2})\f$
+   *
+   * where \f$F\f$ is the \c weight(), and the \f$r_n\f$ are distinct
+   * random members other than \f$i\f$.  The trial replaces \f$x_i\f$ if
+   * its \f$\chi^2\f$ is no worse.  Since the differences between members
+   * shrink as the population converges, so do the steps; no step size
+   * needs tuning.
+   *
+   * \a FIT_FN has the same requirements as for \c FitGA, so the two are
+   * interchangeable.  \c limitParams() brings each trial back into range.
+   *
+   * All trials of a generation are made from the same population, then
+   * evaluated as one batch, on the \c ThreadTeam if there is one.  The
+   * random numbers come from \c PhiloxRNG streams, one per member per
+   * generation, as with \c FitGA.  So a threaded run gives the same result
+   * as a serial one with the same seed.
+   *
+   * A \c fortlib::FitControl::ProgressMonitor registered with \c
+   * setProgressMonitor() sees the best member after each generation, and
+   * may stop the minimization.  There is no \c FitCapture support.
+   *
+   * Translation units using this class should also
+   * <tt>\#include&nbsp;"details/FitDE.tcc"</tt>, and for the barrier
+   * models, \c "BarrierModels.h" and \c "details/BarrierModels.tcc".
+   */
+  template<class FIT_FN, class DATA_T>
+  class FitDE : private boost::noncopyable
+  {
+  public:
+      typedef FIT_FN Model_t;
+      typedef DATA_T FitData_t;
+
+      static const index_t N_PARAMETERS=Model_t::N_PARAMETERS;
+      /// The default \c populationSize():  10 members per parameter.
+      static const unsigned DEFAULT_POPULATION_SIZE=10*N_PARAMETERS;
+      /// The default \c nGenerations().
+      static const unsigned DEFAULT_N_GENERATIONS=100;
+      /// The default \c weight().
+      static const double DEFAULT_WEIGHT;
+      /// The default \c crossover().
+      static const double DEFAULT_CROSSOVER;
+
+      /// How the mutant of each trial is made.
+      enum Strategy_t { Rand1=0, Best1, CurrentToBest1, N_STRATEGIES };
+
+      /// A short, printable name for \a strategy.
+      static const char* strategyName(Strategy_t strategy);
+
+      /// Default Constructor
+      FitDE()
+          : m__pop()
+          , m__trials()
+          , m__chiPop()
+          , m__chiTrials()
+          , m__wrkParams(N_PARAMETERS)
+          , m__popSize(DEFAULT_POPULATION_SIZE)
+          , m__nGenerations(DEFAULT_N_GENERATIONS)
+          , m__weight(DEFAULT_WEIGHT)
+          , m__crossover(DEFAULT_CROSSOVER)
+          , m__strategy(Rand1)
+          , m__initialSampling(QuasiRandomSet::PseudoRandom)
+          , m__initialSet()
+          , m__functionEvals(0)
+          , m__generations(0)
+          , m__monitor(0)
+          , m__team(0)
+          , m__threadModels()
+          , m__threadParams()
+          , m__rng()
+          , m__hasRandomStream(false)
+      {}
+
+      /// Destructor
+      ~FitDE() {}
+
+      /// Performs the minimization.
+      /**
+       * Returns the value of \f$\chi^2\f$ for the minimized parameters,
+       * and sets \a param_min to them.  The initial value of \a param_min
+       * isn't used.
+       *
+       * Throws an \c InvalidArgError if the runtime settings are
+       * inconsistent; see \c setPopulationSize().
+       */
+      double operator()(dvector_t& param_min, const FitData_t& theData,
+                        Model_t& theModel);
+
+      /// \name Runtime Settings
+      /// Each takes effect at the next \c operator().
+      /// @{
+
+      /// Set the number of members, at least 4.
+      void setPopulationSize(unsigned n)
+      { m__popSize = n; }
+
+      /// The number of members.
+      unsigned populationSize() const
+      { return m__popSize; }
+
+      /// Set the maximum number of generations, at least 1.
+      void setNGenerations(unsigned n)
+      { m__nGenerations = n; }
+
+      /// The maximum number of generations.
+      unsigned nGenerations() const
+      { return m__nGenerations; }
+
+      /// Set the weight, \f$F\f$, of the differences in each mutant.
+      /**
+       * Usually in (0.4, 1].  Smaller weights converge faster, but more
+       * often to the wrong minimum.
+       */
+      void setWeight(double f)
+      { m__weight = f; }
+
+      /// The weight of the differences in each mutant.
+      double weight() const
+      { return m__weight; }
+
+      /// Set the probability that a trial takes each parameter from the
+      /// mutant.
+      void setCrossover(double cr)
+      { m__crossover = cr; }
+
+      /// The probability that a trial takes each parameter from the
+      /// mutant.
+      double crossover() const
+      { return m__crossover; }
+
+      /// Set how the mutants are made.
+      /**
+       * The default, \c Rand1, is the slowest but the least likely to
+       * converge on the wrong minimum.
+       */
+      void setStrategy(Strategy_t strategy)
+      { m__strategy = strategy; }
+
+      /// How the mutants are made.
+      Strategy_t strategy() const
+      { return m__strategy; }
+
+      /// Set how the initial population is drawn, as for \c
+      /// FitGA::setInitialSampling().
+      void setInitialSampling(QuasiRandomSet::Method_t method)
+      { m__initialSampling = method; }
+
+      /// How the initial population is drawn.
+      QuasiRandomSet::Method_t initialSampling() const
+      { return m__initialSampling; }
+
+      /// @}
+
+      /// Follow the minimization with \a monitor.
+      /**
+       * \a monitor is called after each generation, with the number of
+       * generations so far and the best member.  If it returns \c
+       * false, the minimization stops.
+       *
+       * The \c ProgressMonitor is not owned by this object.
+       */
+      void setProgressMonitor(fortlib::FitControl::ProgressMonitor* monitor)
+      { m__monitor = monitor; }
+
+      /// Evaluate each generation's trials on the threads of \a team.
+      /**
+       * Pass \c 0 to evaluate them serially, on the calling thread (the
+       * default).  The \c ThreadTeam is not owned by this object.
+       * Thread \c 0 uses the model passed to \c operator(), and each of
+       * the others its own \a FIT_FN instance.
+       */
+      void setThreadTeam(ThreadTeam* team)
+      { m__team = team; }
+
+      /// The current \c ThreadTeam, or \c 0.
+      ThreadTeam* threadTeam() const
+      { return m__team; }
+
+      /// Draw the random numbers from \a rng, instead of from \c drand48().
+      /**
+       * As for \c FitGA::setRandomStream().
+       */
+      void setRandomStream(const PhiloxRNG& rng)
+      {
+          m__rng = rng;
+          m__hasRandomStream = true;
+      }
+
+      /// Go back to seeding each minimization from \c drand48() (the
+      /// default).
+      void clearRandomStream()
+      { m__hasRandomStream = false; }
+
+      /// The number of \f$\chi^2\f$ evaluations made by the last run of
+      /// \c operator().
+      unsigned functionEvals() const
+      { return m__functionEvals; }
+
+      /// The number of generations run by the last run of \c operator().
+      unsigned generations() const
+      { return m__generations; }
+
+  protected:
+      /// Draws and evaluates the initial population from \a rng.
+      void initializePopulation(const FitData_t& theData,
+                                Model_t& theModel, const PhiloxRNG& rng);
+
+      /// Makes the trial of each member, from this generation's stream,
+      /// \a rng.
+      void makeTrials(unsigned best, const PhiloxRNG& rng);
+
+      /// Sets \a chiSq[i] to the \f$\chi^2\f$ of row \c i of \a rows,
+      /// for each of the \c populationSize() rows.
+      /**
+       * Runs on the \c ThreadTeam, if there is one.
+       */
+      void evaluate(const dvector_t& rows, dvector_t& chiSq,
+                    const FitData_t& theData, Model_t& theModel);
+
+      /// The index of the member with the lowest \f$\chi^2\f$.
+      unsigned bestMember() const;
+
+  private:
+      // The population and the trials, each one contiguous, row-major
+      // matrix of parameters.
+      dvector_t m__pop;
+      dvector_t m__trials;
+      dvector_t m__chiPop;
+      dvector_t m__chiTrials;
+      dvector_t m__wrkParams;
+      // The runtime settings.
+      unsigned m__popSize;
+      unsigned m__nGenerations;
+      double m__weight;
+      double m__crossover;
+      Strategy_t m__strategy;
+      QuasiRandomSet::Method_t m__initialSampling;
+      QuasiRandomSet m__initialSet;
+      unsigned m__functionEvals;
+      unsigned m__generations;
+      fortlib::FitControl::ProgressMonitor* m__monitor;
+      ThreadTeam* m__team;
+      // The model and parameter vector used by each thread.
+      ThreadModels<Model_t> m__threadModels;
+      vector<dvector_t> m__threadParams;
+      PhiloxRNG m__rng;
+      bool m__hasRandomStream;
+
+      /// Evaluates one row per task.
+      struct EvalTask : public ThreadTeam::Task
+      {
+          EvalTask(const ThreadModels<Model_t>& models,
+                   vector<dvector_t>& threadParams,
+                   const FitData_t& theData, const dvector_t& rows,
+                   dvector_t& chiSq)
+              : m__models(models)
+              , m__params(threadParams)
+              , m__data(theData)
+              , m__rows(rows)
+              , m__chiSq(chiSq)
+          {}
+
+          void operator()(unsigned i, unsigned iThread)
+          {
+              const double* row(&m__rows[i*N_PARAMETERS]);
+              std::copy(row, row+N_PARAMETERS, m__params[iThread].begin());
+              m__chiSq[i] = m__models.model(iThread).chiSquared(
+                  m__data, m__params[iThread]);
+          }
+
+          const ThreadModels<Model_t>& m__models;
+          vector<dvector_t>& m__params;
+          const FitData_t& m__data;
+          const dvector_t& m__rows;
+          dvector_t& m__chiSq;
+      };
+  };
+
+
+ }; //end namespace optimize
+}; //end namespace jpw_nld
+
+
+#endif //_FitDE_H_
+/////////////////////////
+//
+// End
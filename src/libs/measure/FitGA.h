@@ -30,17 +30,13 @@
 #include <boost/utility.hpp>
 #include "jpw_nld.h"
 #include "Vector_fwd.h"
+#include "ThreadTeam.h"
+#include "ThreadModels.h"
+#include "PhiloxRNG.h"
+#include "QuasiRandom.h"
 #include "statistics.h"  // for 'init_rand()'
-
-
-// Forward Declarations
-// Requires <vector> or "Vector_fwd.h"
-//
-namespace jpw_nld {
- namespace fortlib {
-  typedef std::vector<int, std::allocator<int> > ivector_t;
- };
-};
+#include "FitControl.h"  // for 'FitControl::ProgressMonitor'
+#include "FitCapture.h"
 
 
 // Enclosing namespace
@@ -51,6 +47,41 @@ namespace jpw_nld {
   //
   using std::vector;
   using jpw_math::dvector_t;
+  using jpw_math::statistics::PhiloxRNG;
+  using jpw_math::statistics::QuasiRandomSet;
+
+
+  // Class LocalSearch
+  /**
+   * Interface for the local minimizer used by a memetic \c FitGA.
+   *
+   * Implement \c operator() in a subclass, and register an instance with \c
+   * FitGA::setLocalSearch().  \c measure::LMPolish is the implementation
+   * for the barrier models.
+   */
+  template<class DATA_T>
+  struct LocalSearch
+  {
+      virtual ~LocalSearch() {}
+
+      /// Refines \a params, starting from a \f$\chi^2\f$ of \a chiSq.
+      /**
+       * Replaces \a params with the refined parameters, and returns their
+       * \f$\chi^2\f$.  If the search can't improve on \a params, it must
+       * leave them unchanged and return \a chiSq.
+       */
+      virtual double operator()(dvector_t& params, double chiSq,
+                                const DATA_T& theData) = 0;
+
+      /// The number of \f$\chi^2\f$ evaluations made by the last call to
+      /// \c operator().
+      virtual unsigned functionEvals() const = 0;
+
+      /// The number of Jacobians computed by the last call to \c
+      /// operator().
+      virtual unsigned jacobianEvals() const
+      { return 0; }
+  };
 
 
   // Class FitGA
@@ -68,12 +99,14 @@ namespace jpw_nld {
    *   \n
    *   Compute and return the \f$\chi^2\f$ error between the data and your
    *   function, evaluated at the parameters \a params.
-   * - <tt>static void randomParams(dvector_t\& params)</tt>
+   * - <tt>template\<class RNG\>
+   *   static void randomParams(dvector_t\& params, RNG\& rng)</tt>
    *   \n
    *   Fill the \c dvector_t with "constrained" random values, based on the
    *   model.  The "constrained" random values should be uniformly distributed
    *   over a range sensible for each parameter.  (E.g. if parameter \#2 can't
-   *   be smaller than -3, don't use an aribtrary random number.)
+   *   be smaller than -3, don't use an aribtrary random number.)  Draw them
+   *   from \a rng, a \c PhiloxRNG, and nothing else.
    * - <tt>static void limitParams(dvector_t\& params)</tt>
    *   \n
    *   Make sure that the parameters in the \c dvector_t aren't out of range.
@@ -81,14 +114,70 @@ namespace jpw_nld {
    *   \n
    *   If the parameters in your function have no bounds, just define this
    *   with an empty body.
+   * - <tt>explicit FIT_FN(tslen_t nData)</tt>
+   *   \n
+   *   A constructor taking the size of the data.  Used to create the
+   *   extra, per-thread instances described below.
    *
    * You'll notice that the \a FIT_FN class doesn't need to provide the
    * function itself.  This is by design, permitting \a FIT_FN to be
    * compatible with the FORTRAN-based Levenberg-Marquardt minimizer,
    * \c FitLM.
    *
-   * This class makes use of the \c drand48() pRNG.  Call
-   * jpw_math::statistics::init_rand() before using this class.
+   * Every random number comes from a \c PhiloxRNG.  Each generation, and
+   * each crossover and mutation within it, draws from its own stream, split
+   * off from the one passed to \c setRandomStream().  Without one, each
+   * call to \c operator() seeds a new stream from the \c drand48() pRNG,
+   * so call jpw_math::statistics::init_rand() before using this class.
+   * Either way, nothing else shares the GA's pRNG state; concurrent GAs
+   * (each with its own \c FitGA object) don't change each other's results.
+   *
+   * Register a \c fortlib::FitControl::ProgressMonitor with \c
+   * setProgressMonitor() to follow (or stop) the minimization one
+   * generation at a time, and a \c measure::FitCapture with \c
+   * setCapture() to record it for an offline replay.
+   *
+   * The population is one contiguous matrix of parameters.  Selection
+   * permutes its rows' indices, and the children of crossover replace the
+   * rows of the members not selected.  Nothing is allocated per
+   * generation.
+   *
+   * Each generation only evaluates \f$\chi^2\f$ for the members that
+   * changed:  the children of crossover, and the mutants.  The survivors
+   * copied from the previous generation keep their \f$\chi^2\f$.
+   *
+   * The template arguments \a POPULATION_SIZE, \a N_GENERATIONS, \a
+   * N_MUTATE and \a N_ELITE are only defaults; \c setPopulationSize(), \c
+   * setNGenerations(), \c setNMutate() and \c setNElite() change them at
+   * run time.
+   *
+   * The minimization runs for \c nGenerations() generations, unless the
+   * \c ProgressMonitor or a stopping rule ends it sooner.  There are three
+   * stopping rules, all off by default:  the best \f$\chi^2\f$ stops
+   * improving (\c setStallGenerations()), the mean \f$\chi^2\f$ stops
+   * improving (\c setMeanStallGenerations()), or the population converges
+   * (\c setMinDiversity()).  \c stopReason() says which one ended the last
+   * minimization.
+   *
+   * The initial population is \c initialPopulationSize() random members,
+   * of which the \c populationSize() best survive.  Call \c
+   * setInitialSampling() to spread them evenly over parameter space, as a
+   * Sobol, Halton or Latin hypercube set, rather than independently.
+   * Each point goes through the model's \c randomParams(), so it gets the
+   * same scaling as a pseudo-random member.  An even set often needs fewer
+   * members for an equally good start; see \c setInitialPopulationSize().
+   *
+   * Call \c setLocalSearch() to make the GA memetic:  every few
+   * generations, a local minimizer refines the \c nElite() best members,
+   * and the refined parameters replace them in the population.
+   *
+   * Call \c setThreadTeam() to evaluate \f$\chi^2\f$ for each generation
+   * in parallel.  Thread \c 0 uses the model passed to \c operator(), and
+   * each of the others its own \a FIT_FN instance, so \c chiSquared()
+   * needn't be re-entrant.  The pRNG is only used serially, so the result
+   * is identical to that of a serial run with the same seed.  [N.B.:  Only
+   * the evaluations made on thread \c 0 show up in bookkeeping kept by the
+   * model passed to \c operator(), e.g. \c BarrierModel::callcount().]
    */
   template<class FIT_FN,
            class DATA_T,
@@ -99,24 +188,19 @@ namespace jpw_nld {
            unsigned WIDE_XOVER_WEIGHT_X_1000=1490>
   class FitGA : private boost::noncopyable
   {
-      // Forward Decl.
-      class PopVecFiller;
-
   public:
       typedef FIT_FN Model_t;
       typedef DATA_T FitData_t;
       typedef vector<dvector_t> popVec_t;
+      typedef LocalSearch<DATA_T> LocalSearch_t;
 
       static const index_t N_PARAMETERS=Model_t::N_PARAMETERS;
-      /// The size of the initial population.
+      /// The default \c initialPopulationSize(), for the default \c
+      /// populationSize().
       /// It's larger than our working size to give us a good group from which
       /// to select some highly-fit initial members.
       static const
-      unsigned INITIAL_POPULATION_SIZE=(5*POPULATION_SIZE);
-      static const unsigned N_NONELITE=(POPULATION_SIZE-N_ELITE);
-      /// This used to be tunable, but changing it didn't have much effect.
-      /// So, it's now fixed at 50% of the population.
-      static const unsigned N_BREEDING=(POPULATION_SIZE/2);
+      unsigned DEFAULT_INITIAL_POPULATION_SIZE=(5*POPULATION_SIZE);
       /// Widened crossover weight
       /**
        * After about 10 generations, we start to get convergence \<==\>
@@ -124,20 +208,81 @@ namespace jpw_nld {
        * crossover, a weight which should be in the interval [1.0,1.5].
        */
       static const double WIDE_XOVER_WEIGHT;
+      /// The default interval passed to \c setLocalSearch().
+      static const unsigned DEFAULT_LOCAL_SEARCH_INTERVAL=5;
+      /// The default for \c stallTolerance().
+      static const double DEFAULT_STALL_TOLERANCE;
+
+      /// Why a minimization stopped.
+      enum StopReason_t {
+          /// It ran for \c nGenerations() generations.
+          MaxGenerations=0,
+          /// The \c ProgressMonitor stopped it.
+          MonitorStopped,
+          /// The best \f$\chi^2\f$ stopped improving.
+          BestStalled,
+          /// The mean \f$\chi^2\f$ stopped improving.
+          MeanStalled,
+          /// The population converged.
+          DiversityCollapsed,
+          N_STOP_REASONS
+      };
+
+      /// A short, printable name for \a reason.
+      static const char* stopReasonName(StopReason_t reason);
 
       /// Default Constructor
       FitGA()
-          : m__blankParamVec(N_PARAMETERS, 0.0)
-          , m__wrkPop0(INITIAL_POPULATION_SIZE, m__blankParamVec)
-          , m__wrkChiPop0(INITIAL_POPULATION_SIZE)
+          : m__wrkPop0(DEFAULT_INITIAL_POPULATION_SIZE)
+          , m__wrkChiPop0(DEFAULT_INITIAL_POPULATION_SIZE)
+          , m__wrkParams(N_PARAMETERS)
           , m__wrkMutantDNA(N_PARAMETERS)
-          , m__wrkSortPop0(INITIAL_POPULATION_SIZE)
+          , m__wrkChild1(N_PARAMETERS)
+          , m__wrkChild2(N_PARAMETERS)
+          , m__wrkSortPop0(DEFAULT_INITIAL_POPULATION_SIZE)
           , m__wrkSortChiSq(POPULATION_SIZE)
-          , m__LastParamPop(POPULATION_SIZE+2L, m__blankParamVec)
-          , m__NextParamPop(POPULATION_SIZE+2L, m__blankParamVec)
+          , m__wrkOrder(POPULATION_SIZE)
+          , m__wrkRanks(POPULATION_SIZE)
+          , m__wrkGene(DEFAULT_INITIAL_POPULATION_SIZE)
+          , m__population(POPULATION_SIZE)
           , m__ChiPop(POPULATION_SIZE)
+          , m__NextChiPop(POPULATION_SIZE)
           , m__ChiRating(POPULATION_SIZE)
-          , m__zeroingFunctor()
+          , m__isStale(POPULATION_SIZE, false)
+          , m__staleIndex()
+          , m__popSize(POPULATION_SIZE)
+          , m__nGenerations(N_GENERATIONS)
+          , m__nMutate(N_MUTATE)
+          , m__nElite(N_ELITE)
+          , m__stallGenerations(0)
+          , m__meanStallGenerations(0)
+          , m__stallTolerance(DEFAULT_STALL_TOLERANCE)
+          , m__minDiversity(0.0)
+          , m__initialPopSize(0)
+          , m__initialSampling(QuasiRandomSet::PseudoRandom)
+          , m__initialSet()
+          , m__diversityScale(N_PARAMETERS, 0.0)
+          , m__diversity(1.0)
+          , m__bestRef(0.0)
+          , m__meanRef(0.0)
+          , m__bestImproved(0)
+          , m__meanImproved(0)
+          , m__stopReason(MaxGenerations)
+          , m__functionEvals(0)
+          , m__localSearch(0)
+          , m__localSearchInterval(DEFAULT_LOCAL_SEARCH_INTERVAL)
+          , m__localSearchEvals(0)
+          , m__localSearchJacobians(0)
+          , m__monitor(0)
+          , m__capture(0)
+          , m__team(0)
+          , m__threadModels()
+          , m__threadParams()
+          , m__rng()
+          , m__hasRandomStream(false)
+          , m__runRng()
+          , m__generation(0)
+          , m__stopped(false)
       {}
 
       /// Destructor
@@ -150,18 +295,348 @@ namespace jpw_nld {
       double operator()(dvector_t& param_min, const FitData_t& theData,
                         Model_t& theModel);
 
+      /// \name Stepwise Minimization
+      /// \c operator() is \c begin(), then \c step() until it returns \c
+      /// false, then \c end().  Call them directly to do other work
+      /// between generations, such as the migrations of an \c IslandGA.
+      /// Pass the same \a theData and \a theModel to each.
+      /// @{
+
+      /// Creates and evaluates the initial population.
+      /**
+       * \a params0 is only used by \c setCapture().
+       *
+       * Throws an \c InvalidArgError if the runtime settings are
+       * inconsistent; see \c setPopulationSize().
+       */
+      void begin(const dvector_t& params0, const FitData_t& theData,
+                 Model_t& theModel);
+
+      /// Evaluates the current generation and breeds the next.
+      /**
+       * Returns \c false once the minimization is done, either after the
+       * last generation, or because the \c ProgressMonitor or a stopping
+       * rule stopped it.
+       */
+      bool step(const FitData_t& theData, Model_t& theModel);
+
+      /// Evaluates the final generation.
+      /**
+       * Sets \a param_min to its best member, and returns that member's
+       * \f$\chi^2\f$.
+       */
+      double end(dvector_t& param_min, const FitData_t& theData,
+                 Model_t& theModel);
+
+      /// The number of generations bred so far by \c step().
+      unsigned generation() const
+      { return m__generation; }
+
+      /// Copies the \a n best members of the population, and their
+      /// \f$\chi^2\f$, into \a params and \a chiSq.
+      /**
+       * Call this after \c begin() or \c step().  Only the \c nElite()
+       * members are sure to be the best; \a n is limited to that.
+       */
+      void emigrants(unsigned n, popVec_t& params, dvector_t& chiSq) const;
+
+      /// Replaces members of the new generation with \a params, whose
+      /// \f$\chi^2\f$ values are \a chiSq.
+      /**
+       * Call this after \c step().  The immigrants take the place of
+       * children of crossover, so at most <tt>populationSize() -
+       * nBreeding()</tt> are used.  They aren't evaluated again.
+       */
+      void immigrate(const popVec_t& params, const dvector_t& chiSq);
+      /// @}
+
+      /// \name Runtime Settings
+      /// Each defaults to the template argument of the same name, and
+      /// takes effect at the next \c begin() (or \c operator()).
+      /// @{
+
+      /// Set the number of members in each generation.
+      /**
+       * At least 4.  \c nElite() must be less than \c nBreeding(), the
+       * half of the population that survives each generation.
+       */
+      void setPopulationSize(unsigned n)
+      { m__popSize = n; }
+
+      /// The number of members in each generation.
+      unsigned populationSize() const
+      { return m__popSize; }
+
+      /// Set the size of the initial population.
+      /**
+       * At least \c populationSize().  \c 0, the default, means 5 times
+       * \c populationSize().
+       */
+      void setInitialPopulationSize(unsigned n)
+      { m__initialPopSize = n; }
+
+      /// The size of the initial population.
+      unsigned initialPopulationSize() const
+      { return ( m__initialPopSize ? m__initialPopSize : 5*m__popSize ); }
+
+      /// Set how the initial population is drawn.
+      /**
+       * The default, \c QuasiRandomSet::PseudoRandom, draws each member
+       * from its own pseudo-random stream.  The other methods draw the
+       * whole population as one \c QuasiRandomSet, randomized by the
+       * stream.  They assume that \c Model_t::randomParams() makes one
+       * draw per parameter, as the \c BarrierModel policies do.
+       */
+      void setInitialSampling(QuasiRandomSet::Method_t method)
+      { m__initialSampling = method; }
+
+      /// How the initial population is drawn.
+      QuasiRandomSet::Method_t initialSampling() const
+      { return m__initialSampling; }
+
+      /// The number of members that survive each generation.
+      /**
+       * Half of \c populationSize().  This used to be tunable, but changing
+       * it didn't have much effect.
+       */
+      unsigned nBreeding() const
+      { return m__popSize/2; }
+
+      /// Set the maximum number of generations, at least 1.
+      void setNGenerations(unsigned n)
+      { m__nGenerations = n; }
+
+      /// The maximum number of generations.
+      unsigned nGenerations() const
+      { return m__nGenerations; }
+
+      /// Set the number of mutations of each parameter per generation.
+      void setNMutate(unsigned n)
+      { m__nMutate = n; }
+
+      /// The number of mutations of each parameter per generation.
+      unsigned nMutate() const
+      { return m__nMutate; }
+
+      /// Set the number of best members that are never mutated.
+      void setNElite(unsigned n)
+      { m__nElite = n; }
+
+      /// The number of best members that are never mutated.
+      unsigned nElite() const
+      { return m__nElite; }
+      /// @}
+
+      /// \name Stopping Rules
+      /// Each is checked after a generation has been evaluated, and ends
+      /// the minimization with that generation.
+      /// @{
+
+      /// Stop once the best \f$\chi^2\f$ hasn't improved for \a n
+      /// generations.
+      /**
+       * An improvement is a relative decrease of more than \c
+       * stallTolerance().  \c 0 disables the rule (the default).
+       */
+      void setStallGenerations(unsigned n)
+      { m__stallGenerations = n; }
+
+      /// The number of generations without improvement in the best
+      /// \f$\chi^2\f$ after which the minimization stops.
+      unsigned stallGenerations() const
+      { return m__stallGenerations; }
+
+      /// Stop once the mean \f$\chi^2\f$ of the population hasn't
+      /// improved for \a n generations.
+      /**
+       * As \c setStallGenerations(), but for the mean.  The mutants keep
+       * the mean noisy, so use a longer span than for the best.
+       */
+      void setMeanStallGenerations(unsigned n)
+      { m__meanStallGenerations = n; }
+
+      /// The number of generations without improvement in the mean
+      /// \f$\chi^2\f$ after which the minimization stops.
+      unsigned meanStallGenerations() const
+      { return m__meanStallGenerations; }
+
+      /// Set the relative decrease in \f$\chi^2\f$ that counts as an
+      /// improvement.
+      void setStallTolerance(double tol)
+      { m__stallTolerance = tol; }
+
+      /// The relative decrease in \f$\chi^2\f$ that counts as an
+      /// improvement.
+      double stallTolerance() const
+      { return m__stallTolerance; }
+
+      /// Stop once \c diversity() falls below \a d.
+      /**
+       * \c 0 disables the rule (the default).
+       */
+      void setMinDiversity(double d)
+      { m__minDiversity = d; }
+
+      /// The \c diversity() below which the minimization stops.
+      double minDiversity() const
+      { return m__minDiversity; }
+
+      /// The spread of the current population, relative to that of the
+      /// initial population.
+      /**
+       * For each parameter, the median absolute deviation from the median
+       * over the better half of the population (by \f$\chi^2\f$), divided
+       * by that of the initial population; this is the mean over the
+       * parameters.  It goes to \c 0 as the GA settles on one basin.
+       *
+       * Only computed while \c minDiversity() is non-zero.  Otherwise,
+       * it's always \c 1.
+       */
+      double diversity() const
+      { return m__diversity; }
+
+      /// Why the last minimization stopped.
+      StopReason_t stopReason() const
+      { return m__stopReason; }
+      /// @}
+
+      /// Register a progress callback.  Pass \c 0 to remove it.
+      /**
+       * The monitor is called once per generation, with the generation
+       * number (starting at 1), the best \f$\chi^2\f$ in the population
+       * and the corresponding parameters.  Returning \c false ends the
+       * minimization after that generation.
+       *
+       * The \c ProgressMonitor is not owned by this object.
+       */
+      void setProgressMonitor(fortlib::FitControl::ProgressMonitor* monitor)
+      { m__monitor = monitor; }
+
+      /// Record every minimization into \a capture.
+      /**
+       * Each call to \c operator() overwrites \a capture, which is not
+       * owned by this object.  Pass \c 0 to stop capturing (the default).
+       * Only a \c measure::PersistenceMap is recorded as the data.
+       */
+      void setCapture(measure::FitCapture* capture)
+      { m__capture = capture; }
+
+      /// Evaluate the population on the threads of \a team.
+      /**
+       * Pass \c 0 to evaluate it serially, on the calling thread (the
+       * default).  The \c ThreadTeam is not owned by this object.
+       */
+      void setThreadTeam(ThreadTeam* team)
+      { m__team = team; }
+
+      /// The current \c ThreadTeam, or \c 0.
+      ThreadTeam* threadTeam() const
+      { return m__team; }
+
+      /// Refine the \c nElite() best members with \a search every \a
+      /// interval generations.
+      /**
+       * The refinement happens after a generation has been evaluated, and
+       * before it's rated for breeding, in generations \a interval, \c
+       * 2*interval, and so on.  A refined member replaces the original,
+       * along with its \f$\chi^2\f$.
+       *
+       * Pass \c 0 to remove the local search (the default).  \a search is
+       * not owned by this object.  It runs on the calling thread, even with
+       * a \c ThreadTeam, so it needn't be re-entrant; but concurrent GAs
+       * (e.g. the islands of an \c IslandGA) each need their own.
+       *
+       * A \c FitCapture doesn't record the local search, so the replay of a
+       * memetic minimization won't reproduce it.
+       */
+      void setLocalSearch(LocalSearch_t* search,
+                          unsigned interval=DEFAULT_LOCAL_SEARCH_INTERVAL)
+      {
+          m__localSearch = search;
+          m__localSearchInterval = interval;
+      }
+
+      /// The number of generations between local searches.
+      unsigned localSearchInterval() const
+      { return m__localSearchInterval; }
+
+      /// Draw the random numbers from \a rng, instead of from \c drand48().
+      /**
+       * Each call to \c operator() starts over at the beginning of \a rng,
+       * so it repeats the same minimization.  Use e.g. <tt>PhiloxRNG(seed,
+       * runNumber)</tt> to give each of many runs a reproducible stream.
+       */
+      void setRandomStream(const PhiloxRNG& rng)
+      {
+          m__rng = rng;
+          m__hasRandomStream = true;
+      }
+
+      /// Go back to seeding each minimization from \c drand48() (the
+      /// default).
+      void clearRandomStream()
+      { m__hasRandomStream = false; }
+
+      /// The number of \f$\chi^2\f$ evaluations made by the last run of
+      /// \c operator().
+      /**
+       * Only counts the GA's own evaluations; see \c localSearchEvals().
+       */
+      unsigned functionEvals() const
+      { return m__functionEvals; }
+
+      /// The number of \f$\chi^2\f$ evaluations made by the local search
+      /// during the last run of \c operator().
+      unsigned localSearchEvals() const
+      { return m__localSearchEvals; }
+
+      /// The number of Jacobians computed by the local search during the
+      /// last run of \c operator().
+      unsigned localSearchJacobians() const
+      { return m__localSearchJacobians; }
+
   protected:
+      /// A population, stored as one contiguous, row-major matrix of
+      /// parameters.
+      /**
+       * Member \c i is in row \c order[i].  So reordering the population
+       * only permutes \c order; the parameters stay put.
+       */
+      struct Population
+      {
+          explicit Population(unsigned nMembers);
+
+          double* member(unsigned i)
+          { return &params[order[i]*N_PARAMETERS]; }
+
+          const double* member(unsigned i) const
+          { return &params[order[i]*N_PARAMETERS]; }
+
+          /// Copies member \a i into \a dest, which must be \c
+          /// N_PARAMETERS long.
+          void get(unsigned i, dvector_t& dest) const;
+
+          /// Copies \a src into member \a i.
+          void set(unsigned i, const dvector_t& src);
+
+          dvector_t params;
+          vector<unsigned> order;
+      };
+
       /// Create the initial population.
       /**
        * This function uses \a theData and \a theModel to sort \a ppop in
-       * order of increasing fitness.
+       * order of increasing fitness, and sets \a chiPop to the
+       * \f$\chi^2\f$ of each member.
        *
        * \a theModel is non-<tt>const</tt> because it contains internal
        * bookkeeping members that change during the fit.
        */
-      void initializePopulation(popVec_t& ppop,
+      void initializePopulation(Population& ppop,
+                                dvector_t& chiPop,
                                 const FitData_t& theData,
-                                Model_t& theModel);
+                                Model_t& theModel,
+                                const PhiloxRNG& rng);
 
       /// Performs the reproduction, crossover, and mutation stages.
       /**
@@ -171,28 +646,146 @@ namespace jpw_nld {
        * \f[
        * A \cdot x_1 + \left( 1 - A \cdot x_2 \right)
        * \f]
+       *
+       * Replaces \a pop with the next generation, in place.  \a rng is
+       * this generation's stream.
+       *
+       * Copies the \f$\chi^2\f$ of each survivor from \a oldChiPop to \a
+       * newChiPop, and marks every other member of \a pop as stale.
+       */
+      void breedAndMutate(Population& pop,
+                          dvector_t& newChiPop,
+                          const dvector_t& oldChiPop,
+                          const dvector_t& ratingv,
+                          const PhiloxRNG& rng);
+
+      /// Sets \a chiPop[i] to \f$\chi^2\f$ of member \c i of \a pop,
+      /// for each of its first \a n members.
+      /**
+       * If \a which is non-zero, evaluates the members \a which[0] to \a
+       * which[n-1] instead.
+       *
+       * Runs on the \c ThreadTeam, if there is one.
        */
-      void breedAndMutate(popVec_t& newpop,
-                          const popVec_t& oldpop,
-                          const dvector_t& ratingv);
+      void evaluate(const Population& pop, dvector_t& chiPop, unsigned n,
+                    const FitData_t& theData, Model_t& theModel,
+                    const vector<unsigned>* which=0);
+
+      /// Evaluates the members of \a pop marked as stale, and clears the
+      /// marks.
+      void evaluateStale(const Population& pop, dvector_t& chiPop,
+                         const FitData_t& theData, Model_t& theModel);
+
+      /// Runs the local search on the \c nElite() members of \a pop with
+      /// the lowest \f$\chi^2\f$.
+      void polishElite(Population& pop, dvector_t& chiPop,
+                       const FitData_t& theData);
+
+      /// The median absolute deviation of parameter \a j over the first \a
+      /// n members of \a pop, or over members \a which[0] to \a
+      /// which[n-1].
+      double geneSpread(const Population& pop, unsigned n, index_t j,
+                        const vector<unsigned>* which=0);
+
+      /// Applies the stopping rules to generation \a k, whose \f$\chi^2\f$
+      /// values are \a chiPop.  They sum to \a chiSum, and the lowest is
+      /// at \a best.
+      /**
+       * Returns \c true, and sets \c m__stopReason, if one of them fires.
+       */
+      bool converged(step_t k, const dvector_t& chiPop, double chiSum,
+                     step_t best);
 
   private:
-      const dvector_t m__blankParamVec;
-      popVec_t m__wrkPop0;
+      Population m__wrkPop0;
       dvector_t m__wrkChiPop0;
+      dvector_t m__wrkParams;
       dvector_t m__wrkMutantDNA;
-      fortlib::ivector_t m__wrkSortPop0;
-      fortlib::ivector_t m__wrkSortChiSq;
-      popVec_t m__LastParamPop;
-      popVec_t m__NextParamPop;
+      dvector_t m__wrkChild1;
+      dvector_t m__wrkChild2;
+      vector<unsigned> m__wrkSortPop0;
+      vector<unsigned> m__wrkSortChiSq;
+      vector<unsigned> m__wrkOrder;
+      vector<unsigned> m__wrkRanks;
+      dvector_t m__wrkGene;
+      Population m__population;
       dvector_t m__ChiPop;
+      dvector_t m__NextChiPop;
       dvector_t m__ChiRating;
-      PopVecFiller m__zeroingFunctor;
+      // Which members of the new population need their chi^2 evaluated.
+      vector<bool> m__isStale;
+      vector<unsigned> m__staleIndex;
+      // The runtime settings.
+      unsigned m__popSize;
+      unsigned m__nGenerations;
+      unsigned m__nMutate;
+      unsigned m__nElite;
+      unsigned m__stallGenerations;
+      unsigned m__meanStallGenerations;
+      double m__stallTolerance;
+      double m__minDiversity;
+      unsigned m__initialPopSize;
+      QuasiRandomSet::Method_t m__initialSampling;
+      // The points of the initial population, for a quasi-random
+      // initialSampling().
+      QuasiRandomSet m__initialSet;
+      // The geneSpread() of each parameter in the initial population.
+      dvector_t m__diversityScale;
+      double m__diversity;
+      // The best and mean chi^2 at the last improvement, and the
+      // generations in which they improved.
+      double m__bestRef;
+      double m__meanRef;
+      step_t m__bestImproved;
+      step_t m__meanImproved;
+      StopReason_t m__stopReason;
+      unsigned m__functionEvals;
+      LocalSearch_t* m__localSearch;
+      unsigned m__localSearchInterval;
+      unsigned m__localSearchEvals;
+      unsigned m__localSearchJacobians;
+      fortlib::FitControl::ProgressMonitor* m__monitor;
+      measure::FitCapture* m__capture;
+      ThreadTeam* m__team;
+      // The model and parameter vector used by each thread.
+      ThreadModels<Model_t> m__threadModels;
+      vector<dvector_t> m__threadParams;
+      PhiloxRNG m__rng;
+      bool m__hasRandomStream;
+      // The state of the current minimization.
+      PhiloxRNG m__runRng;
+      unsigned m__generation;
+      bool m__stopped;
 
-      struct PopVecFiller
+      /// Evaluates one member of the population per task.
+      struct EvalTask : public ThreadTeam::Task
       {
-          void operator()(popVec_t& populationVector);
-          void operator()(dvector_t& val);
+          EvalTask(const ThreadModels<Model_t>& models,
+                   vector<dvector_t>& threadParams,
+                   const FitData_t& theData, const Population& pop,
+                   dvector_t& chiPop, const vector<unsigned>* which)
+              : m__models(models)
+              , m__params(threadParams)
+              , m__data(theData)
+              , m__pop(pop)
+              , m__chiPop(chiPop)
+              , m__which(which)
+          {}
+
+          void operator()(unsigned i, unsigned iThread)
+          {
+              unsigned k( m__which ? (*m__which)[i] : i );
+              m__pop.get(k, m__params[iThread]);
+              m__chiPop[k] = m__models.model(iThread).chiSquared(
+                  m__data, m__params[iThread]);
+          }
+
+          const ThreadModels<Model_t>& m__models;
+          vector<dvector_t>& m__params;
+          const FitData_t& m__data;
+          const Population& m__pop;
+          dvector_t& m__chiPop;
+          const vector<unsigned>* m__which;
       };
   };
 
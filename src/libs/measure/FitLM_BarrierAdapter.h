@@ -23,6 +23,7 @@
 #include "FitLM_Adapter.h"
 #include "PersistenceMap.h"
 #include "BarrierModels.h"
+#include "FitCapture.h"
 
 
 // Enclosing namespace
@@ -37,6 +38,19 @@ namespace jpw_nld {
   * PersistenceMap classes.  The \a F_POL_T class is the same policy type
   * taken by the \c BarrierModel class.
   *
+  * The fit is bounded by \c Model_t::paramBounds(), and so runs \c
+  * ProjectedLM.  While it's bounded, \c setBackend(FitLM::MinpackLM)
+  * selects \c ProjectedLM's \c NativeLM steps.  Call \c clearBounds() to
+  * fit with the unconstrained \c lmder_() instead.
+  *
+  * The convergence tolerances come from a \c Precision_t tier, set with
+  * \c setPrecision() or passed to \c operator()().  The default, \c
+  * Publication, fits to near machine precision.  \c Screening is far
+  * cheaper, for fits whose result is only ranked or used as a starting
+  * point.
+  *
+  * Call \c setCapture() to record each fit for an offline replay.
+  *
   * Note:  Because this header uses "BarrierModels.h", translation units
   * \#including this header should also
   * <tt>\#include&nbsp;"details/BarrierModels.tcc"</tt>.
@@ -61,11 +75,69 @@ namespace jpw_nld {
       // NOTE:  MAX_ITERS==0 ==> default to a 100*(ndata+1)
       static const int MAX_ITERS=0;
 
+      /// Named sets of convergence tolerances.
+      enum Precision_t {
+          /// Stops once \f$\chi^2\f$ or the parameters change by less
+          /// than 1 part in \f$10^4\f$.  For throwaway fits.
+          Screening=0,
+          /// Stops at a relative change of \f$10^{-8}\f$.
+          Standard,
+          /// \c ERROR_CONVERGESPEC and \c PARAM_CONVERGESPEC.
+          Publication,
+          /// \c Screening, then \c Publication, starting where the \c
+          /// Screening fit stopped.
+          Scheduled,
+          N_PRECISIONS
+      };
+
+      /// The \f$\chi^2\f$ tolerance of a \c Precision_t.
+      /**
+       * \c Scheduled has the tolerance of its last stage.
+       */
+      static double errorTolerance(Precision_t precision)
+      {
+          switch(precision)
+          {
+          case Screening:
+              return 1.0e-4;
+          case Standard:
+              return 1.0e-8;
+          default:
+              return ERROR_CONVERGESPEC;
+          }
+      }
+
+      /// The parameter tolerance of a \c Precision_t.
+      static double paramTolerance(Precision_t precision)
+      {
+          switch(precision)
+          {
+          case Screening:
+              return 1.0e-4;
+          case Standard:
+              return 1.0e-8;
+          default:
+              return PARAM_CONVERGESPEC;
+          }
+      }
+
       /// Default Constructor
-      explicit FitLM_BarrierAdapter(tslen_t nData)
-          : Base_t(nData)
+      /**
+       * \a pool has the same meaning as in the \c fortlib::FitLM c'tor.
+       */
+      explicit FitLM_BarrierAdapter(tslen_t nData,
+                                    fortlib::FitLM_WorkspacePool* pool=0)
+          : Base_t(nData, pool)
           , m__theModel(nData)
-      {}
+          , m__capture(0)
+          , m__precision(Publication)
+          , m__iterations(0)
+          , m__functionEvals(0)
+      {
+          fortlib::ParamBounds theBounds(Model_t::N_PARAMETERS);
+          Model_t::paramBounds(theBounds);
+          Base_t::setBounds(theBounds);
+      }
 
       /// Destructor
       ~FitLM_BarrierAdapter() {}
@@ -73,6 +145,17 @@ namespace jpw_nld {
       using Base_t::chiSquared;
       using Base_t::deltas;
       using Base_t::jacobian;
+      using Base_t::covariance;
+      using Base_t::retainJacobian;
+      using Base_t::retainsJacobian;
+      using Base_t::hasJacobian;
+      using Base_t::setBackend;
+      using Base_t::backend;
+      using Base_t::setBounds;
+      using Base_t::clearBounds;
+      using Base_t::bounds;
+      using Base_t::ndataMax;
+      using Base_t::resize;
 
       /// Perform a nonlinear least-squares fit.
       /**
@@ -84,16 +167,77 @@ namespace jpw_nld {
        * exception is \a fittedParams, which is just the \c xv parameter of
        * FitLM_Adapter::operator() under a different name.
        *
-       * Missing parameters use uniform constant values (specifically, the
-       * static constants that are members of this class).
+       * Missing parameters use uniform constant values:  the tolerances
+       * of \c precision(), and \c MAX_ITERS.
        */
       FitStatus_t operator()(dvector_t& fittedParams, const Data_t& theData,
                              double factor)
-      {
-          return Base_t::operator()(m__theModel, theData, fittedParams,
-                                    ERROR_CONVERGESPEC, PARAM_CONVERGESPEC,
-                                    MAX_ITERS, factor);
-      }
+      { return fit(fittedParams, theData, factor, m__precision, 0); }
+
+      /// Perform a nonlinear least-squares fit to the tolerances of \a
+      /// precision.
+      /**
+       * A \c Scheduled fit stops early only if a stage returns an error (a
+       * status less than or equal to \c FitLM::InputError).  It returns
+       * the status of its last stage.
+       */
+      FitStatus_t operator()(dvector_t& fittedParams, const Data_t& theData,
+                             double factor, Precision_t precision)
+      { return fit(fittedParams, theData, factor, precision, 0); }
+
+      /// Perform a nonlinear least-squares fit, subject to a time budget,
+      /// cancellation, and/or progress monitoring.
+      /**
+       * Identical to the other overload, except for \a control.  See
+       * <tt>FitLM_Adapter::operator()(..., FitControl\&)</tt> for details.
+       */
+      FitStatus_t operator()(dvector_t& fittedParams, const Data_t& theData,
+                             double factor, fortlib::FitControl& control)
+      { return fit(fittedParams, theData, factor, m__precision, &control); }
+
+      /// Overloaded version taking both a \c Precision_t and a \c
+      /// FitControl.
+      /**
+       * The time budget, cancellation and iteration count of \a control
+       * cover all stages of a \c Scheduled fit.  A fit cancelled (or out
+       * of time) between stages returns without starting the next one.
+       */
+      FitStatus_t operator()(dvector_t& fittedParams, const Data_t& theData,
+                             double factor, Precision_t precision,
+                             fortlib::FitControl& control)
+      { return fit(fittedParams, theData, factor, precision, &control); }
+
+      /// Set the \c Precision_t of the overloads of \c operator()() that
+      /// don't take one.
+      void setPrecision(Precision_t precision)
+      { m__precision = precision; }
+
+      /// The default \c Precision_t.
+      Precision_t precision() const
+      { return m__precision; }
+
+      /// The number of iterations taken by the last run of \c
+      /// operator()(), summed over all of its stages.
+      int iterations() const
+      { return m__iterations; }
+
+      /// The number of function evaluations made by the last run of \c
+      /// operator()(), summed over all of its stages.
+      int functionEvals() const
+      { return m__functionEvals; }
+
+      /// Record every fit into \a capture.
+      /**
+       * Each fit overwrites \a capture, which is not owned by this object.
+       * Pass \c 0 to stop capturing (the default).  Capturing copies the
+       * \c PersistenceMap, once per fit.
+       */
+      void setCapture(FitCapture* capture)
+      { m__capture = capture; }
+
+      /// The current \c FitCapture, or \c 0.
+      FitCapture* capture() const
+      { return m__capture; }
 
       /// Returns the \c BarrierModel object used by this class.
       Model_t& theModel()
@@ -105,6 +249,94 @@ namespace jpw_nld {
 
   private:
       Model_t m__theModel;
+      FitCapture* m__capture;
+      Precision_t m__precision;
+      int m__iterations;
+      int m__functionEvals;
+
+      FitStatus_t fit(dvector_t& params, const Data_t& theData,
+                      double factor, Precision_t precision,
+                      fortlib::FitControl* control)
+      {
+          m__iterations = 0;
+          m__functionEvals = 0;
+          // Once per fit, however many stages it has.
+          if(control) {
+              control->start();
+          }
+          if(precision != Scheduled) {
+              return fitStage(params, theData, factor, precision, control);
+          }
+
+          const Precision_t stages[] = { Screening, Publication };
+          FitStatus_t status(fortlib::FitLM::InputError);
+          for(unsigned k=0; k<sizeof(stages)/sizeof(stages[0]); ++k)
+          {
+              int abortCode(control ? control->abortCode() : 0);
+              if(abortCode) {
+                  status = static_cast<FitStatus_t>(abortCode);
+                  break;
+              }
+              status = fitStage(params, theData, factor, stages[k],
+                                control);
+              if(status <= fortlib::FitLM::InputError) {
+                  break;
+              }
+          }
+          return status;
+      }
+
+      // A single run of the base class' operator().  Only the last stage
+      // of a Scheduled fit ends up in the FitCapture.
+      FitStatus_t fitStage(dvector_t& params, const Data_t& theData,
+                           double factor, Precision_t precision,
+                           fortlib::FitControl* control)
+      {
+          if(m__capture) {
+              // The time this stage had left.
+              double timeBudget(control ? control->timeBudget() : 0.0);
+              if(timeBudget > 0.0) {
+                  timeBudget -= control->elapsed();
+              }
+              beginCapture(params, theData, factor, precision, timeBudget);
+          }
+          double errtol(errorTolerance(precision));
+          double ptol(paramTolerance(precision));
+          FitStatus_t status = ( control
+                                 ? Base_t::resume(m__theModel, theData,
+                                                  params, errtol, ptol,
+                                                  MAX_ITERS, factor,
+                                                  *control)
+                                 : Base_t::operator()(m__theModel, theData,
+                                                      params, errtol, ptol,
+                                                      MAX_ITERS, factor) );
+          m__iterations += Base_t::iterations();
+          m__functionEvals += Base_t::functionEvals();
+          if(m__capture) {
+              finishCapture(status, params);
+          }
+          return status;
+      }
+
+      void beginCapture(const dvector_t& params0, const Data_t& theData,
+                        double factor, Precision_t precision,
+                        double timeBudget)
+      {
+          m__capture->begin(FitCapture::LevenbergMarquardt,
+                            Model_t::N_PARAMETERS, params0);
+          m__capture->recordData(theData);
+          m__capture->recordLMSettings(errorTolerance(precision),
+                                       paramTolerance(precision),
+                                       MAX_ITERS, factor, Base_t::backend(),
+                                       Base_t::jacobianMode(), timeBudget,
+                                       Base_t::bounds());
+      }
+
+      void finishCapture(FitStatus_t status, const dvector_t& params)
+      {
+          m__capture->finish(status, Base_t::chiSquared(), params,
+                             Base_t::iterations(), Base_t::functionEvals());
+      }
 
       // Assignment Operator
       FitLM_BarrierAdapter& operator=(const FitLM_BarrierAdapter& other);
@@ -0,0 +1,209 @@
+// -*- C++ -*-
+// Header file for class FitLM_Pyramid
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _FitLM_Pyramid_H_
+#define _FitLM_Pyramid_H_
+
+// Includes
+//
+#include <vector>
+#include <stdexcept>
+#include <boost/utility.hpp>
+#include <boost/shared_ptr.hpp>
+#include "jpw_nld.h"
+#include "PersistenceMap.h"
+#include "FitLM_BarrierAdapter.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace measure {
+
+
+ // Class FitLM_Pyramid
+ /**
+  * Coarse-to-fine Levenberg-Marquardt fitting of a \c PersistenceMap.
+  *
+  * Early LM iterations on a large map only need to find the right basin,
+  * yet each one evaluates the model at every point of the map.  This class
+  * fits a "pyramid" of block-averaged copies of the map instead (see \c
+  * PersistenceMap::downsample()), coarsest first.  Each level starts from
+  * the parameters found on the level below it, so the fit of the full map
+  * usually needs only a few iterations.
+  *
+  * Each level has its own \c FitLM_BarrierAdapter, available through \c
+  * adapter(), so the Jacobian mode, bounds, etc. may be set per level.
+  * The coarse levels only need to find the basin, so their adapters start
+  * out with the \c Screening precision; the full map's keeps the default.
+  *
+  * As with \c FitLM_BarrierAdapter, translation units \#including this
+  * header should also <tt>\#include&nbsp;"details/BarrierModels.tcc"</tt>.
+  */
+  template<class F_POL_T=policy::Full>
+  class FitLM_Pyramid : private boost::noncopyable
+  {
+  public:
+      typedef FitLM_BarrierAdapter<F_POL_T> Adapter_t;
+      typedef typename Adapter_t::FitStatus_t FitStatus_t;
+      typedef PersistenceMap::size_type size_type;
+
+      /// The default ratio between the sizes of adjacent levels.
+      static const size_type DEFAULT_LEVEL_RATIO=4;
+      /// The default size of the coarsest level.
+      static const size_type MIN_LEVEL_BINS=12;
+
+      /// Constructor
+      /**
+       * Builds a pyramid for maps of \a nBins by \a nBins, with each level
+       * \c DEFAULT_LEVEL_RATIO times smaller than the one above it, down to
+       * no fewer than \c MIN_LEVEL_BINS bins.
+       */
+      explicit FitLM_Pyramid(size_type nBins)
+      {
+          std::vector<size_type> levelBins(1, nBins);
+          while(levelBins.back()/DEFAULT_LEVEL_RATIO >= MIN_LEVEL_BINS) {
+              levelBins.push_back(levelBins.back()/DEFAULT_LEVEL_RATIO);
+          }
+          init(std::vector<size_type>(levelBins.rbegin(),
+                                      levelBins.rend()));
+      }
+
+      /// Constructor
+      /**
+       * \a levelBins lists the sizes of the levels, coarsest first.  The
+       * last element is the size of the maps that will be fit.
+       *
+       * \throws std::length_error if \a levelBins is empty or not
+       * strictly increasing.
+       */
+      explicit FitLM_Pyramid(const std::vector<size_type>& levelBins)
+      { init(levelBins); }
+
+      /// Destructor
+      ~FitLM_Pyramid() {}
+
+      /// The number of levels, including the full map.
+      size_type nLevels() const
+      { return m__levelBins.size(); }
+
+      /// The number of bins along each side of level \a k.
+      /**
+       * Level \c 0 is the coarsest; level <tt>nLevels()-1</tt> is the full
+       * map.
+       */
+      size_type levelBins(size_type k) const
+      { return m__levelBins[k]; }
+
+      /// The \c FitLM_BarrierAdapter used on level \a k.
+      Adapter_t& adapter(size_type k)
+      { return *m__adapters[k]; }
+
+      /// Overloaded version returning a const object.
+      const Adapter_t& adapter(size_type k) const
+      { return *m__adapters[k]; }
+
+      /// The status returned by the fit of level \a k, during the last run
+      /// of \c operator().
+      FitStatus_t levelStatus(size_type k) const
+      { return m__levelStatus[k]; }
+
+      /// \f$\chi^2\f$ of the full map, after the last run of \c
+      /// operator().
+      double chiSquared() const
+      { return m__adapters.back()->chiSquared(); }
+
+      /// Perform a coarse-to-fine nonlinear least-squares fit.
+      /**
+       * Same as \c FitLM_BarrierAdapter::operator(), except that \a
+       * theData is first fit at each coarser level.  \a theData must have
+       * \c levelBins(nLevels()-1) bins along each side.
+       *
+       * A coarse level that fails to converge still passes its best
+       * parameters on to the next level.  The fit stops early only if a
+       * level returns an error (a status less than or equal to \c
+       * FitLM::InputError).
+       *
+       * \returns The status of the fit of the full map, or of the level
+       * that failed.
+       */
+      FitStatus_t operator()(dvector_t& fittedParams,
+                             const PersistenceMap& theData, double factor)
+      {
+          size_type iFull = m__levelBins.size() - 1;
+          for(size_type k=0; k<iFull; ++k)
+          {
+              m__levelMaps[k].downsample(theData, m__levelBins[k]);
+              m__levelStatus[k] = (*m__adapters[k])(fittedParams,
+                                                     m__levelMaps[k],
+                                                     factor);
+              if(m__levelStatus[k] <= fortlib::FitLM::InputError) {
+                  return m__levelStatus[k];
+              }
+          }
+
+          m__levelStatus[iFull] = (*m__adapters[iFull])(fittedParams,
+                                                         theData, factor);
+          return m__levelStatus[iFull];
+      }
+
+  private:
+      std::vector<size_type> m__levelBins;
+      std::vector<PersistenceMap> m__levelMaps;
+      std::vector< boost::shared_ptr<Adapter_t> > m__adapters;
+      std::vector<FitStatus_t> m__levelStatus;
+
+      void init(const std::vector<size_type>& levelBins)
+      {
+          if(levelBins.empty()) {
+              throw std::length_error("FitLM_Pyramid:  "
+                                      "No levels specified.");
+          }
+          for(size_type k=1; k<levelBins.size(); ++k) {
+              if(levelBins[k] <= levelBins[k-1]) {
+                  throw std::length_error("FitLM_Pyramid:  Level sizes "
+                                          "must be strictly increasing.");
+              }
+          }
+
+          m__levelBins = levelBins;
+          m__levelStatus.assign(levelBins.size(),
+                                fortlib::FitLM::InputError);
+          for(size_type k=0; k<levelBins.size(); ++k)
+          {
+              // The full map is supplied by the caller.
+              if(k + 1 < levelBins.size()) {
+                  m__levelMaps.push_back(PersistenceMap(levelBins[k]));
+              }
+              m__adapters.push_back(boost::shared_ptr<Adapter_t>(
+                  new Adapter_t(levelBins[k]*levelBins[k]) ));
+              if(k + 1 < levelBins.size()) {
+                  m__adapters.back()->setPrecision(Adapter_t::Screening);
+              }
+          }
+      }
+  };
+
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_FitLM_Pyramid_H_
+/////////////////////////
+//
+// End
@@ -0,0 +1,329 @@
+// -*- C++ -*-
+// Header file for template class IslandGA
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _IslandGA_H_
+#define _IslandGA_H_
+
+// Includes
+//
+#include <vector>
+#include <algorithm>
+#include <boost/utility.hpp>
+#include <boost/shared_ptr.hpp>
+#include "jpw_nld.h"
+#include "nld_exceptions.h"
+#include "ThreadTeam.h"
+#include "ThreadModels.h"
+#include "PhiloxRNG.h"
+#include "FitGA.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace optimize {
+
+
+  // Class IslandGA
+  /**
+   * Several \c FitGA populations ("islands"), evolving in parallel, with
+   * periodic migration between them.
+   *
+   * A single population of 40 tends to converge on whichever minimum it
+   * finds first.  Separate islands converge separately, and so explore
+   * more of the \f$\chi^2\f$ surface.  Every \c migrationInterval()
+   * generations, each island sends copies of its \c nMigrants() best
+   * members to the next island (in a ring), where they replace children
+   * of crossover.  The result is the best member of any island.
+   *
+   * \a GA_T is a \c FitGA instantiation.  Island \c i draws from stream \c
+   * i of the \c PhiloxRNG passed to \c setRandomStream() (or seeded from
+   * \c drand48(), as with \c FitGA), and migration happens at fixed
+   * generations.  So the result doesn't depend on the number of threads,
+   * or on the order in which the islands run.
+   *
+   * The islands run on a \c ThreadTeam, one island per task.  Island \c 0
+   * uses the model passed to \c operator(), and each of the others its
+   * own \c Model_t instance.
+   *
+   * Translation units \#including this header must also
+   * <tt>\#include&nbsp;"details/FitGA.tcc"</tt>.  Link with
+   * <tt>$(THREAD_LIBS)</tt>.
+   */
+  template<class GA_T>
+  class IslandGA : private boost::noncopyable
+  {
+  public:
+      typedef GA_T FitGA_t;
+      typedef typename FitGA_t::Model_t Model_t;
+      typedef typename FitGA_t::FitData_t FitData_t;
+      typedef typename FitGA_t::popVec_t popVec_t;
+
+      /// The default for \c migrationInterval().
+      static const unsigned DEFAULT_MIGRATION_INTERVAL=10;
+      /// The default for \c nMigrants().
+      static const unsigned DEFAULT_N_MIGRANTS=2;
+
+      /// Constructor
+      /**
+       * \param nIslands
+       * The number of populations, at least 1.
+       *
+       * \param team
+       * The threads to run the islands on.  If \c 0, the islands run one
+       * after another on the calling thread.  Not owned by this object.
+       *
+       * \throws InvalidArgError if \a nIslands is 0.
+       */
+      explicit IslandGA(unsigned nIslands, ThreadTeam* team=0)
+          : m__team(team)
+          , m__islands()
+          , m__models()
+          , m__running(nIslands, 0)
+          , m__results(nIslands)
+          , m__chiSq(nIslands, 0.0)
+          , m__migrationInterval(DEFAULT_MIGRATION_INTERVAL)
+          , m__nMigrants(DEFAULT_N_MIGRANTS)
+          , m__rng()
+          , m__hasRandomStream(false)
+          , m__iBest(0)
+      {
+          if(nIslands < 1) {
+              throw InvalidArgError("IslandGA::IslandGA():  Needs at least "
+                                    "one island.");
+          }
+          for(unsigned i=0; i<nIslands; ++i) {
+              m__islands.push_back(boost::shared_ptr<FitGA_t>(
+                  new FitGA_t ));
+          }
+      }
+
+      /// Destructor
+      ~IslandGA() {}
+
+      /// The number of islands.
+      unsigned nIslands() const
+      { return m__islands.size(); }
+
+      /// The \c FitGA of island \a i.
+      /**
+       * Use this to register a \c ProgressMonitor or \c FitCapture on one
+       * island.  Don't give it a \c ThreadTeam or a random stream; this
+       * object manages both.
+       */
+      FitGA_t& island(unsigned i)
+      { return *m__islands[i]; }
+
+      /// Set the number of generations between migrations.
+      /**
+       * \c 0 disables migration, leaving the islands independent.
+       */
+      void setMigrationInterval(unsigned nGenerations)
+      { m__migrationInterval = nGenerations; }
+
+      /// The number of generations between migrations.
+      unsigned migrationInterval() const
+      { return m__migrationInterval; }
+
+      /// Set the number of members each island sends per migration.
+      /**
+       * At most the \c FitGA's \c nElite() are sent.
+       */
+      void setNMigrants(unsigned n)
+      { m__nMigrants = n; }
+
+      /// The number of members each island sends per migration.
+      unsigned nMigrants() const
+      { return m__nMigrants; }
+
+      /// Draw the random numbers from \a rng, instead of from \c drand48().
+      /**
+       * As with \c FitGA::setRandomStream(), each call to \c operator()
+       * then repeats the same minimization.
+       */
+      void setRandomStream(const PhiloxRNG& rng)
+      {
+          m__rng = rng;
+          m__hasRandomStream = true;
+      }
+
+      /// Go back to seeding each minimization from \c drand48() (the
+      /// default).
+      void clearRandomStream()
+      { m__hasRandomStream = false; }
+
+      /// Performs the minimization on every island.
+      /**
+       * Sets \a param_min to the best member of any island, and returns
+       * its \f$\chi^2\f$.
+       */
+      double operator()(dvector_t& param_min, const FitData_t& theData,
+                        Model_t& theModel)
+      {
+          unsigned nIsles(m__islands.size());
+          PhiloxRNG rng( m__hasRandomStream ? m__rng
+                         : PhiloxRNG::fromRand48() );
+          m__models.assign(m__islands.size(), theModel, theData.size());
+          for(unsigned i=0; i<nIsles; ++i) {
+              m__islands[i]->setRandomStream(rng.split(i));
+              m__results[i] = param_min;
+          }
+
+          runPhase(IslandTask::Begin, theData);
+          do {
+              runPhase(IslandTask::Evolve, theData);
+              migrate();
+          } while( std::count(m__running.begin(), m__running.end(), 1) );
+          runPhase(IslandTask::End, theData);
+
+          m__iBest = ( std::min_element(m__chiSq.begin(), m__chiSq.end())
+                       - m__chiSq.begin() );
+          param_min = m__results[m__iBest];
+          return m__chiSq[m__iBest];
+      }
+
+      /// The island with the best result of the last run of \c
+      /// operator().
+      unsigned bestIsland() const
+      { return m__iBest; }
+
+      /// The \f$\chi^2\f$ of the result of island \a i, from the last run
+      /// of \c operator().
+      double islandChiSq(unsigned i) const
+      { return m__chiSq[i]; }
+
+      /// The number of \f$\chi^2\f$ evaluations made by the last run of
+      /// \c operator(), over all of the islands.
+      unsigned functionEvals() const
+      {
+          unsigned nEvals(0);
+          for(unsigned i=0; i<m__islands.size(); ++i) {
+              nEvals += m__islands[i]->functionEvals();
+          }
+          return nEvals;
+      }
+
+  private:
+      ThreadTeam* m__team;
+      std::vector< boost::shared_ptr<FitGA_t> > m__islands;
+      // The model used by each island.
+      ThreadModels<Model_t> m__models;
+      // Whether each island's minimization is still going.  [N.B.:  Not a
+      // vector<bool>; the islands set their elements concurrently.]
+      std::vector<char> m__running;
+      popVec_t m__results;
+      dvector_t m__chiSq;
+      unsigned m__migrationInterval;
+      unsigned m__nMigrants;
+      PhiloxRNG m__rng;
+      bool m__hasRandomStream;
+      unsigned m__iBest;
+
+      /// One phase of the minimization, for each island.
+      struct IslandTask : public ThreadTeam::Task
+      {
+          enum Phase_t { Begin, Evolve, End };
+
+          IslandTask(IslandGA& driver, Phase_t phase,
+                     const FitData_t& theData)
+              : m__driver(driver)
+              , m__phase(phase)
+              , m__data(theData)
+          {}
+
+          void operator()(unsigned i, unsigned /*iThread*/)
+          {
+              FitGA_t& theGA(*m__driver.m__islands[i]);
+              Model_t& theModel(m__driver.m__models.model(i));
+              switch(m__phase)
+              {
+              case Begin:
+                  theGA.begin(m__driver.m__results[i], m__data, theModel);
+                  m__driver.m__running[i] = 1;
+                  break;
+              case Evolve:
+              {
+                  // With no migrations, evolve until done.
+                  unsigned nSteps(m__driver.m__migrationInterval);
+                  char& running(m__driver.m__running[i]);
+                  for(unsigned g=0; running && (!nSteps || (g < nSteps));
+                      ++g)
+                  {
+                      running = theGA.step(m__data, theModel);
+                  }
+                  break;
+              }
+              case End:
+                  m__driver.m__chiSq[i] = theGA.end(m__driver.m__results[i],
+                                                    m__data, theModel);
+                  break;
+              }
+          }
+
+          IslandGA& m__driver;
+          Phase_t m__phase;
+          const FitData_t& m__data;
+      };
+
+      void runPhase(typename IslandTask::Phase_t phase,
+                    const FitData_t& theData)
+      {
+          IslandTask task(*this, phase, theData);
+          if(m__team) {
+              m__team->run(task, m__islands.size());
+          } else {
+              for(unsigned i=0; i<m__islands.size(); ++i) {
+                  task(i, 0);
+              }
+          }
+      }
+
+      // Each running island sends its best members to the next one in the
+      // ring.  All of the emigrants are chosen before any arrive.
+      void migrate()
+      {
+          unsigned nIsles(m__islands.size());
+          if( (nIsles < 2) || !m__migrationInterval || !m__nMigrants ) {
+              return;
+          }
+
+          std::vector<popVec_t> migrants(nIsles);
+          std::vector<dvector_t> migrantChiSq(nIsles);
+          for(unsigned i=0; i<nIsles; ++i) {
+              if(m__running[i]) {
+                  m__islands[i]->emigrants(m__nMigrants, migrants[i],
+                                           migrantChiSq[i]);
+              }
+          }
+          for(unsigned i=0; i<nIsles; ++i) {
+              unsigned dest((i + 1)%nIsles);
+              if(m__running[i] && m__running[dest]) {
+                  m__islands[dest]->immigrate(migrants[i], migrantChiSq[i]);
+              }
+          }
+      }
+  };
+
+
+ }; //end namespace optimize
+}; //end namespace jpw_nld
+
+
+#endif //_IslandGA_H_
+/////////////////////////
+//
+// End
@@ -0,0 +1,182 @@
+// -*- C++ -*-
+// Header file for template class LMPolish
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _LMPolish_H_
+#define _LMPolish_H_
+
+// Includes
+//
+#include <boost/utility.hpp>
+#include "jpw_nld.h"
+#include "FitControl.h"
+#include "PersistenceMap.h"
+#include "FitLM_BarrierAdapter.h"
+#include "FitGA.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace measure {
+
+
+ // Class LMPolish
+ /**
+  * The local search of a memetic \c FitGA:  a short Levenberg-Marquardt
+  * fit, from each member passed to it.
+  *
+  * Each fit is cut off after \c maxIterations() iterations, at the
+  * tolerances of the \c Screening tier.  The fit is only meant to carry a
+  * member to the bottom of its basin; the GA does the rest.  Since \c
+  * lmder_() only accepts steps that reduce \f$\chi^2\f$, a fit cut short
+  * still returns the best parameters it found.
+  *
+  * Use it as follows:
+  * \code
+  *     FitGA<FullBarrierModel_t, PersistenceMap> theGA;
+  *     LMPolish<> polish(theMap.size());
+  *     theGA.setLocalSearch(&polish);
+  * \endcode
+  *
+  * As with \c FitLM_BarrierAdapter, translation units \#including this
+  * header should also <tt>\#include&nbsp;"details/BarrierModels.tcc"</tt>.
+  */
+  template<class F_POL_T=policy::Full>
+  class LMPolish
+      : public optimize::LocalSearch<PersistenceMap>
+      , private boost::noncopyable
+  {
+  public:
+      typedef FitLM_BarrierAdapter<F_POL_T> Adapter_t;
+      typedef typename Adapter_t::FitStatus_t FitStatus_t;
+
+      /// The default for \c maxIterations().
+      static const unsigned DEFAULT_MAX_ITERATIONS=5;
+      /// The default for \c factor().
+      static const double DEFAULT_FACTOR;
+
+      /// Constructor
+      /**
+       * \a nData and \a pool have the same meaning as in the \c
+       * FitLM_BarrierAdapter c'tor.
+       */
+      explicit LMPolish(tslen_t nData,
+                        fortlib::FitLM_WorkspacePool* pool=0)
+          : m__fitter(nData, pool)
+          , m__maxIterations(DEFAULT_MAX_ITERATIONS)
+          , m__factor(DEFAULT_FACTOR)
+          , m__params()
+          , m__functionEvals(0)
+          , m__jacobianEvals(0)
+      {
+          m__fitter.setPrecision(Adapter_t::Screening);
+      }
+
+      /// Destructor
+      ~LMPolish() {}
+
+      /// The \c FitLM_BarrierAdapter that runs the fits.
+      /**
+       * Use this to select the back-end, bounds, precision, etc.
+       */
+      Adapter_t& adapter()
+      { return m__fitter; }
+
+      /// Set the number of iterations after which a fit is cut off.
+      void setMaxIterations(unsigned n)
+      { m__maxIterations = n; }
+
+      /// The number of iterations after which a fit is cut off.
+      unsigned maxIterations() const
+      { return m__maxIterations; }
+
+      /// Set the \a factor passed to \c FitLM_BarrierAdapter::operator()().
+      void setFactor(double factor)
+      { m__factor = factor; }
+
+      /// The \a factor passed to \c FitLM_BarrierAdapter::operator()().
+      double factor() const
+      { return m__factor; }
+
+      /// Fits \a theData, starting from \a params.
+      /**
+       * Keeps the fitted parameters only if they improve on \a chiSq.
+       * Parameters from a fit that failed (the model aborted, or the
+       * input was bad) are never kept.
+       */
+      double operator()(dvector_t& params, double chiSq,
+                        const PersistenceMap& theData)
+      {
+          m__params = params;
+          IterationCap cap(m__maxIterations);
+          fortlib::FitControl control;
+          control.setProgressMonitor(&cap);
+          FitStatus_t status = m__fitter(m__params, theData, m__factor,
+                                         control);
+          m__functionEvals = m__fitter.functionEvals();
+          m__jacobianEvals = m__fitter.iterations();
+
+          bool usable = ( (status > fortlib::FitLM::InputError)
+                          || (status == fortlib::FitLM::Cancelled)
+                          || (status == fortlib::FitLM::DeadlineExceeded) );
+          double fitChiSq(m__fitter.chiSquared());
+          if(usable && (fitChiSq < chiSq)) {
+              params = m__params;
+              return fitChiSq;
+          }
+          return chiSq;
+      }
+
+      unsigned functionEvals() const
+      { return m__functionEvals; }
+
+      unsigned jacobianEvals() const
+      { return m__jacobianEvals; }
+
+  private:
+      Adapter_t m__fitter;
+      unsigned m__maxIterations;
+      double m__factor;
+      dvector_t m__params;
+      unsigned m__functionEvals;
+      unsigned m__jacobianEvals;
+
+      /// Cancels the fit once it has run \c m__max iterations.
+      struct IterationCap : public fortlib::FitControl::ProgressMonitor
+      {
+          explicit IterationCap(unsigned maxIterations)
+              : m__max(maxIterations)
+          {}
+
+          bool operator()(unsigned iteration, double, const double*,
+                          index_t)
+          { return (iteration <= m__max); }
+
+          unsigned m__max;
+      };
+  };
+  template<typename P>
+  const double LMPolish<P>::DEFAULT_FACTOR=100.0;
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_LMPolish_H_
+/////////////////////////
+//
+// End
@@ -0,0 +1,510 @@
+// -*- C++ -*-
+// Header file for class MultiStartLM
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _MultiStartLM_H_
+#define _MultiStartLM_H_
+
+// Includes
+//
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <boost/utility.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include "jpw_nld.h"
+#include "ThreadTeam.h"
+#include "FitControl.h"
+#include "ParamBounds.h"
+#include "PersistenceMap.h"
+#include "FitLM_BarrierAdapter.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace measure {
+
+
+ // Class MultiStartLM
+ /**
+  * Levenberg-Marquardt fits of one \c PersistenceMap from many starting
+  * points, run in parallel.
+  *
+  * The \f$\chi^2\f$ surface of the barrier model has several local minima
+  * (mostly in beta and the width).  \c FitGA copes with that, at the cost
+  * of a great many model evaluations.  This class instead runs a complete
+  * LM fit from each of a set of diverse starting points, and reports the
+  * best fit along with every distinct local minimum that the fits found.
+  *
+  * The starting points come from \c addStart(), for points chosen by the
+  * caller (e.g. the elite members of a \c FitGA population, or a
+  * quasi-random sequence), and from \c addRandomStarts(), which uses \c
+  * Model_t::randomParams().
+  *
+  * The fits are shared out over a \c ThreadTeam, with one \c
+  * FitLM_BarrierAdapter per thread (see \c adapter()).  A start is
+  * abandoned once it's clearly dominated:  after \c minIterations()
+  * iterations, if its \f$\chi^2\f$ is more than \c dominanceRatio() times
+  * the best \f$\chi^2\f$ of any start that has already converged.  Which
+  * starts get abandoned therefore depends on the order in which the fits
+  * finish, but the best minimum never does.
+  *
+  * As with \c FitLM_BarrierAdapter, translation units \#including this
+  * header should also <tt>\#include&nbsp;"details/BarrierModels.tcc"</tt>.
+  * Link with <tt>$(THREAD_LIBS)</tt>.
+  */
+  template<class F_POL_T=policy::Full>
+  class MultiStartLM : private boost::noncopyable
+  {
+  public:
+      typedef FitLM_BarrierAdapter<F_POL_T> Adapter_t;
+      typedef typename Adapter_t::Model_t Model_t;
+      typedef typename Adapter_t::FitStatus_t FitStatus_t;
+
+      static const index_t N_PARAMETERS=Model_t::N_PARAMETERS;
+
+      /// The default for \c minIterations().
+      static const unsigned DEFAULT_MIN_ITERATIONS=3;
+      /// The default for \c dominanceRatio().
+      static const double DEFAULT_DOMINANCE_RATIO;
+      /// The default for \c distinctTolerance().
+      static const double DEFAULT_DISTINCT_TOL;
+      /// The value of \c StartResult::minimum for a start that didn't
+      /// converge.
+      static const unsigned NO_MINIMUM=~0U;
+
+      /// The outcome of the fit from one starting point.
+      struct StartResult
+      {
+          /// The fitted parameters.
+          dvector_t params;
+          /// \f$\chi^2\f$ at \c params.
+          double chiSq;
+          /// The status returned by the fit.
+          /**
+           * \c FitLM::Cancelled if the start was abandoned as dominated.
+           */
+          FitStatus_t status;
+          /// The number of LM iterations.
+          int iterations;
+          /// The index into \c minima() of the minimum this start reached,
+          /// or \c NO_MINIMUM.
+          unsigned minimum;
+      };
+
+      /// One distinct local minimum.
+      struct LocalMinimum
+      {
+          /// The parameters of the lowest fit that reached this minimum.
+          dvector_t params;
+          /// \f$\chi^2\f$ at \c params.
+          double chiSq;
+          /// The number of starts that converged to this minimum.
+          unsigned nStarts;
+      };
+
+      /// Constructor
+      /**
+       * \param nData
+       * The size of the maps that will be fit.
+       *
+       * \param team
+       * The threads to run the fits on.  If \c 0, the fits run one after
+       * another on the calling thread.  Not owned by this object.
+       */
+      explicit MultiStartLM(tslen_t nData, ThreadTeam* team=0)
+          : m__team(team)
+          , m__adapters()
+          , m__starts()
+          , m__results()
+          , m__minima()
+          , m__canonical()
+          , m__bounds(N_PARAMETERS)
+          , m__minIterations(DEFAULT_MIN_ITERATIONS)
+          , m__dominanceRatio(DEFAULT_DOMINANCE_RATIO)
+          , m__distinctTol(DEFAULT_DISTINCT_TOL)
+          , m__iBest(0)
+          , m__nCancelled(0)
+          , m__mutex()
+          , m__bestConverged(std::numeric_limits<double>::max())
+      {
+          unsigned nThreads = (team ? team->size() : 1);
+          for(unsigned k=0; k<nThreads; ++k) {
+              m__adapters.push_back(boost::shared_ptr<Adapter_t>(
+                  new Adapter_t(nData) ));
+          }
+          Model_t::paramBounds(m__bounds);
+      }
+
+      /// Destructor
+      ~MultiStartLM() {}
+
+      /// The number of \c FitLM_BarrierAdapter objects; one per thread.
+      unsigned nAdapters() const
+      { return m__adapters.size(); }
+
+      /// The \c FitLM_BarrierAdapter used by thread \a k.
+      /**
+       * Use this to select the back-end, Jacobian mode, bounds, etc.
+       * Configure every adapter the same way, since any start may run on
+       * any thread.
+       */
+      Adapter_t& adapter(unsigned k)
+      { return *m__adapters[k]; }
+
+      /// Add a starting point.
+      void addStart(const dvector_t& params)
+      { m__starts.push_back(params); }
+
+      /// Add \a n starting points from \c Model_t::randomParams().
+      /**
+       * Uses the \c drand48() pRNG.
+       */
+      void addRandomStarts(unsigned n)
+      {
+          dvector_t params(N_PARAMETERS);
+          for(unsigned k=0; k<n; ++k) {
+              Model_t::randomParams(params);
+              addStart(params);
+          }
+      }
+
+      /// Add \a n starting points from \c Model_t::randomParams(), drawn
+      /// from \a rng.
+      /**
+       * \a rng is a \c jpw_math::statistics::PhiloxRNG.  Start \a k
+       * draws from <tt>rng.split(k)</tt>, so the starting points don't
+       * depend on how much of \a rng has been used.
+       */
+      template<class RNG>
+      void addRandomStarts(unsigned n, const RNG& rng)
+      {
+          dvector_t params(N_PARAMETERS);
+          for(unsigned k=0; k<n; ++k) {
+              RNG startRng(rng.split(k));
+              Model_t::randomParams(params, startRng);
+              addStart(params);
+          }
+      }
+
+      /// Remove all of the starting points.
+      void clearStarts()
+      {
+          m__starts.clear();
+          m__results.clear();
+          m__minima.clear();
+          m__canonical.clear();
+      }
+
+      /// The number of starting points.
+      unsigned nStarts() const
+      { return m__starts.size(); }
+
+      /// Set how many iterations a start gets before it can be abandoned.
+      void setMinIterations(unsigned n)
+      { m__minIterations = n; }
+
+      /// The number of iterations a start gets before it can be abandoned.
+      unsigned minIterations() const
+      { return m__minIterations; }
+
+      /// Set the ratio of \f$\chi^2\f$ values at which a start counts as
+      /// dominated.
+      /**
+       * A value \<= 0 disables abandoning starts altogether.
+       */
+      void setDominanceRatio(double ratio)
+      { m__dominanceRatio = ratio; }
+
+      /// The ratio of \f$\chi^2\f$ values at which a start counts as
+      /// dominated.
+      double dominanceRatio() const
+      { return m__dominanceRatio; }
+
+      /// Set the tolerance used to tell local minima apart.
+      /**
+       * Two fits reached the same minimum if every pair of parameters
+       * differs by no more than \a tol times the larger of 1 and the
+       * parameter's magnitude.  The parameters are compared in the form
+       * given by \c Model_t::canonicalParams(), so fits that differ only
+       * by a symmetry of the model count as one minimum.  Periodic
+       * parameters (see \c Model_t::paramBounds()) are compared modulo
+       * their period.
+       */
+      void setDistinctTolerance(double tol)
+      { m__distinctTol = tol; }
+
+      /// The tolerance used to tell local minima apart.
+      double distinctTolerance() const
+      { return m__distinctTol; }
+
+      /// Fit \a theData from every starting point.
+      /**
+       * Each call starts over from the points given to \c addStart() and
+       * \c addRandomStarts(), so calling it again, e.g. on a new map,
+       * doesn't start from the previous call's minima.
+       *
+       * \param bestParams
+       * Set to the parameters of the lowest minimum found.
+       *
+       * \param theData
+       * The map to fit.
+       *
+       * \param factor
+       * As for \c FitLM_BarrierAdapter::operator()().
+       *
+       * \returns The status of the fit that produced \a bestParams.  If no
+       * start converged, the status and parameters of the start with the
+       * lowest \f$\chi^2\f$ are returned instead.  \c FitLM::InputError if
+       * there are no starting points.
+       */
+      FitStatus_t operator()(dvector_t& bestParams,
+                             const PersistenceMap& theData, double factor)
+      {
+          m__minima.clear();
+          m__canonical.clear();
+          m__nCancelled = 0;
+          m__bestConverged = std::numeric_limits<double>::max();
+          m__results.resize(m__starts.size());
+          if(m__results.empty()) {
+              return fortlib::FitLM::InputError;
+          }
+          for(unsigned k=0; k<m__results.size(); ++k) {
+              StartResult& result(m__results[k]);
+              result.params = m__starts[k];
+              result.chiSq = 0.0;
+              result.status = fortlib::FitLM::InputError;
+              result.iterations = 0;
+              result.minimum = NO_MINIMUM;
+          }
+
+          StartTask task(*this, theData, factor);
+          if(m__team) {
+              m__team->run(task, m__results.size());
+          } else {
+              for(unsigned k=0; k<m__results.size(); ++k) {
+                  task(k, 0);
+              }
+          }
+
+          collectMinima();
+          bestParams = m__results[m__iBest].params;
+          return m__results[m__iBest].status;
+      }
+
+      /// The outcome of each start from the last run of \c operator()(),
+      /// in the order in which they were added.
+      const std::vector<StartResult>& results() const
+      { return m__results; }
+
+      /// The distinct local minima found by the last run of \c
+      /// operator()(), lowest \f$\chi^2\f$ first.
+      const std::vector<LocalMinimum>& minima() const
+      { return m__minima; }
+
+      /// The number of starts abandoned as dominated during the last run
+      /// of \c operator()().
+      unsigned nCancelled() const
+      { return m__nCancelled; }
+
+  private:
+      ThreadTeam* m__team;
+      std::vector< boost::shared_ptr<Adapter_t> > m__adapters;
+      std::vector<dvector_t> m__starts;
+      std::vector<StartResult> m__results;
+      std::vector<LocalMinimum> m__minima;
+      // The canonicalParams() of each minimum.
+      std::vector<dvector_t> m__canonical;
+      fortlib::ParamBounds m__bounds;
+      unsigned m__minIterations;
+      double m__dominanceRatio;
+      double m__distinctTol;
+      unsigned m__iBest;
+      unsigned m__nCancelled;
+
+      // Guards m__bestConverged.
+      boost::mutex m__mutex;
+      double m__bestConverged;
+
+      typedef boost::unique_lock<boost::mutex> lock_t;
+
+      static bool converged(FitStatus_t status)
+      { return (status > fortlib::FitLM::InputError); }
+
+      /// Abandons fits that are dominated by one that has converged.
+      struct Pruner : public fortlib::FitControl::ProgressMonitor
+      {
+          explicit Pruner(MultiStartLM& driver)
+              : m__driver(driver)
+          {}
+
+          bool operator()(unsigned iteration, double chiSq,
+                          const double*, index_t)
+          { return !m__driver.dominated(iteration, chiSq); }
+
+          MultiStartLM& m__driver;
+      };
+
+      /// The fit from one starting point.
+      struct StartTask : public ThreadTeam::Task
+      {
+          StartTask(MultiStartLM& driver, const PersistenceMap& theData,
+                    double factor)
+              : m__driver(driver)
+              , m__data(theData)
+              , m__factor(factor)
+              , m__pruner(driver)
+          {}
+
+          void operator()(unsigned iStart, unsigned iThread)
+          {
+              Adapter_t& fitter(*m__driver.m__adapters[iThread]);
+              StartResult& result(m__driver.m__results[iStart]);
+
+              fortlib::FitControl control;
+              if(m__driver.m__dominanceRatio > 0.0) {
+                  control.setProgressMonitor(&m__pruner);
+              }
+              result.status = fitter(result.params, m__data, m__factor,
+                                     control);
+              result.chiSq = fitter.chiSquared();
+              result.iterations = fitter.iterations();
+              result.minimum = NO_MINIMUM;
+              if(converged(result.status)) {
+                  m__driver.recordConverged(result.chiSq);
+              }
+          }
+
+          MultiStartLM& m__driver;
+          const PersistenceMap& m__data;
+          double m__factor;
+          Pruner m__pruner;
+      };
+
+      /// Orders start indices by increasing \f$\chi^2\f$.
+      struct ByChiSq
+      {
+          explicit ByChiSq(const std::vector<StartResult>& results)
+              : m__results(results)
+          {}
+
+          bool operator()(unsigned a, unsigned b) const
+          { return (m__results[a].chiSq < m__results[b].chiSq); }
+
+          const std::vector<StartResult>& m__results;
+      };
+
+      bool dominated(unsigned iteration, double chiSq)
+      {
+          if(iteration < m__minIterations) {
+              return false;
+          }
+          lock_t lock(m__mutex);
+          return (chiSq > m__dominanceRatio*m__bestConverged);
+      }
+
+      void recordConverged(double chiSq)
+      {
+          lock_t lock(m__mutex);
+          m__bestConverged = std::min(m__bestConverged, chiSq);
+      }
+
+      bool sameMinimum(const dvector_t& a, const dvector_t& b) const
+      {
+          for(index_t j=0; j<N_PARAMETERS; ++j)
+          {
+              double diff = a[j] - b[j];
+              if(m__bounds.kind(j) == fortlib::ParamBounds::Periodic) {
+                  double period = m__bounds.upper(j) - m__bounds.lower(j);
+                  diff -= period*std::floor(diff/period + 0.5);
+              }
+              double scale = std::max(1.0, std::fabs(b[j]));
+              if(std::fabs(diff) > m__distinctTol*scale) {
+                  return false;
+              }
+          }
+          return true;
+      }
+
+      // Groups the converged starts by minimum, lowest chi^2 first, and
+      // finds the best start.
+      void collectMinima()
+      {
+          std::vector<unsigned> order;
+          order.reserve(m__results.size());
+          for(unsigned k=0; k<m__results.size(); ++k) {
+              if(m__results[k].status == fortlib::FitLM::Cancelled) {
+                  ++m__nCancelled;
+              }
+              if(converged(m__results[k].status)) {
+                  order.push_back(k);
+              }
+          }
+
+          if(order.empty()) {
+              // Nothing converged:  settle for the lowest chi^2.
+              for(unsigned k=0; k<m__results.size(); ++k) {
+                  order.push_back(k);
+              }
+              std::sort(order.begin(), order.end(), ByChiSq(m__results));
+              m__iBest = order.front();
+              return;
+          }
+
+          std::sort(order.begin(), order.end(), ByChiSq(m__results));
+          m__iBest = order.front();
+          dvector_t canonical;
+          for(unsigned a=0; a<order.size(); ++a)
+          {
+              StartResult& result(m__results[order[a]]);
+              canonical = result.params;
+              Model_t::canonicalParams(canonical);
+              for(unsigned m=0; m<m__minima.size(); ++m) {
+                  if(sameMinimum(canonical, m__canonical[m])) {
+                      result.minimum = m;
+                      ++m__minima[m].nStarts;
+                      break;
+                  }
+              }
+              if(result.minimum == NO_MINIMUM) {
+                  LocalMinimum newMinimum;
+                  newMinimum.params = result.params;
+                  newMinimum.chiSq = result.chiSq;
+                  newMinimum.nStarts = 1;
+                  result.minimum = m__minima.size();
+                  m__minima.push_back(newMinimum);
+                  m__canonical.push_back(canonical);
+              }
+          }
+      }
+  };
+  template<typename P>
+  const double MultiStartLM<P>::DEFAULT_DOMINANCE_RATIO=2.0;
+  template<typename P>
+  const double MultiStartLM<P>::DEFAULT_DISTINCT_TOL=1.0e-3;
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_MultiStartLM_H_
+/////////////////////////
+//
+// End
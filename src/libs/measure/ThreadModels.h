@@ -0,0 +1,93 @@
+// -*- C++ -*-
+// Header file for template class ThreadModels
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _ThreadModels_H_
+#define _ThreadModels_H_
+
+// Includes
+//
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include "jpw_nld.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace optimize {
+
+
+  // Class ThreadModels
+  /**
+   * One instance of a fit-function per thread of a \c ThreadTeam (or per
+   * island of an \c IslandGA).
+   *
+   * A \a FIT_FN may keep scratch storage, so concurrent calls to its \c
+   * chiSquared() each need an instance of their own.  Instance \c 0 is
+   * always the caller's.  The others are made with the \a FIT_FN's
+   * <tt>explicit FIT_FN(tslen_t nData)</tt> c'tor the first time they're
+   * needed, and reused by later calls to \c assign().
+   */
+  template<class FIT_FN>
+  class ThreadModels
+  {
+  public:
+      typedef FIT_FN Model_t;
+
+      /// Constructor
+      ThreadModels()
+          : m__models()
+          , m__owned()
+      {}
+
+      /// Sets up \a n instances, of which \a theModel is instance \c 0.
+      /**
+       * \param nData
+       * The size of the data, passed to the c'tor of any new instance.
+       */
+      void assign(unsigned n, Model_t& theModel, tslen_t nData)
+      {
+          m__models.resize(n);
+          m__models[0] = &theModel;
+          while(m__owned.size() + 1 < n) {
+              m__owned.push_back(boost::shared_ptr<Model_t>(
+                  new Model_t(nData) ));
+          }
+          for(unsigned i=1; i<n; ++i) {
+              m__models[i] = m__owned[i-1].get();
+          }
+      }
+
+      /// Instance \a i, as of the last call to \c assign().
+      Model_t& model(unsigned i) const
+      { return *m__models[i]; }
+
+  private:
+      std::vector<Model_t*> m__models;
+      // The instances made by assign().  Kept across calls.
+      std::vector< boost::shared_ptr<Model_t> > m__owned;
+  };
+
+
+ }; //end namespace optimize
+}; //end namespace jpw_nld
+
+
+#endif //_ThreadModels_H_
+/////////////////////////
+//
+// End
@@ -0,0 +1,298 @@
+// -*- C++ -*-
+// Implementation of class WarmStartIndex
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+WarmStartIndex_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include "WarmStartIndex.h"
+#include "nld_exceptions.h"
+#include "MathTools.h"
+
+#include "details/Matrix.tcc"
+
+
+using std::string;
+
+using namespace jpw_nld;
+using namespace jpw_nld::measure;
+
+
+//
+// Static variables
+//
+
+
+// First token of a saved index, and the version of the format.
+static const char* const FILE_TAG = "WarmStartIndex";
+static const unsigned FILE_VERSION = 1;
+
+
+//
+// Typedefs
+//
+
+
+/////////////////////////
+
+//
+// WarmStartIndex Member Functions
+//
+
+
+WarmStartIndex::WarmStartIndex(index_t nParams,
+                               size_type fingerprintBins,
+                               size_type capacity)
+    : m__nParams(nParams)
+    , m__fpBins(fingerprintBins)
+    , m__capacity(capacity)
+    , m__oldest(0)
+    , m__fingerprints()
+    , m__valid()
+    , m__params()
+    , m__chiSq()
+{}
+
+
+void WarmStartIndex::clear()
+{
+    m__oldest = 0;
+    m__fingerprints.clear();
+    m__valid.clear();
+    m__params.clear();
+    m__chiSq.clear();
+}
+
+
+void WarmStartIndex::fingerprint(const PersistenceMap& theMap,
+                                 dvector_t& fp,
+                                 std::vector<bool>& valid) const
+{
+    PersistenceMap coarse(m__fpBins);
+    coarse.downsample(theMap, m__fpBins);
+
+    const dvector_t& coarseData(coarse.as_1D());
+    valid = coarse.validMask();
+    fp.resize(coarseData.size());
+    for(size_type i=0; i<coarseData.size(); ++i) {
+        fp[i] = ( valid[i] ? coarseData[i] : 0.0 );
+    }
+}
+
+
+void WarmStartIndex::insert(const PersistenceMap& theMap,
+                            const dvector_t& params, double chiSq)
+{
+    if(params.size() != m__nParams) {
+        throw SizeMismatchError("WarmStartIndex::insert():  "
+                                "Wrong number of parameters.");
+    }
+
+    dvector_t fp;
+    std::vector<bool> valid;
+    fingerprint(theMap, fp, valid);
+
+    add(fp, valid, params, chiSq);
+}
+
+
+bool WarmStartIndex::nearest(const PersistenceMap& theMap,
+                             dvector_t& params, double& distance,
+                             double* chiSq) const
+{
+    if(m__chiSq.empty()) {
+        return false;
+    }
+
+    dvector_t fp;
+    std::vector<bool> valid;
+    fingerprint(theMap, fp, valid);
+    size_type fpSize = fp.size();
+
+    // Compares the mean square difference over the elements defined in
+    // both fingerprints.  An entry is abandoned once its partial sum is
+    // too large for any number of remaining elements to bring its mean
+    // below the best so far.
+    size_type iBest(0);
+    bool found(false);
+    double bestMeanSq = std::numeric_limits<double>::max();
+    const double* entryFp = &m__fingerprints[0];
+    for(size_type e=0; e<m__chiSq.size(); ++e, entryFp+=fpSize)
+    {
+        std::vector<bool>::const_iterator entryValid(m__valid.begin()
+                                                     + e*fpSize);
+        double sumSq(0.0);
+        size_type nCompared(0);
+        size_type i(0);
+        for(; i<fpSize; ++i)
+        {
+            if( !valid[i] || !entryValid[i] ) {
+                continue;
+            }
+            sumSq += jpw_math::SQR(entryFp[i] - fp[i]);
+            ++nCompared;
+            if(sumSq >= bestMeanSq*(nCompared + fpSize - i - 1)) {
+                break;
+            }
+        }
+        if( (i < fpSize) || !nCompared ) {
+            continue;
+        }
+        double meanSq = sumSq/nCompared;
+        if(!found || (meanSq < bestMeanSq)) {
+            bestMeanSq = meanSq;
+            iBest = e;
+            found = true;
+        }
+    }
+    if(!found) {
+        return false;
+    }
+
+    params.assign(m__params.begin() + iBest*m__nParams,
+                  m__params.begin() + (iBest + 1)*m__nParams);
+    distance = std::sqrt(bestMeanSq);
+    if(chiSq) {
+        *chiSq = m__chiSq[iBest];
+    }
+    return true;
+}
+
+
+void WarmStartIndex::save(const string& filename) const
+{
+    std::ofstream outFile(filename.c_str());
+    if(!outFile) {
+        throw FileNotFound("WarmStartIndex::save():  Can't open \""
+                           + filename + "\" for writing.");
+    }
+
+    size_type nEntries(size());
+    size_type fpSize(fingerprintSize());
+    outFile << FILE_TAG << ' ' << FILE_VERSION << ' ' << m__nParams << ' '
+            << m__fpBins << ' ' << nEntries << '\n'
+            << std::setprecision(std::numeric_limits<double>::digits10 + 2);
+
+    // Oldest entry first, so that a reload keeps the replacement order.
+    for(size_type k=0; k<nEntries; ++k)
+    {
+        size_type e = (m__oldest + k)%nEntries;
+        outFile << m__chiSq[e];
+        for(index_t j=0; j<m__nParams; ++j) {
+            outFile << ' ' << m__params[e*m__nParams + j];
+        }
+        for(size_type i=0; i<fpSize; ++i) {
+            outFile << ' ' << ( m__valid[e*fpSize + i]
+                                ? m__fingerprints[e*fpSize + i]
+                                : jpw_math::HUGE );
+        }
+        outFile << '\n';
+    }
+
+    if(!outFile) {
+        throw FileNotFound("WarmStartIndex::save():  Error writing \""
+                           + filename + "\".");
+    }
+}
+
+
+void WarmStartIndex::load(const string& filename)
+{
+    std::ifstream inFile(filename.c_str());
+    if(!inFile) {
+        throw FileNotFound("WarmStartIndex::load():  Can't open \""
+                           + filename + "\".");
+    }
+
+    string tag;
+    unsigned version(0);
+    index_t nParams(0);
+    size_type fpBins(0), nEntries(0);
+    inFile >> tag >> version >> nParams >> fpBins >> nEntries;
+    if( !inFile || (tag != FILE_TAG) || (version != FILE_VERSION) ) {
+        throw InvalidArgError("WarmStartIndex::load():  \"" + filename
+                              + "\" is not a saved WarmStartIndex.");
+    }
+    if( (nParams != m__nParams) || (fpBins != m__fpBins) ) {
+        throw InvalidArgError("WarmStartIndex::load():  The entries in \""
+                              + filename + "\" have the wrong size.");
+    }
+
+    clear();
+    size_type fpSize(fingerprintSize());
+    dvector_t fp(fpSize);
+    std::vector<bool> valid(fpSize, true);
+    dvector_t params(m__nParams);
+    for(size_type e=0; e<nEntries; ++e)
+    {
+        double chiSq(0.0);
+        inFile >> chiSq;
+        for(index_t j=0; j<m__nParams; ++j) {
+            inFile >> params[j];
+        }
+        for(size_type i=0; i<fpSize; ++i) {
+            // Undefined elements are saved as jpw_math::HUGE.
+            inFile >> fp[i];
+            if(fp[i] == jpw_math::HUGE) {
+                fp[i] = 0.0;
+                valid[i] = false;
+            } else {
+                valid[i] = true;
+            }
+        }
+        if(!inFile) {
+            clear();
+            throw InvalidArgError("WarmStartIndex::load():  \"" + filename
+                                  + "\" is truncated.");
+        }
+
+        add(fp, valid, params, chiSq);
+    }
+}
+
+
+// Appends an entry or, once at capacity, replaces the oldest one.
+void WarmStartIndex::add(const dvector_t& fp, const std::vector<bool>& valid,
+                         const dvector_t& params, double chiSq)
+{
+    if( !m__capacity || (size() < m__capacity) ) {
+        m__fingerprints.insert(m__fingerprints.end(), fp.begin(), fp.end());
+        m__valid.insert(m__valid.end(), valid.begin(), valid.end());
+        m__params.insert(m__params.end(), params.begin(), params.end());
+        m__chiSq.push_back(chiSq);
+        return;
+    }
+
+    std::copy(fp.begin(), fp.end(),
+              m__fingerprints.begin() + m__oldest*fp.size());
+    std::copy(valid.begin(), valid.end(),
+              m__valid.begin() + m__oldest*fp.size());
+    std::copy(params.begin(), params.end(),
+              m__params.begin() + m__oldest*m__nParams);
+    m__chiSq[m__oldest] = chiSq;
+    m__oldest = (m__oldest + 1)%m__capacity;
+}
+
+
+/////////////////////////
+//
+// End
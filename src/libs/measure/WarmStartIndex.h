@@ -0,0 +1,197 @@
+// -*- C++ -*-
+// Header file for class WarmStartIndex
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _WarmStartIndex_H_
+#define _WarmStartIndex_H_
+
+// Includes
+//
+#include <string>
+#include <vector>
+#include "jpw_nld.h"
+#include "PersistenceMap.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+ namespace measure {
+
+
+  // Class WarmStartIndex
+  /**
+   * A store of previously-fitted \c PersistenceMap objects, for finding
+   * initial parameters for new fits.
+   *
+   * In a rolling or ensemble workflow, consecutive maps are very similar,
+   * so a prior fit of a similar map is usually a better starting point than
+   * a fresh \c FitGA run.  Each entry holds a "fingerprint" of a map (a
+   * small, block-averaged copy of it; see \c PersistenceMap::downsample()),
+   * plus the parameters and \f$\chi^2\f$ fit to that map.
+   *
+   * \c nearest() finds the entry whose fingerprint is closest to that of a
+   * new map.  Typical use:
+   * \code
+   *   double distance;
+   *   if( !index.nearest(theMap, params, distance) ||
+   *       (distance > maxDistance) )
+   *   {
+   *       // ... run the FitGA, putting its best result into params ...
+   *   }
+   *   status = fitter(params, theMap, factor);
+   *   if(status is a success) {
+   *       index.insert(theMap, params, fitter.chiSquared());
+   *   }
+   * \endcode
+   *
+   * The distance between two fingerprints is the RMS difference of the
+   * elements defined in both, so it's in the same units as the persistence
+   * map.  (A fingerprint element is undefined when its whole block of the
+   * map is.)
+   *
+   * The search is a linear scan over a single contiguous array, abandoning
+   * each entry as soon as its partial distance exceeds the best so far.
+   * For the few-thousand entries of a typical run, this takes
+   * microseconds.  (The fingerprints have too many dimensions for a
+   * space-partitioning tree to do better.)
+   *
+   * \c save() and \c load() keep the index on disk between runs, as a
+   * text file.
+   */
+  class WarmStartIndex
+  {
+  public:
+      typedef PersistenceMap::size_type size_type;
+
+      /// The default number of bins along each side of a fingerprint.
+      static const size_type DEFAULT_FINGERPRINT_BINS=8;
+
+      /// Constructor
+      /**
+       * \param nParams
+       * The number of fitted parameters stored with each entry.
+       *
+       * \param fingerprintBins
+       * The fingerprints are \a fingerprintBins by \a fingerprintBins.
+       * Maps must have at least this many bins along each side.
+       *
+       * \param capacity
+       * The maximum number of entries.  Once full, each \c insert()
+       * replaces the oldest entry.  \c 0 means "no limit."
+       */
+      explicit WarmStartIndex(index_t nParams,
+                              size_type fingerprintBins
+                              =DEFAULT_FINGERPRINT_BINS,
+                              size_type capacity=0);
+
+      /// Destructor
+      ~WarmStartIndex() {}
+
+      /// The number of entries.
+      size_type size() const
+      { return m__chiSq.size(); }
+
+      /// The number of fitted parameters in each entry.
+      index_t nParams() const
+      { return m__nParams; }
+
+      /// The number of elements in each fingerprint.
+      size_type fingerprintSize() const
+      { return m__fpBins*m__fpBins; }
+
+      /// Remove all entries.
+      void clear();
+
+      /// Fills \a fp with the fingerprint of \a theMap.
+      /**
+       * Undefined elements of \a theMap (set to \c jpw_math::HUGE) don't
+       * contribute to the fingerprint.  \a valid is set to \c false for
+       * the elements of \a fp whose block was entirely undefined; those
+       * elements are set to 0.
+       */
+      void fingerprint(const PersistenceMap& theMap, dvector_t& fp,
+                       std::vector<bool>& valid) const;
+
+      /// Add an entry for \a theMap, fit by \a params.
+      /**
+       * \throws SizeMismatchError if \a params doesn't have \c nParams()
+       * elements.
+       */
+      void insert(const PersistenceMap& theMap, const dvector_t& params,
+                  double chiSq);
+
+      /// Find the entry closest to \a theMap.
+      /**
+       * \param params
+       * Set to the parameters of the closest entry.
+       *
+       * \param distance
+       * Set to the distance between the fingerprints of \a theMap and the
+       * closest entry.
+       *
+       * \param chiSq
+       * If not \c 0, set to the \f$\chi^2\f$ stored with the closest
+       * entry.
+       *
+       * \returns \c false, leaving the arguments unchanged, if the index is
+       * empty, or if none of its entries has a fingerprint element defined
+       * where that of \a theMap is.
+       */
+      bool nearest(const PersistenceMap& theMap, dvector_t& params,
+                   double& distance, double* chiSq=0) const;
+
+      /// Write the index to \a filename, replacing its contents.
+      /**
+       * \throws FileNotFound if \a filename can't be opened.
+       */
+      void save(const std::string& filename) const;
+
+      /// Replace the contents of this index with those of \a filename.
+      /**
+       * \throws FileNotFound if \a filename can't be opened.
+       * \throws InvalidArgError if \a filename isn't a saved index, or if
+       * its entries have a different size than this index's.
+       */
+      void load(const std::string& filename);
+
+  private:
+      index_t m__nParams;
+      size_type m__fpBins;
+      size_type m__capacity;
+      // Next entry to replace, once at capacity.
+      size_type m__oldest;
+      // The fingerprints, one after another.
+      dvector_t m__fingerprints;
+      // Whether each element of m__fingerprints is defined.
+      std::vector<bool> m__valid;
+      // The parameters, one set after another.
+      dvector_t m__params;
+      dvector_t m__chiSq;
+
+      void add(const dvector_t& fp, const std::vector<bool>& valid,
+               const dvector_t& params, double chiSq);
+  };
+
+
+ }; //end namespace
+}; //end namespace
+
+
+#endif //_WarmStartIndex_H_
+/////////////////////////
+//
+// End
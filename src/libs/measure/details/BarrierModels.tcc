@@ -23,7 +23,9 @@
 //
 
 #include <cstdlib>
+#include <cmath>
 #include "statistics.h"
+#include "PhiloxRNG.h"
 #include "PersistenceMap.h"
 
 
@@ -32,6 +34,55 @@ namespace jpw_nld {
 namespace measure {
 
 
+/////////////////////////
+
+//
+// BarrierModel<> Member Functions
+//
+
+
+// Builds the bounds of a model once, for use by limitParams().
+template<class MODEL_T>
+fortlib::ParamBounds
+modelParamBounds()
+{
+    fortlib::ParamBounds theBounds(MODEL_T::N_PARAMETERS);
+    MODEL_T::paramBounds(theBounds);
+    return theBounds;
+}
+
+
+template<typename MODEL_POLICY>
+inline double
+BarrierModel<MODEL_POLICY>::chiSquared(const PersistenceMap& theMap,
+                                       dvector_t& fitParams)
+{
+    m__wrkErrs.resize(theMap.size());
+    calculate<dvector_t>(theMap, fitParams, m__wrkErrs, m__wrkJac, 0,
+                         FitLM::ComputeFunction);
+    return jpw_math::chiSquared<dvector_t>(m__wrkErrs);
+}
+
+
+template<typename MODEL_POLICY>
+inline void
+BarrierModel<MODEL_POLICY>::randomParams(dvector_t& params)
+{
+    jpw_math::statistics::Rand48 rng;
+    randomParams(params, rng);
+}
+
+
+template<typename MODEL_POLICY>
+inline void
+BarrierModel<MODEL_POLICY>::limitParams(dvector_t& params)
+{
+    static const fortlib::ParamBounds
+        theBounds(modelParamBounds<BarrierModel>());
+    theBounds.project(params);
+}
+
+
 /////////////////////////
 
 //
@@ -44,40 +95,60 @@ namespace measure {
 
 
 template<>
-inline void
-BarrierModel<policy::Full>::randomParams(dvector_t& params)
+template<class RNG> inline void
+BarrierModel<policy::Full>::randomParams(dvector_t& params, RNG& rng)
 {
     // Beta (:==position);  Range: [0, 1]
-    params[0] = drand48();
+    params[0] = rng.uniform();
 
     // alpha = aCos(2A-1).  This does the same thing.
-    double tmprand = jpw_math::statistics::range_rand(1.0);
+    double tmprand = rng.range(1.0);
     params[1] = acos(tmprand);
 
     // Rho (:== scaled  tau);  Range:  (0, 10]
     // Range:  (0, 1]
     // Add on a small nonzero piece to avoid a singularity.
-    tmprand=0.999*drand48()+0.001;
+    tmprand=0.999*rng.uniform()+0.001;
     params[2] = scale_width(tmprand);
 
     // Rho (:== scaled  tau);  Range:  (0, 10]
     // Again, add on a small nonzero piece to avoid a singularity.
-    tmprand=9.999*drand48()+0.001;
+    tmprand=9.999*rng.uniform()+0.001;
     params[3] = scale_tau(tmprand);
 }
 
 
 template<>
 inline void
-BarrierModel<policy::Full>::limitParams(dvector_t& params)
+BarrierModel<policy::Full>::paramBounds(fortlib::ParamBounds& bounds)
 {
-    // The 3rd parameter in the persistence-map model is the scaled-width.
+    // Beta is a phase.
+    bounds.setPeriodic(0, 0.0, 1.0);
+
+    // The model only uses cos(alpha), so alpha is periodic, too.  (Don't
+    // bound it to [0, pi]:  the gradient vanishes at either end, and a fit
+    // pinned there would never leave.)
+    bounds.setPeriodic(1, 0.0, 2.0*M_PI);
+
     // The normal barrier width is restricted to the range, [-1, 1].  Since
     // the scaled width is based on 1/width, it must remain outside of this
-    // range or at the boundaries.
-    if( (-1.0 < params[2]) && (params[2] < 1.0) ) {
-        params[2] = 1.0;
-    }
+    // range or at the boundaries.  Its sign is irrelevant, so reflect it
+    // onto the positive branch.
+    bounds.setReflected(2, 1.0);
+
+    // The model only uses the square of the scaled tau, so it needs no
+    // bounds.
+}
+
+
+template<>
+inline void
+BarrierModel<policy::Full>::canonicalParams(dvector_t& params)
+{
+    params[1] = acos(cos(params[1]));
+    params[2] = fabs(params[2]);
+    params[3] = fabs(params[3]);
+    limitParams(params);
 }
 
 
@@ -86,23 +157,24 @@ template<typename VT> void
 BarrierModel<policy::Full>::calculate(const PersistenceMap& theMap,
                                       VT& fitParams,
                                       VT& deltas, VT& fnJacob,
-                                      int actionCode)
+                                      int ldJacob, int actionCode)
 {
     typedef PersistenceMap::size_type data_size_t;
     typedef PersistenceMap::const_vector_type const_vector_t;
 
-    // Aliases for the vectors underlying the theMap member matrices.
-    const_vector_t& theMapV_data = theMap.as_1D();
-    const_vector_t& theMapV_phases = theMap.phases_as_1D();
-    const_vector_t& theMapV_lags = theMap.lags_as_1D();
+    // The valid elements of theMap, and their axes:  the fit domain.
+    const_vector_t& theMapV_data = theMap.valid_as_1D();
+    const_vector_t& theMapV_phases = theMap.validPhases_as_1D();
+    const_vector_t& theMapV_lags = theMap.validLags_as_1D();
 
-    // Common setup.  Also limits parameter values.
+    // Common setup.  Beta is periodic; the fitters keep it in [0, 1), but
+    // other callers might not.  Wrap a copy, so that the caller's parameters
+    // are never altered.
     data_size_t nData = theMap.size();
 
-    if(fitParams[0] > 1.0) {
-        fitParams[0] = jpw_math::MOD_1(fitParams[0]);
-    } else if(fitParams[0] < 0.0) {
-        fitParams[0] = jpw_math::MOD_1(fitParams[0]) + 1.0;
+    double beta = fitParams[0];
+    if( (beta < 0.0) || (beta >= 1.0) ) {
+        beta -= floor(beta);
     }
     double width = jpw_math::SQR(fitParams[2]);
     double dwidth = 2*fitParams[2];
@@ -126,8 +198,8 @@ BarrierModel<policy::Full>::calculate(const PersistenceMap& theMap,
     {
         for(data_size_t i=0; i<nData; ++i)
         {
-            pmb = theMapV_phases[i] - fitParams[0];
-            pmlmb = theMapV_phases[i] - fitParams[0] - theMapV_lags[i];
+            pmb = theMapV_phases[i] - beta;
+            pmlmb = theMapV_phases[i] - beta - theMapV_lags[i];
 
             // Do the "dangling term" in the sum
             pmlmb_j = (pmlmb + ne_p1);
@@ -149,14 +221,14 @@ BarrierModel<policy::Full>::calculate(const PersistenceMap& theMap,
     // actionCode == "compute model deriv"
     if(actionCode == FitLM::ComputeJacobian)
     {
-        data_size_t offset1 = nData;
-        data_size_t offset2 = offset1 + nData;
-        data_size_t offset3 = offset2 + nData;
+        data_size_t offset1 = ldJacob;
+        data_size_t offset2 = offset1 + ldJacob;
+        data_size_t offset3 = offset2 + ldJacob;
 
         for(data_size_t i=0; i<nData; ++i)
         {
-            pmb = theMapV_phases[i] - fitParams[0];
-            pmlmb = theMapV_phases[i] - fitParams[0] - theMapV_lags[i];
+            pmb = theMapV_phases[i] - beta;
+            pmlmb = theMapV_phases[i] - beta - theMapV_lags[i];
             e_lrho = exp(-lrho*theMapV_lags[i]);
 
             // Do the "dangling term" in the sums
@@ -185,7 +257,7 @@ BarrierModel<policy::Full>::calculate(const PersistenceMap& theMap,
         } // end i
     } // end "compute model deriv"
 
-    ++m__callcount;
+    m__callcount.fetch_add(1, boost::memory_order_relaxed);
 }
 
 
@@ -201,19 +273,28 @@ BarrierModel<policy::Full>::calculate(const PersistenceMap& theMap,
 
 
 template<>
-inline void
-BarrierModel<policy::MarkovOnly>::randomParams(dvector_t& params)
+template<class RNG> inline void
+BarrierModel<policy::MarkovOnly>::randomParams(dvector_t& params, RNG& rng)
 {
     // Range:  (0, 10]
     // Add on a small nonzero piece to avoid a singularity.
-    params[0] = scale_tau(9.999*drand48()+0.001);
+    params[0] = scale_tau(9.999*rng.uniform()+0.001);
+}
+
+
+template<>
+inline void
+BarrierModel<policy::MarkovOnly>::paramBounds(fortlib::ParamBounds&)
+{
+    // Rho is only used squared, so it needs no bounds.
 }
 
 
 template<>
 inline void
-BarrierModel<policy::MarkovOnly>::limitParams(dvector_t&)
+BarrierModel<policy::MarkovOnly>::canonicalParams(dvector_t& params)
 {
+    params[0] = fabs(params[0]);
 }
 
 
@@ -222,14 +303,15 @@ template<typename VT> void
 BarrierModel<policy::MarkovOnly>::calculate(const PersistenceMap& theMap,
                                             VT& fitParams,
                                             VT& deltas, VT& fnJacob,
+                                            int /*ldJacob*/,
                                             int actionCode)
 {
     typedef PersistenceMap::size_type data_size_t;
     typedef PersistenceMap::const_vector_type const_vector_t;
 
-    // Aliases for the vectors underlying the theMap member matrices.
-    const_vector_t& theMapV_data = theMap.as_1D();
-    const_vector_t& theMapV_lags = theMap.lags_as_1D();
+    // The valid elements of theMap, and their axes:  the fit domain.
+    const_vector_t& theMapV_data = theMap.valid_as_1D();
+    const_vector_t& theMapV_lags = theMap.validLags_as_1D();
 
     // Common setup.  There is only one parameter for this model, rho.
     double lrho = jpw_math::SQR(fitParams[0]);
@@ -250,7 +332,7 @@ BarrierModel<policy::MarkovOnly>::calculate(const PersistenceMap& theMap,
         }
     }
 
-    ++m__callcount;
+    m__callcount.fetch_add(1, boost::memory_order_relaxed);
 }
 
 
@@ -266,28 +348,34 @@ BarrierModel<policy::MarkovOnly>::calculate(const PersistenceMap& theMap,
 
 
 template<>
-inline void
-BarrierModel<policy::BarrierOnly>::randomParams(dvector_t& params)
+template<class RNG> inline void
+BarrierModel<policy::BarrierOnly>::randomParams(dvector_t& params, RNG& rng)
 {
     // Beta (:==position);  Range: [0, 1]
-    params[0] = drand48();
+    params[0] = rng.uniform();
 
-    // Rho (:== scaled  tau);  Range:  (0, 10]
-    // Range:  (0, 1]
+    // Width;  Range:  (0, 1], before scaling.
     // Add on a small nonzero piece to avoid a singularity.
-    params[2] = scale_width(0.999*drand48()+0.001);
+    params[1] = scale_width(0.999*rng.uniform()+0.001);
 }
 
 
 template<>
 inline void
-BarrierModel<policy::BarrierOnly>::limitParams(dvector_t& params)
+BarrierModel<policy::BarrierOnly>::paramBounds(fortlib::ParamBounds& bounds)
 {
-    // This has the same implementation as the policy::Full specialization.
-    // It's small, so we'll hand-inline it.
-    if( (-1.0 < params[2]) && (params[2] < 1.0) ) {
-        params[2] = 1.0;
-    }
+    // Same as the policy::Full specialization, minus the Markov term.
+    bounds.setPeriodic(0, 0.0, 1.0);
+    bounds.setReflected(1, 1.0);
+}
+
+
+template<>
+inline void
+BarrierModel<policy::BarrierOnly>::canonicalParams(dvector_t& params)
+{
+    params[1] = fabs(params[1]);
+    limitParams(params);
 }
 
 
@@ -296,24 +384,23 @@ template<typename VT> void
 BarrierModel<policy::BarrierOnly>::calculate(const PersistenceMap& theMap,
                                              VT& fitParams,
                                              VT& deltas, VT& fnJacob,
-                                             int actionCode)
+                                             int ldJacob, int actionCode)
 {
     typedef PersistenceMap::size_type data_size_t;
     typedef PersistenceMap::const_vector_type const_vector_t;
 
-    // Aliases for the vectors underlying the theMap member matrices.
-    const_vector_t& theMapV_data = theMap.as_1D();
-    const_vector_t& theMapV_phases = theMap.phases_as_1D();
-    const_vector_t& theMapV_lags = theMap.lags_as_1D();
+    // The valid elements of theMap, and their axes:  the fit domain.
+    const_vector_t& theMapV_data = theMap.valid_as_1D();
+    const_vector_t& theMapV_phases = theMap.validPhases_as_1D();
+    const_vector_t& theMapV_lags = theMap.validLags_as_1D();
 
-    // Common setup.  Also limits parameter values.  (There are two parameters
-    // for this model:  beta and width.)
+    // Common setup.  (There are two parameters for this model:  beta and
+    // width.)  Beta is handled as in the policy::Full specialization.
     data_size_t nData = theMap.size();
 
-    if(fitParams[0] > 1.0) {
-        fitParams[0] = jpw_math::MOD_1(fitParams[0]);
-    } else if(fitParams[0] < 0.0) {
-        fitParams[0] = jpw_math::MOD_1(fitParams[0]) + 1.0;
+    double beta = fitParams[0];
+    if( (beta < 0.0) || (beta >= 1.0) ) {
+        beta -= floor(beta);
     }
     double width = jpw_math::SQR(fitParams[1]);
     double dwidth = 2*fitParams[1];
@@ -331,8 +418,8 @@ BarrierModel<policy::BarrierOnly>::calculate(const PersistenceMap& theMap,
     {
         for(data_size_t i=0; i<nData; ++i)
         {
-            pmb = theMapV_phases[i] - fitParams[0];
-            pmlmb = theMapV_phases[i] - fitParams[0] - theMapV_lags[i];
+            pmb = theMapV_phases[i] - beta;
+            pmlmb = theMapV_phases[i] - beta - theMapV_lags[i];
 
             // Do the "dangling term" in the sum
             pmlmb_j = (pmlmb + ne_p1);
@@ -353,12 +440,12 @@ BarrierModel<policy::BarrierOnly>::calculate(const PersistenceMap& theMap,
     // actionCode == "compute model deriv"
     if(actionCode == FitLM::ComputeJacobian)
     {
-        data_size_t offset1 = nData;
+        data_size_t offset1 = ldJacob;
 
         for(data_size_t i=0; i<nData; ++i)
         {
-            pmb = theMapV_phases[i] - fitParams[0];
-            pmlmb = theMapV_phases[i] - fitParams[0] - theMapV_lags[i];
+            pmb = theMapV_phases[i] - beta;
+            pmlmb = theMapV_phases[i] - beta - theMapV_lags[i];
 
             // Do the "dangling term" in the sums
             pmlmb_j = (pmlmb + ne_p1);
@@ -384,7 +471,7 @@ BarrierModel<policy::BarrierOnly>::calculate(const PersistenceMap& theMap,
         } // end i
     } // end "compute model deriv"
 
-    ++m__callcount;
+    m__callcount.fetch_add(1, boost::memory_order_relaxed);
 }
 
 
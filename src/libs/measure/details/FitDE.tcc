@@ -0,0 +1,246 @@
+// -*- C++ -*-
+// Implementation of class FitDE
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+//static const char* const
+//FitDE_cc__="RCS $Id$";
+#ifndef _FitDE_TCC_
+#define _FitDE_TCC_
+
+
+// Includes
+//
+
+#include <algorithm>
+#include "jpw_nld.h"
+#include "nld_exceptions.h"
+
+
+// Wrapper for parent namespace
+namespace jpw_nld {
+namespace optimize {
+
+
+// Convenience Macros for defining Template member functions.
+//
+#define TEMPL_M_FitDE template<class FIT_FN, class DATA_T>
+#define CT_M_FitDE FitDE<FIT_FN, DATA_T>
+
+
+//
+// Static Member Variables
+//
+
+
+TEMPL_M_FitDE
+const double CT_M_FitDE::DEFAULT_WEIGHT(0.5);
+
+
+TEMPL_M_FitDE
+const double CT_M_FitDE::DEFAULT_CROSSOVER(0.9);
+
+
+/////////////////////////
+
+//
+// Member Functions
+//
+
+
+TEMPL_M_FitDE
+const char* CT_M_FitDE::strategyName(Strategy_t strategy)
+{
+    static const char* const NAMES[N_STRATEGIES] = {
+        "rand/1", "best/1", "current-to-best/1"
+    };
+    return ( (strategy < N_STRATEGIES) ? NAMES[strategy] : "unknown" );
+}
+
+
+TEMPL_M_FitDE
+void CT_M_FitDE::initializePopulation(const FitData_t& theData,
+                                      Model_t& theModel,
+                                      const PhiloxRNG& rng)
+{
+    // One stream per member, as in FitGA::initializePopulation().
+    bool isQuasi(m__initialSampling != QuasiRandomSet::PseudoRandom);
+    if(isQuasi) {
+        m__initialSet.generate(m__initialSampling, m__popSize, N_PARAMETERS,
+                               rng.split(m__popSize));
+    }
+    for(unsigned k=0; k<m__popSize; ++k) {
+        if(isQuasi) {
+            jpw_math::statistics::QuasiPointRNG pointRng(m__initialSet, k,
+                                                         rng.split(k));
+            theModel.randomParams(m__wrkParams, pointRng);
+        } else {
+            PhiloxRNG memberRng(rng.split(k));
+            theModel.randomParams(m__wrkParams, memberRng);
+        }
+        std::copy(m__wrkParams.begin(), m__wrkParams.end(),
+                  &m__pop[k*N_PARAMETERS]);
+    }
+    evaluate(m__pop, m__chiPop, theData, theModel);
+}
+
+
+TEMPL_M_FitDE
+void CT_M_FitDE::makeTrials(unsigned best, const PhiloxRNG& rng)
+{
+    const double* xBest(&m__pop[best*N_PARAMETERS]);
+    for(unsigned i=0; i<m__popSize; ++i)
+    {
+        PhiloxRNG memberRng(rng.split(i));
+
+        // Three distinct members, none of them i.
+        unsigned r[3];
+        for(unsigned n=0; n<3; ++n) {
+            bool isRepeat;
+            do {
+                r[n] = memberRng.index(m__popSize);
+                isRepeat = (r[n] == i);
+                for(unsigned m=0; m<n; ++m) {
+                    isRepeat = ( isRepeat || (r[n] == r[m]) );
+                }
+            } while(isRepeat);
+        }
+        const double* x(&m__pop[i*N_PARAMETERS]);
+        const double* x1(&m__pop[r[0]*N_PARAMETERS]);
+        const double* x2(&m__pop[r[1]*N_PARAMETERS]);
+        const double* x3(&m__pop[r[2]*N_PARAMETERS]);
+
+        // Binomial crossover; parameter jMutant always comes from the
+        // mutant.
+        index_t jMutant(memberRng.index(N_PARAMETERS));
+        for(index_t j=0; j<N_PARAMETERS; ++j)
+        {
+            if( (j != jMutant) && (memberRng.uniform() >= m__crossover) ) {
+                m__wrkParams[j] = x[j];
+                continue;
+            }
+            switch(m__strategy)
+            {
+            case Best1:
+                m__wrkParams[j] = xBest[j] + m__weight*(x1[j] - x2[j]);
+                break;
+            case CurrentToBest1:
+                m__wrkParams[j] = ( x[j] + m__weight*(xBest[j] - x[j])
+                                    + m__weight*(x1[j] - x2[j]) );
+                break;
+            default:
+                m__wrkParams[j] = x1[j] + m__weight*(x2[j] - x3[j]);
+                break;
+            }
+        }
+        Model_t::limitParams(m__wrkParams);
+        std::copy(m__wrkParams.begin(), m__wrkParams.end(),
+                  &m__trials[i*N_PARAMETERS]);
+    }
+}
+
+
+TEMPL_M_FitDE
+void CT_M_FitDE::evaluate(const dvector_t& rows, dvector_t& chiSq,
+                          const FitData_t& theData, Model_t& theModel)
+{
+    m__functionEvals += m__popSize;
+    if(!m__team || (m__team->size() == 1)) {
+        for(unsigned i=0; i<m__popSize; ++i) {
+            const double* row(&rows[i*N_PARAMETERS]);
+            std::copy(row, row+N_PARAMETERS, m__wrkParams.begin());
+            chiSq[i] = theModel.chiSquared(theData, m__wrkParams);
+        }
+        return;
+    }
+
+    // As in FitGA::evaluate().
+    m__threadParams.resize(m__team->size(), m__wrkParams);
+    m__threadModels.assign(m__team->size(), theModel, theData.size());
+
+    EvalTask task(m__threadModels, m__threadParams, theData, rows, chiSq);
+    m__team->run(task, m__popSize);
+}
+
+
+TEMPL_M_FitDE
+unsigned CT_M_FitDE::bestMember() const
+{
+    return ( std::min_element(m__chiPop.begin(), m__chiPop.end())
+             - m__chiPop.begin() );
+}
+
+
+TEMPL_M_FitDE
+double CT_M_FitDE::operator()(dvector_t& param_min,
+                              const FitData_t& theData,
+                              Model_t& theModel)
+{
+    if( (m__popSize < 4) || (m__nGenerations < 1) ) {
+        throw InvalidArgError("FitDE::operator():  Needs a population of "
+                              "at least 4, and at least 1 generation.");
+    }
+
+    m__pop.resize(m__popSize*N_PARAMETERS);
+    m__trials.resize(m__popSize*N_PARAMETERS);
+    m__chiPop.resize(m__popSize);
+    m__chiTrials.resize(m__popSize);
+
+    // Stream 0 creates the initial population; stream k+1 makes the
+    // trials of generation k.
+    PhiloxRNG runRng( m__hasRandomStream ? m__rng
+                      : PhiloxRNG::fromRand48() );
+    m__functionEvals = 0;
+    m__generations = 0;
+    initializePopulation(theData, theModel, runRng.split(0));
+
+    unsigned best(bestMember());
+    while(m__generations < m__nGenerations)
+    {
+        makeTrials(best, runRng.split(m__generations+1));
+        evaluate(m__trials, m__chiTrials, theData, theModel);
+        for(unsigned i=0; i<m__popSize; ++i) {
+            if(m__chiTrials[i] <= m__chiPop[i]) {
+                std::copy(&m__trials[i*N_PARAMETERS],
+                          &m__trials[i*N_PARAMETERS] + N_PARAMETERS,
+                          &m__pop[i*N_PARAMETERS]);
+                m__chiPop[i] = m__chiTrials[i];
+            }
+        }
+        ++m__generations;
+
+        best = bestMember();
+        if( m__monitor && !(*m__monitor)(m__generations, m__chiPop[best],
+                                         &m__pop[best*N_PARAMETERS],
+                                         N_PARAMETERS) )
+        {
+            break;
+        }
+    }
+
+    param_min.resize(N_PARAMETERS);
+    std::copy(&m__pop[best*N_PARAMETERS],
+              &m__pop[best*N_PARAMETERS] + N_PARAMETERS, param_min.begin());
+    return m__chiPop[best];
+}
+
+
+// End namespace wrapper decls.
+}; //end namespace optimize
+}; //end namespace jpw_nld
+
+
+#endif //_FitDE_TCC_
+/////////////////////////
+//
+// End
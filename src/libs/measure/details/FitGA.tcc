@@ -22,14 +22,16 @@
 // Includes
 //
 
-#ifdef DEBUG_GA
 #include <iostream>
-#include "Manips.h"
-#endif
+#include <iomanip>
 #include <algorithm>
 #include <limits>
+#include <cmath>
+#include <functional>
 #include "jpw_nld.h"
-#include "FORTLib.h" // For namespace sort & ivector_t
+#include "nld_exceptions.h"
+#include "Manips.h"  // For TraceGA
+#include "ArgSort.h"
 #include "BarrierModels.h"
 
 #include "details/BarrierModels.tcc"
@@ -78,6 +80,10 @@ TEMPL_M_FitGA
 const double CT_M_FitGA::WIDE_XOVER_WEIGHT(WIDE_XOVER_WEIGHT_X_1000*0.001);
 
 
+TEMPL_M_FitGA
+const double CT_M_FitGA::DEFAULT_STALL_TOLERANCE(1.0e-6);
+
+
 /////////////////////////
 
 //
@@ -100,9 +106,7 @@ const double CT_M_FitGA::WIDE_XOVER_WEIGHT(WIDE_XOVER_WEIGHT_X_1000*0.001);
 
 template<bool F> struct TraceGA
 {
-    typedef vector<dvector_t> popVec_t;
-
-    TraceGA()
+    void Begin()
     {
         using namespace std;
         cout << endl << "Beginning minimization:" << endl << endl;
@@ -114,7 +118,7 @@ template<bool F> struct TraceGA
         cout << endl << endl;
     }
 
-    ~TraceGA()
+    void End()
     {
         this->BlankLines();
     }
@@ -135,14 +139,13 @@ template<bool F> struct TraceGA
              << "\trating=" << fixed << chiRating[i] << reset << endl;
     }
 
-    void ParamPop(const step_t i, const index_t n,
-                  const popVec_t& lastParamPop)
+    void ParamPop(const step_t i, const index_t n, const double* params)
     {
         using namespace std;
         using namespace outManips;
         cout << setw(2) << i << "::   " << setprecision(3) << scientific;
         for(step_t j=0; j<n; ++j) {
-            cout << lastParamPop[i][j] << "\t";
+            cout << params[j] << "\t";
         }
         cout << reset << endl;
     }
@@ -151,14 +154,12 @@ template<bool F> struct TraceGA
 
 template<> struct TraceGA<false>
 {
-    typedef vector<dvector_t> popVec_t;
-
-    TraceGA() {}
-    ~TraceGA() {}
+    void Begin() {}
+    void End() {}
     void BlankLines() {}
     void StartGeneration(const step_t) {}
     void CostRating(const step_t, const dvector_t&, const dvector_t&) {}
-    void ParamPop(const step_t, const index_t, const popVec_t&) {}
+    void ParamPop(const step_t, const index_t, const double*) {}
 };
 
 
@@ -172,23 +173,33 @@ template<> struct TraceGA<false>
 /////////////////////////
 
 //
-// FitGA::PopVecFiller Member Functions
+// FitGA::Population Member Functions
 //
 
 
 TEMPL_M_FitGA
-inline void
-CT_M_FitGA::PopVecFiller::operator()(popVec_t& populationVector)
+CT_M_FitGA::Population::Population(unsigned nMembers)
+    : params(nMembers*N_PARAMETERS, 0.0)
+    , order(nMembers)
 {
-    std::for_each(populationVector.begin(), populationVector.end(), *this);
+    for(unsigned i=0; i<nMembers; ++i) {
+        order[i] = i;
+    }
 }
 
 
 TEMPL_M_FitGA
-inline void
-CT_M_FitGA::PopVecFiller::operator()(dvector_t& val)
+inline void CT_M_FitGA::Population::get(unsigned i, dvector_t& dest) const
 {
-    std::fill(val.begin(), val.end(), 0.0);
+    const double* row(member(i));
+    std::copy(row, row+N_PARAMETERS, dest.begin());
+}
+
+
+TEMPL_M_FitGA
+inline void CT_M_FitGA::Population::set(unsigned i, const dvector_t& src)
+{
+    std::copy(src.begin(), src.begin()+N_PARAMETERS, member(i));
 }
 
 
@@ -200,129 +211,429 @@ CT_M_FitGA::PopVecFiller::operator()(dvector_t& val)
 
 
 TEMPL_M_FitGA
-void CT_M_FitGA::initializePopulation(popVec_t& ppop,
+const char* CT_M_FitGA::stopReasonName(StopReason_t reason)
+{
+    static const char* const NAMES[N_STOP_REASONS] = {
+        "max-generations", "monitor", "best-stalled", "mean-stalled",
+        "diversity-collapsed"
+    };
+    return ( (reason < N_STOP_REASONS) ? NAMES[reason] : "unknown" );
+}
+
+
+TEMPL_M_FitGA
+void CT_M_FitGA::initializePopulation(Population& ppop,
+                                      dvector_t& chiPop,
                                       const FitData_t& theData,
-                                      Model_t& theModel)
+                                      Model_t& theModel,
+                                      const PhiloxRNG& rng)
 {
-    for(step_t k=0; k<INITIAL_POPULATION_SIZE; ++k)
-    {
-        theModel.randomParams(m__wrkPop0[k]);
-        m__wrkChiPop0[k] = theModel.chiSquared(theData, m__wrkPop0[k]);
+    // One stream per member.  A quasi-random set takes the stream after
+    // the members'.
+    unsigned nInitial(initialPopulationSize());
+    bool isQuasi(m__initialSampling != QuasiRandomSet::PseudoRandom);
+    if(isQuasi) {
+        m__initialSet.generate(m__initialSampling, nInitial, N_PARAMETERS,
+                               rng.split(nInitial));
     }
+    for(step_t k=0; k<nInitial; ++k) {
+        if(isQuasi) {
+            QuasiPointRNG pointRng(m__initialSet, k, rng.split(k));
+            theModel.randomParams(m__wrkParams, pointRng);
+        } else {
+            PhiloxRNG memberRng(rng.split(k));
+            theModel.randomParams(m__wrkParams, memberRng);
+        }
+        m__wrkPop0.set(k, m__wrkParams);
+    }
+    evaluate(m__wrkPop0, m__wrkChiPop0, nInitial, theData, theModel);
 
-    // Get the sort indices for Chi^2, in ascending order.
-    // [N.B.:  sort::byIndex() erases its second arg.]
-    sort::byIndex(m__wrkChiPop0, m__wrkSortPop0, +1);
+    // The scale of diversity():  the spread of the random parameters.
+    if(m__minDiversity > 0.0) {
+        for(index_t j=0; j<N_PARAMETERS; ++j) {
+            m__diversityScale[j] = geneSpread(m__wrkPop0, nInitial, j);
+        }
+    }
 
-    // Sort according to best-fit, i.e. Chi^2.  Note that this is *not* the
-    // fitness-metric used by the GA proper.
-    for(step_t i=0; i<POPULATION_SIZE; ++i) {
-        ppop[i] = m__wrkPop0[m__wrkSortPop0[i]-1];
+    // Keep the populationSize() best, by Chi^2, in ascending order.  Note
+    // that this is *not* the fitness-metric used by the GA proper.
+    jpw_math::argTopK(m__wrkChiPop0, m__wrkSortPop0, m__popSize);
+    for(step_t i=0; i<m__popSize; ++i) {
+        const double* row(m__wrkPop0.member(m__wrkSortPop0[i]));
+        std::copy(row, row+N_PARAMETERS, ppop.member(i));
+        chiPop[i] = m__wrkChiPop0[m__wrkSortPop0[i]];
     }
 }
 
 
 TEMPL_M_FitGA
-void CT_M_FitGA::breedAndMutate(popVec_t& newpop,
-                                const popVec_t& oldpop,
-                                const dvector_t& ratingv)
+void CT_M_FitGA::breedAndMutate(Population& pop,
+                                dvector_t& newChiPop,
+                                const dvector_t& oldChiPop,
+                                const dvector_t& ratingv,
+                                const PhiloxRNG& rng)
 {
-    // Get the sort indices for the ratings, in descending order.
-    // [N.B.:  sort::byIndex() erases its second arg.]
+    // Select the nBreeding() best ratings, in descending order.  Only
+    // their order matters; the rest are replaced by children.
     //
     // NOTE:
     // The 'ratingv' is NOT Chi^2.  It's actually the normalized reciprocal of
     // Chi^2.  This is why we sort in descending order - the smallest Chi^2
     // produces the largest 'ratingv'.
-    sort::byIndex(ratingv, m__wrkSortChiSq, -1);
-
-    // Replicate the best ones.
-    for(step_t i=0; i<N_BREEDING; ++i) {
-        // FIXME:  The '-1' deals with FORTRAN-offset indices.  It won't be
-        // needed if we cut over to a C++ sorting routine.
-        newpop[i] = oldpop[m__wrkSortChiSq[i]-1];
+    unsigned nBreed(nBreeding());
+    jpw_math::argTopK(ratingv, m__wrkSortChiSq, nBreed,
+                      std::greater<double>());
+
+    // Reorder the population by rating.  Only the row indices move.  The
+    // best ones are replicated in place, and keep their Chi^2 unless
+    // mutated, below.  The rows of the rest are reused for the children.
+    for(step_t i=0; i<m__popSize; ++i) {
+        m__wrkOrder[i] = pop.order[m__wrkSortChiSq[i]];
+    }
+    pop.order.swap(m__wrkOrder);
+    for(step_t i=0; i<nBreed; ++i) {
+        newChiPop[i] = oldChiPop[m__wrkSortChiSq[i]];
+        m__isStale[i] = false;
     }
 
     // Now use crossover on the very best population members to produce the
-    // remaining new members.
-    double randa, oldx1, oldx2;
-    for(step_t i=N_BREEDING; i<POPULATION_SIZE; i+=2)
+    // remaining new members.  Each pair of children gets its own stream.
+    // The weights are drawn first, so that the crossover itself is a plain
+    // loop over the parameters.  With an odd number of children, the
+    // last pair only has room for its first.
+    double randa[N_PARAMETERS];
+    for(step_t i=nBreed; i<m__popSize; i+=2)
     {
-        index_t ri1 = randidx(N_BREEDING);
-        index_t ri2 = randidx(N_BREEDING);
+        PhiloxRNG pairRng(rng.split(i));
+        index_t ri1 = pairRng.index(nBreed);
+        index_t ri2 = pairRng.index(nBreed);
         for(index_t j=0; j<N_PARAMETERS; ++j) {
-            randa = drand48()*WIDE_XOVER_WEIGHT;
-            oldx1 = newpop[ri1][j];
-            oldx2 = newpop[ri2][j];
-            newpop[i][j] = randa*oldx1 + (1.0-randa)*oldx2;
-            newpop[i+1][j] = (1.0-randa)*oldx1 + randa*oldx2;
+            randa[j] = pairRng.uniform()*WIDE_XOVER_WEIGHT;
+        }
+
+        const double* oldx1(pop.member(ri1));
+        const double* oldx2(pop.member(ri2));
+        for(index_t j=0; j<N_PARAMETERS; ++j) {
+            m__wrkChild1[j] = randa[j]*oldx1[j] + (1.0-randa[j])*oldx2[j];
+            m__wrkChild2[j] = (1.0-randa[j])*oldx1[j] + randa[j]*oldx2[j];
+        }
+        Model_t::limitParams(m__wrkChild1);
+        pop.set(i, m__wrkChild1);
+        m__isStale[i] = true;
+        if(i+1 < m__popSize) {
+            Model_t::limitParams(m__wrkChild2);
+            pop.set(i+1, m__wrkChild2);
+            m__isStale[i+1] = true;
         }
-        Model_t::limitParams(newpop[i]);
-        Model_t::limitParams(newpop[i+1]);
     }
 
 
-    // Do N_MUTATE mutations per parameter, randomly picking the
-    // individual to mutate.  Make an exception for the top N_ELITE
+    // Do nMutate() mutations per parameter, randomly picking the
+    // individual to mutate.  Make an exception for the top nElite()
     // individuals, who never mutate.
-    for(step_t i=0; i<N_MUTATE; ++i)
+    unsigned nNonElite(m__popSize - m__nElite);
+    for(step_t i=0; i<m__nMutate; ++i)
     {
+        // The streams after the crossover ones.
+        PhiloxRNG mutantRng(rng.split(m__popSize + i));
         // Not a random individual, but a vector of mutation genes.
-        Model_t::randomParams(m__wrkMutantDNA);
+        Model_t::randomParams(m__wrkMutantDNA, mutantRng);
         // Instead of randomly picking the gene to mutate and somehow making
         // sure that we don't mutate the same gene twice, just pick an
         // individual for each gene and mutate that one gene.
         for(index_t j=0; j<N_PARAMETERS; ++j) {
-            index_t ri1 = randidx(N_NONELITE) + N_ELITE;
-            newpop[ri1][j] = m__wrkMutantDNA[j];
+            index_t ri1 = mutantRng.index(nNonElite) + m__nElite;
+            pop.member(ri1)[j] = m__wrkMutantDNA[j];
+            m__isStale[ri1] = true;
         }
     }
 }
 
 
 TEMPL_M_FitGA
-double CT_M_FitGA::operator()(dvector_t& parm_min,
-                              const FitData_t& theData,
-                              Model_t& theModel)
+void CT_M_FitGA::evaluate(const Population& pop, dvector_t& chiPop,
+                          unsigned n, const FitData_t& theData,
+                          Model_t& theModel, const vector<unsigned>* which)
 {
-    TraceGA<IS_DEBUG_GA_ON> debugMsg;
+    m__functionEvals += n;
+    if(!m__team || (m__team->size() == 1)) {
+        for(step_t i=0; i<n; ++i) {
+            step_t k( which ? (*which)[i] : i );
+            pop.get(k, m__wrkParams);
+            chiPop[k] = theModel.chiSquared(theData, m__wrkParams);
+        }
+        return;
+    }
+
+    // The model's chiSquared() takes a dvector_t; each thread copies the
+    // members it evaluates into its own.
+    m__threadParams.resize(m__team->size(), m__wrkParams);
+    m__threadModels.assign(m__team->size(), theModel, theData.size());
+
+    EvalTask task(m__threadModels, m__threadParams, theData, pop, chiPop,
+                  which);
+    m__team->run(task, n);
+}
 
-    // Clear the contents of a few members.  No need to touch m__LastParamPop;
-    // initializePopulation() will take care of that for you.
-    m__zeroingFunctor(m__NextParamPop);
-    initializePopulation(m__LastParamPop, theData, theModel);
 
-    double net_inv_chi;
-    for(step_t k=0; k<N_GENERATIONS-1; ++k)
+TEMPL_M_FitGA
+void CT_M_FitGA::evaluateStale(const Population& pop, dvector_t& chiPop,
+                               const FitData_t& theData, Model_t& theModel)
+{
+    m__staleIndex.clear();
+    for(unsigned i=0; i<m__popSize; ++i) {
+        if(m__isStale[i]) {
+            m__staleIndex.push_back(i);
+            m__isStale[i] = false;
+        }
+    }
+    if(!m__staleIndex.empty()) {
+        evaluate(pop, chiPop, m__staleIndex.size(), theData, theModel,
+                 &m__staleIndex);
+    }
+}
+
+
+TEMPL_M_FitGA
+void CT_M_FitGA::polishElite(Population& pop, dvector_t& chiPop,
+                             const FitData_t& theData)
+{
+    // The survivors are only roughly in order of chi^2, and the children
+    // not at all.
+    jpw_math::argTopK(chiPop, m__wrkRanks, m__nElite);
+
+    for(unsigned r=0; r<m__nElite; ++r)
     {
-        debugMsg.StartGeneration(k);
-        net_inv_chi = 0.0;
-        for(step_t i=0; i<POPULATION_SIZE; ++i) {
-            m__ChiPop[i] = theModel.chiSquared(theData, m__LastParamPop[i]);
-            net_inv_chi += 1.0/m__ChiPop[i];
-            debugMsg.ParamPop(i, N_PARAMETERS, m__LastParamPop);
+        unsigned i(m__wrkRanks[r]);
+        pop.get(i, m__wrkParams);
+        double chiSq((*m__localSearch)(m__wrkParams, chiPop[i], theData));
+        m__localSearchEvals += m__localSearch->functionEvals();
+        m__localSearchJacobians += m__localSearch->jacobianEvals();
+        if(chiSq < chiPop[i]) {
+            pop.set(i, m__wrkParams);
+            chiPop[i] = chiSq;
         }
-        debugMsg.BlankLines();
+    }
+}
+
+
+TEMPL_M_FitGA
+double CT_M_FitGA::geneSpread(const Population& pop, unsigned n, index_t j,
+                              const vector<unsigned>* which)
+{
+    m__wrkGene.resize(n);
+    for(unsigned i=0; i<n; ++i) {
+        m__wrkGene[i] = pop.member( which ? (*which)[i] : i )[j];
+    }
+    dvector_t::iterator mid(m__wrkGene.begin() + n/2);
+    std::nth_element(m__wrkGene.begin(), mid, m__wrkGene.end());
+    double median(*mid);
+    for(unsigned i=0; i<n; ++i) {
+        m__wrkGene[i] = std::fabs(m__wrkGene[i] - median);
+    }
+    std::nth_element(m__wrkGene.begin(), mid, m__wrkGene.end());
+    return *mid;
+}
+
+
+TEMPL_M_FitGA
+bool CT_M_FitGA::converged(step_t k, const dvector_t& chiPop,
+                           double chiSum, step_t best)
+{
+    double bestChi(chiPop[best]);
+    double meanChi(chiSum/m__popSize);
+    if( !k || (bestChi < (1.0 - m__stallTolerance)*m__bestRef) ) {
+        m__bestRef = bestChi;
+        m__bestImproved = k;
+    }
+    if( !k || (meanChi < (1.0 - m__stallTolerance)*m__meanRef) ) {
+        m__meanRef = meanChi;
+        m__meanImproved = k;
+    }
+
+    if( m__stallGenerations && (k - m__bestImproved >= m__stallGenerations) )
+    {
+        m__stopReason = BestStalled;
+        return true;
+    }
+    if( m__meanStallGenerations
+        && (k - m__meanImproved >= m__meanStallGenerations) )
+    {
+        m__stopReason = MeanStalled;
+        return true;
+    }
 
-        for(step_t i=0; i<POPULATION_SIZE; ++i) {
-            m__ChiRating[i] = 1.0/m__ChiPop[i]/net_inv_chi;
-            debugMsg.CostRating(i, m__ChiPop, m__ChiRating);
+    if(m__minDiversity > 0.0)
+    {
+        // The better half, by chi^2.  The rest are mostly children of
+        // crossover and mutants, which keep the spread up long after the
+        // GA has settled on a basin.
+        unsigned nBetter(nBreeding());
+        jpw_math::argTopK(chiPop, m__wrkRanks, nBetter);
+
+        // Parameters that the model never varies don't count.
+        double sum(0.0);
+        unsigned nScaled(0);
+        for(index_t j=0; j<N_PARAMETERS; ++j) {
+            if(m__diversityScale[j] > 0.0) {
+                sum += ( geneSpread(m__population, nBetter, j, &m__wrkRanks)
+                         / m__diversityScale[j] );
+                ++nScaled;
+            }
+        }
+        m__diversity = ( nScaled ? sum/nScaled : 1.0 );
+        if(m__diversity < m__minDiversity) {
+            m__stopReason = DiversityCollapsed;
+            return true;
         }
+    }
+    return false;
+}
+
+
+TEMPL_M_FitGA
+void CT_M_FitGA::begin(const dvector_t& params0, const FitData_t& theData,
+                       Model_t& theModel)
+{
+    if( (m__popSize < 4) || (m__nElite >= nBreeding())
+        || (m__nGenerations < 1) )
+    {
+        throw InvalidArgError("FitGA::begin():  Needs a population of at "
+                              "least 4, fewer elite than half of it, and "
+                              "at least 1 generation.");
+    }
+    unsigned nInitial(initialPopulationSize());
+    if(nInitial < m__popSize) {
+        throw InvalidArgError("FitGA::begin():  The initial population "
+                              "can't be smaller than the population.");
+    }
+
+    TraceGA<IS_DEBUG_GA_ON>().Begin();
+
+    if(m__capture) {
+        m__capture->begin(measure::FitCapture::GeneticAlgorithm,
+                          N_PARAMETERS, params0);
+        m__capture->recordData(theData);
+        m__capture->recordGASettings(m__popSize, m__nGenerations, m__nMutate,
+                                     m__nElite, WIDE_XOVER_WEIGHT_X_1000);
+        m__capture->recordGAStoppingRules(m__stallGenerations,
+                                          m__meanStallGenerations,
+                                          m__stallTolerance, m__minDiversity);
+        m__capture->recordGAInitialPopulation(m__initialPopSize,
+                                              m__initialSampling);
+    }
+
+    // Size the work space for the population sizes.  Each generation
+    // then reuses it.
+    if(m__wrkChiPop0.size() != nInitial)
+    {
+        m__wrkPop0 = Population(nInitial);
+        m__wrkChiPop0.resize(nInitial);
+        m__wrkSortPop0.resize(nInitial);
+        m__wrkGene.reserve(nInitial);
+    }
+    if(m__ChiPop.size() != m__popSize)
+    {
+        m__wrkSortChiSq.resize(m__popSize);
+        m__wrkOrder.resize(m__popSize);
+        m__wrkRanks.resize(m__popSize);
+        m__population = Population(m__popSize);
+        m__ChiPop.resize(m__popSize);
+        m__NextChiPop.resize(m__popSize);
+        m__ChiRating.resize(m__popSize);
+        m__isStale.resize(m__popSize);
+    }
+
+    // Stream 0 creates the initial population; stream k+1 breeds
+    // generation k.
+    m__runRng = ( m__hasRandomStream ? m__rng : PhiloxRNG::fromRand48() );
+    if(m__capture) {
+        m__capture->recordRandomStream(m__runRng.seed(), m__runRng.stream());
+    }
+
+    // No need to clear m__population; initializePopulation() will take care
+    // of that for you.
+    m__functionEvals = 0;
+    m__localSearchEvals = 0;
+    m__localSearchJacobians = 0;
+    m__generation = 0;
+    m__stopped = false;
+    m__stopReason = MaxGenerations;
+    m__diversity = 1.0;
+    std::fill(m__isStale.begin(), m__isStale.end(), false);
+    initializePopulation(m__population, m__ChiPop, theData, theModel,
+                         m__runRng.split(0));
+}
+
+
+TEMPL_M_FitGA
+bool CT_M_FitGA::step(const FitData_t& theData, Model_t& theModel)
+{
+    // The final generation is evaluated by end(), unless the monitor or a
+    // stopping rule stopped the minimization.
+    if( m__stopped || (m__generation >= m__nGenerations-1) ) {
+        return false;
+    }
+
+    TraceGA<IS_DEBUG_GA_ON> debugMsg;
+    step_t k(m__generation);
+    debugMsg.StartGeneration(k);
+    evaluateStale(m__population, m__ChiPop, theData, theModel);
+    if( m__localSearch && m__localSearchInterval
+        && ((k+1) % m__localSearchInterval == 0) )
+    {
+        polishElite(m__population, m__ChiPop, theData);
+    }
+    double net_inv_chi = 0.0;
+    double chiSum = 0.0;
+    for(step_t i=0; i<m__popSize; ++i) {
+        net_inv_chi += 1.0/m__ChiPop[i];
+        chiSum += m__ChiPop[i];
+        debugMsg.ParamPop(i, N_PARAMETERS, m__population.member(i));
+    }
+    debugMsg.BlankLines();
 
-        breedAndMutate(m__NextParamPop, m__LastParamPop, m__ChiRating);
+    for(step_t i=0; i<m__popSize; ++i) {
+        m__ChiRating[i] = 1.0/m__ChiPop[i]/net_inv_chi;
+        debugMsg.CostRating(i, m__ChiPop, m__ChiRating);
+    }
 
-        // Lastly, swap the objects containing the "old" and "new" members,
-        // which disposes of the old population vector without
-        // deallocating/reallocating.
-        m__LastParamPop.swap(m__NextParamPop);
-    } // for(k ...)
+    step_t best = ( std::min_element(m__ChiPop.begin(), m__ChiPop.end())
+                    - m__ChiPop.begin() );
+    if( m__monitor && !(*m__monitor)(k+1, m__ChiPop[best],
+                                     m__population.member(best),
+                                     N_PARAMETERS) )
+    {
+        m__stopped = true;
+        m__stopReason = MonitorStopped;
+        return false;
+    }
+    if(converged(k, m__ChiPop, chiSum, best)) {
+        m__stopped = true;
+        return false;
+    }
 
+    // Breeds the next generation in place.
+    breedAndMutate(m__population, m__NextChiPop, m__ChiPop,
+                   m__ChiRating, m__runRng.split(k+1));
+    m__ChiPop.swap(m__NextChiPop);
+    ++m__generation;
+    return (m__generation < m__nGenerations-1);
+}
+
+
+TEMPL_M_FitGA
+double CT_M_FitGA::end(dvector_t& parm_min, const FitData_t& theData,
+                       Model_t& theModel)
+{
     // At the very end, search for the population minimum.
+    if(!m__stopped) {
+        evaluateStale(m__population, m__ChiPop, theData, theModel);
+    }
     double min_chi = numeric_limits<double>::max();
     step_t n = 0;
-    for(step_t i=0; i<POPULATION_SIZE; ++i)
+    for(step_t i=0; i<m__popSize; ++i)
     {
-        m__ChiPop[i] = theModel.chiSquared(theData, m__LastParamPop[i]);
         if(m__ChiPop[i] < min_chi) {
             min_chi = m__ChiPop[i];
             n = i;
@@ -331,11 +642,63 @@ double CT_M_FitGA::operator()(dvector_t& parm_min,
 
     // Return the most-successful member of the population and its
     // corresponding Chi^2
-    parm_min = m__LastParamPop[n];
+    step_t nGenerations(m__generation + 1);
+    parm_min.resize(N_PARAMETERS);
+    m__population.get(n, parm_min);
+    if(m__monitor && !m__stopped) {
+        (*m__monitor)(nGenerations, min_chi, &parm_min[0], N_PARAMETERS);
+    }
+    if(m__capture) {
+        m__capture->finish(m__stopReason, min_chi, parm_min, nGenerations,
+                           m__functionEvals);
+    }
+    TraceGA<IS_DEBUG_GA_ON>().End();
     return(min_chi);
 }
 
 
+TEMPL_M_FitGA
+double CT_M_FitGA::operator()(dvector_t& parm_min,
+                              const FitData_t& theData,
+                              Model_t& theModel)
+{
+    begin(parm_min, theData, theModel);
+    while(step(theData, theModel)) {
+    }
+    return end(parm_min, theData, theModel);
+}
+
+
+TEMPL_M_FitGA
+void CT_M_FitGA::emigrants(unsigned n, popVec_t& params,
+                           dvector_t& chiSq) const
+{
+    n = std::min(n, m__nElite);
+    params.resize(n);
+    chiSq.resize(n);
+    for(unsigned i=0; i<n; ++i) {
+        params[i].resize(N_PARAMETERS);
+        m__population.get(i, params[i]);
+        chiSq[i] = m__ChiPop[i];
+    }
+}
+
+
+TEMPL_M_FitGA
+void CT_M_FitGA::immigrate(const popVec_t& params, const dvector_t& chiSq)
+{
+    // Replace the last children of crossover.
+    unsigned n = std::min<unsigned>(params.size(),
+                                    m__popSize - nBreeding());
+    for(unsigned i=0; i<n; ++i) {
+        unsigned slot(m__popSize - 1 - i);
+        m__population.set(slot, params[i]);
+        m__ChiPop[slot] = chiSq[i];
+        m__isStale[slot] = false;
+    }
+}
+
+
 // End namespace wrapper decls.
 }; //end namespace optimize
 }; //end namespace jpw_nld
@@ -20,8 +20,11 @@ PersistenceMap_cc__="RCS $Id: PersistenceMap.cc 1887 2009-10-13 20:05:57Z candid
 // Includes
 //
 #include <iostream>
+#include <istream>
+#include <ostream>
 #include <string>
 #include <stdexcept>
+#include <vector>
 #include "PersistenceMap.h"
 
 #include "details/Matrix.tcc"
@@ -49,6 +52,68 @@ using namespace jpw_nld::measure;
 //
 
 
+//
+// Local Functions
+//
+
+
+namespace {
+
+  // Sets each element of 'coarse' to the mean of the corresponding block of
+  // 'fine', skipping elements set to jpw_math::HUGE.  'rowStart' and
+  // 'colStart' hold the first row (column) of each block, plus an end
+  // marker.
+  void blockAverage(const dmatrix_t& fine,
+                    const std::vector<tslen_t>& rowStart,
+                    const std::vector<tslen_t>& colStart,
+                    dmatrix_t& coarse)
+  {
+      for(tslen_t ic=0; ic<coarse.nRows(); ++ic) {
+          for(tslen_t jc=0; jc<coarse.nColumns(); ++jc)
+          {
+              double sum(0.0);
+              tslen_t nUsed(0);
+              for(tslen_t i=rowStart[ic]; i<rowStart[ic+1]; ++i) {
+                  for(tslen_t j=colStart[jc]; j<colStart[jc+1]; ++j) {
+                      if(fine[i][j] != jpw_math::HUGE) {
+                          sum += fine[i][j];
+                          ++nUsed;
+                      }
+                  }
+              }
+              coarse[ic][jc] = ( nUsed ? sum/nUsed : jpw_math::HUGE );
+          }
+      }
+  }
+
+  // Fills 'starts' with the first of each of 'nBlocks' nearly-equal blocks
+  // of 'n' elements, followed by 'n'.
+  void blockStarts(tslen_t n, tslen_t nBlocks, std::vector<tslen_t>& starts)
+  {
+      starts.resize(nBlocks + 1);
+      for(tslen_t k=0; k<=nBlocks; ++k) {
+          starts[k] = (k*n)/nBlocks;
+      }
+  }
+
+  // The binary form of a Matrix's elements.  The dimensions are written
+  // once, by PersistenceMap::write().
+  void writeElements(std::ostream& ost, const dmatrix_t& m)
+  {
+      const dmatrix_t::vector_type& v(m.as_1D());
+      ost.write(reinterpret_cast<const char*>(&v[0]),
+                v.size()*sizeof(double));
+  }
+
+  bool readElements(std::istream& ist, dmatrix_t::vector_type& v)
+  {
+      ist.read(reinterpret_cast<char*>(&v[0]), v.size()*sizeof(double));
+      return static_cast<bool>(ist);
+  }
+
+} // end anon. namespace
+
+
 /////////////////////////
 
 //
@@ -131,6 +196,99 @@ void PersistenceMap::fillAxes()
             m__lags[i][j] = l;
         }
     }
+    compactDomain();
+}
+
+
+void PersistenceMap::downsample(const PersistenceMap& fine,
+                                size_type n_rows, size_type n_columns)
+{
+    if(!n_columns) {
+        n_columns = n_rows;
+    }
+    if( (n_rows > fine.nRows()) || (n_columns > fine.nColumns()) ||
+        !n_rows )
+    {
+        throw std::length_error("Fatal Error Invoking "
+                                "PersistenceMap::downsample():  \n"
+                                "\tCannot downsample to a larger map.\n");
+    }
+
+    if( (m__map.nRows() != n_rows) || (m__map.nColumns() != n_columns) ) {
+        m__map.clear(n_rows, n_columns);
+        m__phases.clear(n_rows, n_columns);
+        m__lags.clear(n_rows, n_columns);
+        m__cs_avg.clear(n_rows, n_columns);
+        m__cs_stddev.clear(n_rows, n_columns);
+    }
+
+    std::vector<tslen_t> rowStart;
+    std::vector<tslen_t> colStart;
+    blockStarts(fine.nRows(), n_rows, rowStart);
+    blockStarts(fine.nColumns(), n_columns, colStart);
+
+    blockAverage(fine.m__map, rowStart, colStart, m__map);
+    blockAverage(fine.m__phases, rowStart, colStart, m__phases);
+    blockAverage(fine.m__lags, rowStart, colStart, m__lags);
+    blockAverage(fine.m__cs_avg, rowStart, colStart, m__cs_avg);
+    blockAverage(fine.m__cs_stddev, rowStart, colStart, m__cs_stddev);
+    compactDomain();
+
+    m__computedCSStats = fine.m__computedCSStats;
+    m__computedPersistence = fine.m__computedPersistence;
+}
+
+
+bool PersistenceMap::write(std::ostream& ost) const
+{
+    size_type dims[2] = { nRows(), nColumns() };
+    unsigned char flags[2] = { m__computedCSStats, m__computedPersistence };
+    ost.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+    ost.write(reinterpret_cast<const char*>(flags), sizeof(flags));
+
+    writeElements(ost, m__map);
+    writeElements(ost, m__phases);
+    writeElements(ost, m__lags);
+    writeElements(ost, m__cs_avg);
+    writeElements(ost, m__cs_stddev);
+    return static_cast<bool>(ost);
+}
+
+
+bool PersistenceMap::read(std::istream& ist)
+{
+    size_type dims[2] = { 0, 0 };
+    unsigned char flags[2] = { 0, 0 };
+    ist.read(reinterpret_cast<char*>(dims), sizeof(dims));
+    ist.read(reinterpret_cast<char*>(flags), sizeof(flags));
+    if(!ist || !dims[0] || !dims[1]) {
+        return false;
+    }
+
+    // Read everything before touching the members.
+    static const unsigned N_MATRICES(5);
+    std::vector<dmatrix_t::vector_type> elements(N_MATRICES);
+    for(unsigned k=0; k<N_MATRICES; ++k) {
+        elements[k].resize(dims[0]*dims[1]);
+        if(!readElements(ist, elements[k])) {
+            return false;
+        }
+    }
+
+    dmatrix_t* members[N_MATRICES] = { &m__map, &m__phases, &m__lags,
+                                       &m__cs_avg, &m__cs_stddev };
+    for(unsigned k=0; k<N_MATRICES; ++k) {
+        if( (members[k]->nRows() != dims[0]) ||
+            (members[k]->nColumns() != dims[1]) )
+        {
+            members[k]->clear(dims[0], dims[1]);
+        }
+        members[k]->swap(elements[k]);
+    }
+    compactDomain();
+    m__computedCSStats = flags[0];
+    m__computedPersistence = flags[1];
+    return true;
 }
 
 
@@ -273,10 +431,44 @@ void PersistenceMap::computePersistence(const dmatrix_t& ts_data, bool reset)
         } // j
     } // i
 
+    compactDomain();
     m__computedPersistence = true;
 }
 
 
+void PersistenceMap::compactDomain()
+{
+    const dmatrix_t::vector_type& mapV(m__map.as_1D());
+    m__validMask.resize(mapV.size());
+    m__validIndex.clear();
+    for(size_type k=0; k<mapV.size(); ++k) {
+        m__validMask[k] = (mapV[k] != jpw_math::HUGE);
+        if(m__validMask[k]) {
+            m__validIndex.push_back(k);
+        }
+    }
+
+    if(allValid()) {
+        // Free the copies left by an earlier map.
+        dvector_t().swap(m__validData);
+        dvector_t().swap(m__validPhases);
+        dvector_t().swap(m__validLags);
+        return;
+    }
+
+    const dmatrix_t::vector_type& phasesV(m__phases.as_1D());
+    const dmatrix_t::vector_type& lagsV(m__lags.as_1D());
+    m__validData.resize(m__validIndex.size());
+    m__validPhases.resize(m__validIndex.size());
+    m__validLags.resize(m__validIndex.size());
+    for(size_type k=0; k<m__validIndex.size(); ++k) {
+        m__validData[k] = mapV[m__validIndex[k]];
+        m__validPhases[k] = phasesV[m__validIndex[k]];
+        m__validLags[k] = lagsV[m__validIndex[k]];
+    }
+}
+
+
 /////////////////////////
 //
 // End
@@ -22,6 +22,8 @@
 //
 //..//#include <cmath>
 //..//#include <vector>
+#include <iosfwd>
+#include <vector>
 #include <boost/utility.hpp>
 #include "jpw_nld.h"
 #include "Matrix.h"
@@ -52,6 +54,13 @@ namespace jpw_nld {
    *
    * Inherits measure-related constants from \c BarrierMeasure
    *
+   * Elements of the map where the persistence is undefined are set to \c
+   * jpw_math::HUGE, and are "invalid."  Every member function that changes
+   * the map also updates the validity mask and the compacted index of the
+   * valid elements.  The fit domain, seen by \c FitLM_Adapter and the \c
+   * BarrierModel, consists of the valid elements only.  See \c size() and
+   * \c valid_as_1D().
+   *
    * Note:  At present, the internal algorithms for computing the persistence
    * assume that you are generating a square map.  If you call the c'tor, \c
    * wipe() or \c clear() functions with a number of columns different from
@@ -102,8 +111,12 @@ namespace jpw_nld {
           fillAxes();
       }
 
-      /// Required by the \c FitLM_Adapter.
-      size_type size() const { return m__map.size(); }
+      /// The number of valid elements:  the size of the fit domain.
+      /**
+       * Required by the \c FitLM_Adapter.  Equal to
+       * <tt>nRows()*nColumns()</tt> unless some elements are invalid.
+       */
+      size_type size() const { return m__validIndex.size(); }
 
       /// The number of columns in the 3 member containers.
       /**
@@ -122,7 +135,7 @@ namespace jpw_nld {
       /// Fills the \c m__phases and \c m__lags member containers.
       /**
        * Reallocates both if they don't have the same dimensions as the \c
-       * m__map container.
+       * m__map container.  Also rebuilds the compacted fit domain.
        */
       void fillAxes();
 
@@ -145,6 +158,8 @@ namespace jpw_nld {
           m__map.swap(other);
           if(sizeChanged) {
               fillAxes();
+          } else {
+              compactDomain();
           }
           m__computedCSStats = false;
           m__computedPersistence = false;
@@ -248,6 +263,8 @@ namespace jpw_nld {
           m__cs_stddev.wipe(n_rows, n_columns);
           if(sizeChanged) {
               fillAxes();
+          } else {
+              compactDomain();
           }
           m__computedCSStats = false;
           m__computedPersistence = false;
@@ -279,6 +296,49 @@ namespace jpw_nld {
           fillAxes();
       }
 
+      /// Replace this map with a block-averaged copy of \a fine.
+      /**
+       * Resizes this object to \a n_rows by \a n_columns (which is set to
+       * \a n_rows if omitted or 0), then sets each element to the mean of
+       * the corresponding block of elements in \a fine.  Elements of \a
+       * fine set to \c jpw_math::HUGE (where the persistence was undefined)
+       * are left out of the means.  The cyclostationary mean and standard
+       * deviation are averaged the same way.
+       *
+       * The phase \& lag axes are block-averaged, too, so each coarse
+       * element sits at the center of its block.  Don't call \c fillAxes()
+       * afterwards.  [N.B.:  \c swap_map(), \c wipe() and \c clear() all
+       * do, if they change the map's dimensions.]
+       *
+       * When the dimensions of \a fine aren't a multiple of the new
+       * dimensions, the blocks differ in size by at most one element.
+       *
+       * \throws std::length_error if the new dimensions are larger than
+       * those of \a fine.
+       */
+      void downsample(const PersistenceMap& fine,
+                      size_type n_rows, size_type n_columns=0);
+
+      /// Write this object to \a ost in a compact binary form.
+      /**
+       * Writes all of the member \c Matrix objects, including the phase
+       * \& lag axes, so that \c read() can restore an exact copy, even of
+       * a downsampled map.  The doubles are written in the machine's byte
+       * order.
+       *
+       * \returns \c false if the stream reported an error.
+       */
+      bool write(std::ostream& ost) const;
+
+      /// Replace this object with one written by \c write().
+      /**
+       * Resizes this object, if needed.
+       *
+       * \returns \c false, leaving this object unchanged, if \a ist
+       * reported an error or ended too soon.
+       */
+      bool read(std::istream& ist);
+
       /// Accessor method.
       /**
        * \returns the persistence map data
@@ -301,17 +361,52 @@ namespace jpw_nld {
       { return m__cs_stddev; }
 
       /// Returns the persistence map as a flat sequence.
-      const_vector_type as_1D() const
+      const_vector_type& as_1D() const
       { return m__map.as_1D(); }
 
       /// Returns the phase-axis matrix as a flat sequence.
-      const_vector_type phases_as_1D() const
+      const_vector_type& phases_as_1D() const
       { return m__phases.as_1D(); }
 
       /// Returns the lag-axis matrix as a flat sequence.
-      const_vector_type lags_as_1D() const
+      const_vector_type& lags_as_1D() const
       { return m__lags.as_1D(); }
 
+      /// \c true unless element <tt>[i][j]</tt> of the persistence map is
+      /// undefined.
+      bool isValid(size_type i, size_type j) const
+      { return m__validMask[i*nColumns() + j]; }
+
+      /// The validity of each element, in the same order as \c as_1D().
+      const std::vector<bool>& validMask() const
+      { return m__validMask; }
+
+      /// The positions in \c as_1D() of the valid elements, in order.
+      /**
+       * Element \c k of \c valid_as_1D(), \c validPhases_as_1D() and \c
+       * validLags_as_1D() comes from element <tt>validIndex()[k]</tt> of
+       * the full sequences.
+       */
+      const std::vector<size_type>& validIndex() const
+      { return m__validIndex; }
+
+      /// Returns the valid elements of the persistence map as a flat
+      /// sequence of \c size() elements.
+      /**
+       * This is the data that the \c BarrierModel fits.  When every
+       * element is valid, this is just \c as_1D().
+       */
+      const_vector_type& valid_as_1D() const
+      { return (allValid() ? m__map.as_1D() : m__validData); }
+
+      /// The phases of the elements in \c valid_as_1D().
+      const_vector_type& validPhases_as_1D() const
+      { return (allValid() ? m__phases.as_1D() : m__validPhases); }
+
+      /// The lags of the elements in \c valid_as_1D().
+      const_vector_type& validLags_as_1D() const
+      { return (allValid() ? m__lags.as_1D() : m__validLags); }
+
       /// Exception class for persistence computations.
       /**
        * Thrown if you ...
@@ -339,8 +434,26 @@ namespace jpw_nld {
       bool m__computedCSStats;
       /// Flag to track whether or not m__map has been filled in.
       bool m__computedPersistence;
+      /// \c false where \c m__map is \c jpw_math::HUGE.
+      std::vector<bool> m__validMask;
+      /// Positions of the valid elements in \c m__map.as_1D().
+      std::vector<size_type> m__validIndex;
+      /// The valid elements of \c m__map, \c m__phases and \c m__lags.
+      /// Empty when every element is valid.
+      dvector_t m__validData;
+      dvector_t m__validPhases;
+      dvector_t m__validLags;
+
+      /// Rebuilds the validity mask and the compacted fit domain.
+      /**
+       * Call after any change to \c m__map or to the axes.
+       */
+      void compactDomain();
 
   private:
+      bool allValid() const
+      { return (m__validIndex.size() == m__map.size()); }
+
       bool hasBadDimensions(const dmatrix_t& tsdata)
       {
           return( (tsdata.nColumns() != m__map.nColumns()) ||
@@ -0,0 +1,256 @@
+// -*- C++ -*-
+// Header file for the argsort and top-K selection functions.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _ArgSort_H_
+#define _ArgSort_H_
+
+// Includes
+//
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include "ThreadTeam.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_math {
+
+ /// \name Argsort and Top-K Selection
+ /// These sort or select the indices of a random-access container of
+ /// values, leaving the values themselves alone.
+ ///
+ /// Each sets \a order, a random-access container of an integral type
+ /// (e.g. a <tt>std::vector\<unsigned\></tt>), to a permutation of the
+ /// 0-based indices of \a values.  \a values only needs \c size() and \c
+ /// operator[]; \a order also needs \c resize() and iterators.
+ ///
+ /// \a comp orders the values, as for \c std::sort(); the default is
+ /// ascending.  Equal values are ordered by index, so the results are the
+ /// same as for a stable sort, and don't depend on the algorithm used.
+ /// @{
+
+ /// Inputs with at least this many values are worth splitting across a
+ /// \c ThreadTeam.
+ static const std::size_t ARG_TOPK_PARALLEL_MIN_SIZE=32768;
+
+
+ namespace argsort_details {
+
+  /// Orders indices by \a comp on their values, then by index.
+  template<class VALUES_T, class COMPARE_T>
+  struct IndexCompare
+  {
+      IndexCompare(const VALUES_T& values, COMPARE_T comp)
+          : m__values(values)
+          , m__comp(comp)
+      {}
+
+      template<class INDEX_T>
+      bool operator()(INDEX_T a, INDEX_T b) const
+      {
+          if(m__comp(m__values[a], m__values[b])) {
+              return true;
+          }
+          if(m__comp(m__values[b], m__values[a])) {
+              return false;
+          }
+          return (a < b);
+      }
+
+      const VALUES_T& m__values;
+      COMPARE_T m__comp;
+  };
+
+
+  /// Sets \a order to the indices of \a values, in their original order.
+  template<class VALUES_T, class ORDER_T>
+  void identity(const VALUES_T& values, ORDER_T& order)
+  {
+      typedef typename ORDER_T::value_type index_t;
+      std::size_t n(values.size());
+      order.resize(n);
+      for(std::size_t i=0; i<n; ++i) {
+          order[i] = static_cast<index_t>(i);
+      }
+  }
+
+
+  /// Moves the best \a k of [\a first, \a last) to its front, in order.
+  template<class ITER_T, class INDEX_COMPARE_T>
+  void topK(ITER_T first, ITER_T last, std::size_t k,
+            const INDEX_COMPARE_T& indexComp)
+  {
+      std::size_t n(last - first);
+      if(k < n) {
+          std::nth_element(first, first+k, last, indexComp);
+      } else {
+          k = n;
+      }
+      std::sort(first, first+k, indexComp);
+  }
+
+
+  /// Runs \c topK() on one chunk of the indices per task.
+  template<class ITER_T, class INDEX_COMPARE_T>
+  struct ChunkTask : public jpw_nld::ThreadTeam::Task
+  {
+      ChunkTask(ITER_T first, std::size_t n, std::size_t nChunks,
+                std::size_t k, const INDEX_COMPARE_T& indexComp)
+          : m__first(first)
+          , m__n(n)
+          , m__nChunks(nChunks)
+          , m__k(k)
+          , m__indexComp(indexComp)
+      {}
+
+      std::size_t chunkBegin(unsigned i) const
+      { return (m__n*i)/m__nChunks; }
+
+      void operator()(unsigned i, unsigned)
+      {
+          topK(m__first + chunkBegin(i), m__first + chunkBegin(i+1), m__k,
+               m__indexComp);
+      }
+
+      ITER_T m__first;
+      std::size_t m__n;
+      std::size_t m__nChunks;
+      std::size_t m__k;
+      const INDEX_COMPARE_T& m__indexComp;
+  };
+
+ }; //end namespace argsort_details
+
+
+ /// Puts the indices of the \a k best \a values first in \a order, in
+ /// order.
+ /**
+  * The other indices follow, in no particular order.  Takes
+  * \f$O(n + k \log k)\f$ time, by \c std::nth_element() and \c
+  * std::sort() of the first \a k.  \a k may exceed <tt>values.size()</tt>;
+  * then all of \a order is sorted.
+  */
+ template<class VALUES_T, class ORDER_T, class COMPARE_T>
+ void argTopK(const VALUES_T& values, ORDER_T& order, std::size_t k,
+              COMPARE_T comp)
+ {
+     argsort_details::identity(values, order);
+     argsort_details::topK(order.begin(), order.end(), k,
+                           argsort_details::IndexCompare<VALUES_T, COMPARE_T>(
+                               values, comp));
+ }
+
+
+ /// As above, on the threads of \a team.
+ /**
+  * If \a team has more than one thread and \a values has at least \c
+  * ARG_TOPK_PARALLEL_MIN_SIZE entries, each thread selects the best \a k
+  * of one chunk of \a values, and the best \a k of those are selected
+  * serially.  Otherwise, this is the serial version.  The result is the
+  * same either way.
+  *
+  * Link with <tt>$(THREAD_LIBS)</tt> when using this overload.
+  */
+ template<class VALUES_T, class ORDER_T, class COMPARE_T>
+ void argTopK(const VALUES_T& values, ORDER_T& order, std::size_t k,
+              COMPARE_T comp, jpw_nld::ThreadTeam& team)
+ {
+     typedef argsort_details::IndexCompare<VALUES_T, COMPARE_T> IndexComp_t;
+     typedef typename ORDER_T::iterator Iter_t;
+
+     std::size_t n(values.size());
+     std::size_t nChunks(team.size());
+     if( (nChunks < 2) || (n < ARG_TOPK_PARALLEL_MIN_SIZE)
+         || (k*nChunks >= n) )
+     {
+         argTopK(values, order, k, comp);
+         return;
+     }
+
+     argsort_details::identity(values, order);
+     IndexComp_t indexComp(values, comp);
+     argsort_details::ChunkTask<Iter_t, IndexComp_t>
+         task(order.begin(), n, nChunks, k, indexComp);
+     team.run(task, nChunks);
+
+     // Swap the best of each chunk down to the front, then select from
+     // them.  Chunk i starts at or after i*k, since each chunk holds more
+     // than k indices.  Swapping one at a time, in order, also handles a
+     // destination that overlaps its source.
+     for(unsigned i=1; i<nChunks; ++i) {
+         Iter_t dest(order.begin() + i*k);
+         Iter_t src(order.begin() + task.chunkBegin(i));
+         for(std::size_t j=0; j<k; ++j) {
+             std::iter_swap(dest+j, src+j);
+         }
+     }
+     argsort_details::topK(order.begin(), order.begin() + nChunks*k, k,
+                           indexComp);
+ }
+
+
+ /// As above, in ascending order of \a values.
+ template<class VALUES_T, class ORDER_T>
+ void argTopK(const VALUES_T& values, ORDER_T& order, std::size_t k)
+ {
+     argTopK(values, order, k, std::less<typename VALUES_T::value_type>());
+ }
+
+
+ /// Sorts the indices of all of \a values into \a order.
+ template<class VALUES_T, class ORDER_T, class COMPARE_T>
+ void argSort(const VALUES_T& values, ORDER_T& order, COMPARE_T comp)
+ { argTopK(values, order, values.size(), comp); }
+
+
+ /// As above, in ascending order of \a values.
+ template<class VALUES_T, class ORDER_T>
+ void argSort(const VALUES_T& values, ORDER_T& order)
+ {
+     argTopK(values, order, values.size(),
+             std::less<typename VALUES_T::value_type>());
+ }
+
+
+ /// Puts the indices of the \a k best \a values first in \a order, in no
+ /// particular order.
+ /**
+  * Takes \f$O(n)\f$ time, by \c std::nth_element().  Use it when only
+  * membership in the best \a k matters.
+  */
+ template<class VALUES_T, class ORDER_T, class COMPARE_T>
+ void argPartition(const VALUES_T& values, ORDER_T& order, std::size_t k,
+                   COMPARE_T comp)
+ {
+     argsort_details::identity(values, order);
+     if(k < values.size()) {
+         std::nth_element(order.begin(), order.begin()+k, order.end(),
+                          argsort_details::IndexCompare<VALUES_T, COMPARE_T>(
+                              values, comp));
+     }
+ }
+
+ /// @}
+
+}; //end namespace jpw_math
+
+
+#endif //_ArgSort_H_
+/////////////////////////
+//
+// End
@@ -0,0 +1,193 @@
+// -*- C++ -*-
+// Implementation of class PhiloxRNG
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+PhiloxRNG_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <cstdlib>
+#include "PhiloxRNG.h"
+#include "statistics.h"
+
+
+using namespace jpw_math::statistics;
+
+
+//
+// Static variables
+//
+
+
+// The Philox-4x32 multipliers and Weyl-sequence key increments.
+static const PhiloxRNG::word_t PHILOX_M0 = 0xD2511F53;
+static const PhiloxRNG::word_t PHILOX_M1 = 0xCD9E8D57;
+static const PhiloxRNG::word_t PHILOX_W0 = 0x9E3779B9;
+static const PhiloxRNG::word_t PHILOX_W1 = 0xBB67AE85;
+
+// XOR'ed into the key when deriving a stream number in split(), so that
+// the derived numbers aren't also blocks of output.
+static const PhiloxRNG::word_t SPLIT_TWEAK0 = 0x5851F42D;
+static const PhiloxRNG::word_t SPLIT_TWEAK1 = 0x4C957F2D;
+
+
+//
+// Typedefs
+//
+
+
+typedef PhiloxRNG::word_t word_t;
+typedef PhiloxRNG::seed_t seed_t;
+
+
+/////////////////////////
+
+//
+// Local Functions
+//
+
+
+namespace {
+
+  inline void mulhilo(word_t a, word_t b, word_t& hi, word_t& lo)
+  {
+      seed_t product = static_cast<seed_t>(a)*b;
+      hi = static_cast<word_t>(product >> 32);
+      lo = static_cast<word_t>(product);
+  }
+
+} // end anon. namespace
+
+
+/////////////////////////
+
+//
+// PhiloxRNG Member Functions
+//
+
+
+PhiloxRNG::PhiloxRNG(seed_t seed, seed_t stream)
+    : m__stream(stream)
+    , m__position(0)
+    , m__nUsed(N_WORDS)
+{
+    m__key[0] = static_cast<word_t>(seed);
+    m__key[1] = static_cast<word_t>(seed >> 32);
+}
+
+
+PhiloxRNG::PhiloxRNG(const std::string& seedStr, seed_t stream)
+    : m__stream(stream)
+    , m__position(0)
+    , m__nUsed(N_WORDS)
+{
+    // parseSeed() leaves its outputs alone for an empty string.
+    std::string parsed(seedStr);
+    unsigned seedLo(0), seedHi(0);
+    parseSeed(parsed, seedLo, seedHi);
+    m__key[0] = seedLo;
+    m__key[1] = seedHi;
+}
+
+
+PhiloxRNG PhiloxRNG::fromRand48()
+{
+    seed_t hi(static_cast<seed_t>(drand48()*4294967296.0));
+    seed_t lo(static_cast<seed_t>(drand48()*4294967296.0));
+    return PhiloxRNG((hi << 32) | lo);
+}
+
+
+PhiloxRNG PhiloxRNG::split(seed_t index) const
+{
+    word_t key[2] = { m__key[0] ^ SPLIT_TWEAK0, m__key[1] ^ SPLIT_TWEAK1 };
+    word_t counter[N_WORDS] = {
+        static_cast<word_t>(index), static_cast<word_t>(index >> 32),
+        static_cast<word_t>(m__stream),
+        static_cast<word_t>(m__stream >> 32)
+    };
+    block(counter, key);
+
+    PhiloxRNG child(*this);
+    child.m__stream = ( (static_cast<seed_t>(counter[1]) << 32)
+                        | counter[0] );
+    child.m__position = 0;
+    child.m__nUsed = N_WORDS;
+    return child;
+}
+
+
+void PhiloxRNG::block(word_t counter[4], const word_t key[2])
+{
+    word_t k0(key[0]), k1(key[1]);
+    for(unsigned r=0; r<N_ROUNDS; ++r)
+    {
+        if(r) {
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+        word_t hi0, lo0, hi1, lo1;
+        mulhilo(PHILOX_M0, counter[0], hi0, lo0);
+        mulhilo(PHILOX_M1, counter[2], hi1, lo1);
+        word_t c1(counter[1]), c3(counter[3]);
+        counter[0] = hi1 ^ c1 ^ k0;
+        counter[1] = lo1;
+        counter[2] = hi0 ^ c3 ^ k1;
+        counter[3] = lo0;
+    }
+}
+
+
+void PhiloxRNG::refill()
+{
+    m__block[0] = static_cast<word_t>(m__position);
+    m__block[1] = static_cast<word_t>(m__position >> 32);
+    m__block[2] = static_cast<word_t>(m__stream);
+    m__block[3] = static_cast<word_t>(m__stream >> 32);
+    block(m__block, m__key);
+    ++m__position;
+    m__nUsed = 0;
+}
+
+
+/////////////////////////
+
+//
+// Rand48 Member Functions
+//
+
+
+double Rand48::uniform()
+{
+    return drand48();
+}
+
+
+index_t Rand48::index(index_t nn)
+{
+    return randidx(nn);
+}
+
+
+double Rand48::range(double del)
+{
+    return range_rand(del);
+}
+
+
+/////////////////////////
+//
+// End
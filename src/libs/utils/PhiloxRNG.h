@@ -0,0 +1,170 @@
+// -*- C++ -*-
+// Header file for class PhiloxRNG
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _PhiloxRNG_H_
+#define _PhiloxRNG_H_
+
+// Includes
+//
+#include <string>
+#include <boost/cstdint.hpp>
+#include "jpw_nld.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_math {
+ namespace statistics {
+  // Using decls.
+  //
+  using jpw_nld::index_t;
+
+
+  // Class PhiloxRNG
+  /**
+   * A counter-based pRNG:  Philox-4x32-10, from Salmon et al., "Parallel
+   * Random Numbers:  As Easy as 1, 2, 3" (SC11).
+   *
+   * Each block of four 32-bit random words is a keyed hash of a 128-bit
+   * counter.  The key is the 64-bit seed.  The counter holds the 64-bit
+   * number of a stream, plus the position within that stream.  So there's
+   * no hidden state to share:  any number of streams can be drawn from at
+   * once, in any order, and each gives the same numbers every time.
+   *
+   * \c split() derives a new, independent stream from this one and an
+   * index.  Use it to give each thread, task, or individual its own
+   * stream, e.g. <tt>rng.split(generation).split(individual)</tt>.
+   *
+   * The member functions \c uniform(), \c index() and \c range() mirror \c
+   * drand48(), \c randidx() and \c range_rand(), respectively.  \c
+   * Rand48 offers the same three over \c drand48(), for code that takes
+   * either kind of generator as a template parameter.
+   *
+   * Uses the compiler-generated copy-c'tor and assignment operator.  A copy
+   * continues from the same position, independently of the original.
+   */
+  class PhiloxRNG
+  {
+  public:
+      typedef boost::uint32_t word_t;
+      typedef boost::uint64_t seed_t;
+
+      /// The number of rounds of the Philox bijection.
+      static const unsigned N_ROUNDS=10;
+
+      /// Constructor
+      /**
+       * Starts at the beginning of stream \a stream.
+       */
+      explicit PhiloxRNG(seed_t seed=0, seed_t stream=0);
+
+      /// Constructor taking the seed as a hexadecimal string.
+      /**
+       * \a seedStr has the format accepted by \c parseSeed().  Unlike \c
+       * init_rand(), all 64 bits of the seed are used.
+       *
+       * \throws std::runtime_error if \a seedStr isn't a hex number.
+       */
+      explicit PhiloxRNG(const std::string& seedStr, seed_t stream=0);
+
+      /// A generator seeded from the \c drand48() pRNG.
+      /**
+       * Gives reproducible results after \c init_rand() with a fixed
+       * seed.
+       */
+      static PhiloxRNG fromRand48();
+
+      /// The seed (i.e. the key).
+      seed_t seed() const
+      { return ( (static_cast<seed_t>(m__key[1]) << 32) | m__key[0] ); }
+
+      /// The stream number.
+      seed_t stream() const
+      { return m__stream; }
+
+      /// The number of blocks drawn from the stream so far.
+      seed_t position() const
+      { return m__position; }
+
+      /// A new generator, at the start of a stream derived from this
+      /// stream and \a index.
+      /**
+       * The result doesn't depend on how much of this stream has been
+       * used.  Distinct indices give independent streams.
+       */
+      PhiloxRNG split(seed_t index) const;
+
+      /// A uniform random number in [0, 1), with 53 random bits.
+      double uniform()
+      {
+          if(m__nUsed >= N_WORDS) {
+              refill();
+          }
+          double hi(m__block[m__nUsed] >> 5);
+          double lo(m__block[m__nUsed+1] >> 6);
+          m__nUsed += 2;
+          return ( (hi*67108864.0 + lo)*(1.0/9007199254740992.0) );
+      }
+
+      /// A random index from 0 to \a nn-1.
+      index_t index(index_t nn)
+      { return static_cast<index_t>(uniform()*nn); }
+
+      /// A uniform random number in the range [-\a del, \a del].
+      double range(double del)
+      { return ( del*(2.0*uniform() - 1.0) ); }
+
+      /// Computes one Philox-4x32-10 block.
+      /**
+       * Replaces the 4 words of \a counter with their hash, under the 2
+       * words of \a key.
+       */
+      static void block(word_t counter[4], const word_t key[2]);
+
+  private:
+      static const unsigned N_WORDS=4;
+
+      word_t m__key[2];
+      seed_t m__stream;
+      seed_t m__position;
+      word_t m__block[N_WORDS];
+      unsigned m__nUsed;
+
+      void refill();
+  };
+
+
+  // Class Rand48
+  /**
+   * The \c PhiloxRNG interface, over the process-wide \c drand48() pRNG.
+   */
+  struct Rand48
+  {
+      double uniform();
+      index_t index(index_t nn);
+      double range(double del);
+  };
+
+
+ }; //end namespace statistics
+}; //end namespace jpw_math
+
+
+#endif //_PhiloxRNG_H_
+/////////////////////////
+//
+// End
@@ -0,0 +1,221 @@
+// -*- C++ -*-
+// Implementation of class QuasiRandomSet
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+QuasiRandom_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <algorithm>
+#include <sstream>
+#include <boost/cstdint.hpp>
+#include "nld_exceptions.h"
+#include "QuasiRandom.h"
+
+
+using namespace jpw_math::statistics;
+
+
+//
+// Static variables
+//
+
+
+// The Halton bases:  the first MAX_DIMS primes.
+static const unsigned HALTON_BASES[QuasiRandomSet::MAX_DIMS] = {
+    2, 3, 5, 7, 11, 13, 17, 19
+};
+
+// The Sobol direction numbers for coordinates 1 and up, from Joe & Kuo's
+// "new-joe-kuo-6.21201" table:  the degree, s, of the primitive
+// polynomial; its coefficients, a; and the initial m_1 ... m_s.
+// Coordinate 0 is the van der Corput sequence, which needs no table.
+struct SobolInit
+{
+    unsigned s;
+    unsigned a;
+    unsigned m[5];
+};
+static const SobolInit SOBOL_INITS[QuasiRandomSet::MAX_DIMS-1] = {
+    { 1, 0, { 1 } },
+    { 2, 1, { 1, 3 } },
+    { 3, 1, { 1, 3, 1 } },
+    { 3, 2, { 1, 1, 1 } },
+    { 4, 1, { 1, 1, 3, 3 } },
+    { 4, 4, { 1, 3, 5, 13 } },
+    { 5, 2, { 1, 1, 5, 5, 17 } }
+};
+
+// The number of bits in each Sobol coordinate.
+static const unsigned SOBOL_BITS=32;
+
+static const char* const METHOD_NAMES[QuasiRandomSet::N_METHODS] = {
+    "pseudo-random",
+    "Halton",
+    "Sobol",
+    "Latin hypercube"
+};
+
+
+//
+// Typedefs
+//
+
+
+typedef boost::uint32_t word_t;
+
+
+/////////////////////////
+
+//
+// QuasiRandomSet Member Functions
+//
+
+
+const char* QuasiRandomSet::methodName(Method_t method)
+{
+    if(method < N_METHODS) {
+        return METHOD_NAMES[method];
+    }
+    return "unknown";
+}
+
+
+void QuasiRandomSet::generate(Method_t method, unsigned nPoints,
+                              unsigned nDims, PhiloxRNG rng)
+{
+    if(nDims > MAX_DIMS) {
+        std::ostringstream msg;
+        msg << "QuasiRandomSet::generate():  At most " << MAX_DIMS
+            << " coordinates are supported, not " << nDims << '.';
+        throw jpw_nld::InvalidArgError(msg.str());
+    }
+
+    m__method = method;
+    m__nPoints = nPoints;
+    m__nDims = nDims;
+    m__coords.resize(nPoints*nDims);
+
+    switch(method)
+    {
+    case Halton:
+        makeHalton(rng);
+        break;
+    case Sobol:
+        makeSobol(rng);
+        break;
+    case LatinHypercube:
+        makeLatinHypercube(rng);
+        break;
+    default:
+        for(unsigned i=0; i<m__coords.size(); ++i) {
+            m__coords[i] = rng.uniform();
+        }
+        break;
+    }
+}
+
+
+void QuasiRandomSet::makeHalton(PhiloxRNG& rng)
+{
+    for(unsigned d=0; d<m__nDims; ++d)
+    {
+        double shift(rng.uniform());
+        double invBase(1.0/HALTON_BASES[d]);
+        for(unsigned k=0; k<m__nPoints; ++k)
+        {
+            // The radical inverse of k.
+            double x(0.0), scale(invBase);
+            for(unsigned n=k; n; n /= HALTON_BASES[d]) {
+                x += (n % HALTON_BASES[d])*scale;
+                scale *= invBase;
+            }
+            x += shift;
+            if(x >= 1.0) {
+                x -= 1.0;
+            }
+            m__coords[k*m__nDims + d] = x;
+        }
+    }
+}
+
+
+void QuasiRandomSet::makeSobol(PhiloxRNG& rng)
+{
+    word_t v[SOBOL_BITS];
+    for(unsigned d=0; d<m__nDims; ++d)
+    {
+        // The direction numbers, v_j = m_j/2^j, as SOBOL_BITS-bit
+        // fractions.
+        if(d == 0) {
+            for(unsigned j=0; j<SOBOL_BITS; ++j) {
+                v[j] = word_t(1) << (SOBOL_BITS-1-j);
+            }
+        } else {
+            const SobolInit& init(SOBOL_INITS[d-1]);
+            for(unsigned j=0; j<init.s; ++j) {
+                v[j] = init.m[j] << (SOBOL_BITS-1-j);
+            }
+            for(unsigned j=init.s; j<SOBOL_BITS; ++j)
+            {
+                v[j] = v[j-init.s] ^ (v[j-init.s] >> init.s);
+                for(unsigned i=1; i<init.s; ++i) {
+                    if( (init.a >> (init.s-1-i)) & 1 ) {
+                        v[j] ^= v[j-i];
+                    }
+                }
+            }
+        }
+
+        word_t shift(static_cast<word_t>(rng.uniform()*4294967296.0));
+        for(unsigned k=0; k<m__nPoints; ++k)
+        {
+            word_t x(shift);
+            unsigned j(0);
+            for(unsigned n=k; n; n >>= 1, ++j) {
+                if(n & 1) {
+                    x ^= v[j];
+                }
+            }
+            m__coords[k*m__nDims + d] = x*(1.0/4294967296.0);
+        }
+    }
+}
+
+
+void QuasiRandomSet::makeLatinHypercube(PhiloxRNG& rng)
+{
+    std::vector<unsigned> slices(m__nPoints);
+    double width(1.0/m__nPoints);
+    for(unsigned d=0; d<m__nDims; ++d)
+    {
+        // A random order of the slices:  Fisher-Yates.
+        for(unsigned k=0; k<m__nPoints; ++k) {
+            slices[k] = k;
+        }
+        for(unsigned k=m__nPoints; k>1; --k) {
+            std::swap(slices[k-1], slices[rng.index(k)]);
+        }
+        for(unsigned k=0; k<m__nPoints; ++k) {
+            m__coords[k*m__nDims + d] = (slices[k] + rng.uniform())*width;
+        }
+    }
+}
+
+
+/////////////////////////
+//
+// End
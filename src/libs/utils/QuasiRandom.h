@@ -0,0 +1,183 @@
+// -*- C++ -*-
+// Header file for classes QuasiRandomSet and QuasiPointRNG
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _QuasiRandom_H_
+#define _QuasiRandom_H_
+
+// Includes
+//
+#include <vector>
+#include "jpw_nld.h"
+#include "PhiloxRNG.h"
+
+
+// Enclosing namespace
+//
+namespace jpw_math {
+ namespace statistics {
+  // Using decls.
+  //
+  using jpw_nld::index_t;
+
+
+  // Class QuasiRandomSet
+  /**
+   * A set of points that cover the unit hypercube more evenly than
+   * independent random points do.  Meant for seeding a search, e.g. the
+   * initial population of \c optimize::FitGA.
+   *
+   * The methods are:
+   * - \c PseudoRandom:  independent uniform points.  For comparison.
+   * - \c Halton:  the radical inverse of the point's number, in the first
+   *   \c nDims() primes.
+   * - \c Sobol:  Sobol's sequence, with the direction numbers of Joe &
+   *   Kuo, "Constructing Sobol sequences with better two-dimensional
+   *   projections", SIAM J. Sci. Comput. 30, 2635 (2008).
+   * - \c LatinHypercube:  each coordinate has exactly one point in each of
+   *   \c nPoints() equal slices of [0, 1).
+   *
+   * Each set is randomized by the stream passed to \c generate():  a
+   * random shift, modulo 1, of the Halton points; a random digital shift
+   * (XOR) of the Sobol points; and random slice orders and offsets for the
+   * Latin hypercube.  The shifts keep the sets' evenness, but give each
+   * stream a different set.
+   *
+   * Uses the compiler-generated copy-c'tor and assignment operator.
+   */
+  class QuasiRandomSet
+  {
+  public:
+      enum Method_t { PseudoRandom=0, Halton, Sobol, LatinHypercube,
+                      N_METHODS };
+
+      /// The largest number of coordinates that \c Halton and \c Sobol
+      /// support.
+      static const unsigned MAX_DIMS=8;
+
+      /// The name of \a method, for output.
+      static const char* methodName(Method_t method);
+
+      /// Constructor
+      /**
+       * Creates an empty set.
+       */
+      QuasiRandomSet()
+          : m__method(PseudoRandom)
+          , m__nPoints(0)
+          , m__nDims(0)
+          , m__coords()
+      {}
+
+      /// Replaces this set with \a nPoints points of \a nDims
+      /// coordinates, made by \a method and randomized by \a rng.
+      /**
+       * \throws jpw_nld::InvalidArgError if \a nDims is larger than \c
+       * MAX_DIMS.
+       */
+      void generate(Method_t method, unsigned nPoints, unsigned nDims,
+                    PhiloxRNG rng);
+
+      /// The method that made this set.
+      Method_t method() const
+      { return m__method; }
+
+      /// The number of points.
+      unsigned nPoints() const
+      { return m__nPoints; }
+
+      /// The number of coordinates of each point.
+      unsigned nDims() const
+      { return m__nDims; }
+
+      /// Coordinate \a d of point \a k, in [0, 1).
+      double operator()(unsigned k, unsigned d) const
+      { return m__coords[k*m__nDims + d]; }
+
+  private:
+      Method_t m__method;
+      unsigned m__nPoints;
+      unsigned m__nDims;
+      std::vector<double> m__coords;
+
+      void makeHalton(PhiloxRNG& rng);
+      void makeSobol(PhiloxRNG& rng);
+      void makeLatinHypercube(PhiloxRNG& rng);
+  };
+
+
+  // Class QuasiPointRNG
+  /**
+   * One point of a \c QuasiRandomSet, behind the \c PhiloxRNG interface.
+   *
+   * Each call to \c uniform(), \c index() or \c range() uses the next
+   * coordinate of the point, mapped as \c PhiloxRNG maps its uniform
+   * numbers.  Once the coordinates run out, the calls continue from a
+   * pseudo-random stream.
+   *
+   * So a model's <tt>randomParams(params,&nbsp;rng)</tt> maps the point
+   * into parameter space by the model's own scaling, provided it makes one
+   * draw per coordinate.
+   */
+  class QuasiPointRNG
+  {
+  public:
+      /// Constructor
+      /**
+       * Draws point \a k of \a theSet, then continues from \a rest.
+       * \a theSet isn't copied, and must outlive this object.
+       */
+      QuasiPointRNG(const QuasiRandomSet& theSet, unsigned k,
+                    const PhiloxRNG& rest)
+          : m__set(theSet)
+          , m__k(k)
+          , m__d(0)
+          , m__rest(rest)
+      {}
+
+      /// The next coordinate, in [0, 1).
+      double uniform()
+      {
+          if(m__d < m__set.nDims()) {
+              return m__set(m__k, m__d++);
+          }
+          return m__rest.uniform();
+      }
+
+      /// The next coordinate, as an index from 0 to \a nn-1.
+      index_t index(index_t nn)
+      { return static_cast<index_t>(uniform()*nn); }
+
+      /// The next coordinate, mapped onto the range [-\a del, \a del].
+      double range(double del)
+      { return ( del*(2.0*uniform() - 1.0) ); }
+
+  private:
+      const QuasiRandomSet& m__set;
+      unsigned m__k;
+      unsigned m__d;
+      PhiloxRNG m__rest;
+  };
+
+
+ }; //end namespace statistics
+}; //end namespace jpw_math
+
+
+#endif //_QuasiRandom_H_
+/////////////////////////
+//
+// End
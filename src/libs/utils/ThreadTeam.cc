@@ -0,0 +1,270 @@
+// -*- C++ -*-
+// Implementation of class ThreadTeam
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+ThreadTeam_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <stdexcept>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include "ThreadTeam.h"
+
+
+using namespace jpw_nld;
+
+
+//
+// Static variables
+//
+
+
+//
+// Typedefs
+//
+
+
+typedef boost::unique_lock<boost::mutex> lock_t;
+
+
+//
+// Local Functions
+//
+
+
+namespace {
+
+  // Runs one task, returning the message of any exception it throws.
+  std::string runTask(ThreadTeam::Task& task, unsigned iTask,
+                      unsigned iThread)
+  {
+      std::string errMsg;
+      try {
+          task(iTask, iThread);
+      } catch(std::exception& ex) {
+          errMsg = ex.what();
+          if(errMsg.empty()) {
+              errMsg = "ThreadTeam:  task threw an exception.";
+          }
+      } catch(...) {
+          errMsg = "ThreadTeam:  task threw an unknown exception.";
+      }
+      return errMsg;
+  }
+
+} // end anon. namespace
+
+
+/////////////////////////
+
+//
+// ThreadTeam::BatchFrame
+//
+
+
+// One batch that a thread is working on.
+struct ThreadTeam::BatchFrame
+{
+    const ThreadTeam* team;
+    unsigned iThread;
+    // The batches that the caller of team->run() was working on.
+    const BatchFrame* outer;
+};
+
+
+__thread const ThreadTeam::BatchFrame* ThreadTeam::m__batches(0);
+
+
+/////////////////////////
+
+//
+// ThreadTeam Member Functions
+//
+
+
+ThreadTeam::ThreadTeam(unsigned nThreads)
+    : m__workers()
+    , m__task(0)
+    , m__nTasks(0)
+    , m__nextTask(0)
+    , m__nBusy(0)
+    , m__generation(0)
+    , m__callerBatches(0)
+    , m__shutdown(false)
+    , m__failed(false)
+    , m__errMsg()
+{
+    if(nThreads == 0) {
+        nThreads = boost::thread::hardware_concurrency();
+    }
+
+    for(unsigned i=1; i<nThreads; ++i) {
+        m__workers.push_back(
+            new boost::thread(boost::bind(&ThreadTeam::workerLoop,
+                                          this, i)) );
+    }
+}
+
+
+ThreadTeam::~ThreadTeam()
+{
+    {
+        lock_t lock(m__mutex);
+        m__shutdown = true;
+    }
+    m__startCond.notify_all();
+
+    for(unsigned i=0; i<m__workers.size(); ++i) {
+        m__workers[i]->join();
+        delete m__workers[i];
+    }
+}
+
+
+void ThreadTeam::run(Task& task, unsigned nTasks)
+{
+    // Called from within one of our own batches, perhaps by way of some
+    // other team's.  That batch may have every one of our threads busy,
+    // and can't finish until this call returns, so run the nested batch
+    // right here.
+    const BatchFrame* outer(findBatch());
+    if(outer) {
+        std::string firstErrMsg;
+        for(unsigned i=0; i<nTasks; ++i) {
+            std::string errMsg(runTask(task, i, outer->iThread));
+            if(firstErrMsg.empty()) {
+                firstErrMsg = errMsg;
+            }
+        }
+        if(!firstErrMsg.empty()) {
+            throw std::runtime_error(firstErrMsg);
+        }
+        return;
+    }
+
+    lock_t runLock(m__runMutex);
+
+    {
+        lock_t lock(m__mutex);
+        m__callerBatches = m__batches;
+        m__task = &task;
+        m__nTasks = nTasks;
+        m__nextTask = 0;
+        m__failed = false;
+        m__errMsg.clear();
+
+        // Not worth waking anyone for a single task.
+        if(nTasks > 1) {
+            m__nBusy = m__workers.size();
+            ++m__generation;
+        }
+    }
+    if(nTasks > 1) {
+        m__startCond.notify_all();
+    }
+
+    doTasks(0);
+
+    {
+        lock_t lock(m__mutex);
+        while(m__nBusy) {
+            m__doneCond.wait(lock);
+        }
+        m__task = 0;
+    }
+
+    if(m__failed) {
+        throw std::runtime_error(m__errMsg);
+    }
+}
+
+
+void ThreadTeam::workerLoop(unsigned iThread)
+{
+    unsigned lastGeneration(0);
+    for(;;)
+    {
+        {
+            lock_t lock(m__mutex);
+            while( !m__shutdown && (m__generation == lastGeneration) ) {
+                m__startCond.wait(lock);
+            }
+            if(m__shutdown) {
+                return;
+            }
+            lastGeneration = m__generation;
+        }
+
+        doTasks(iThread);
+
+        {
+            lock_t lock(m__mutex);
+            if(--m__nBusy == 0) {
+                m__doneCond.notify_all();
+            }
+        }
+    }
+}
+
+
+const ThreadTeam::BatchFrame* ThreadTeam::findBatch() const
+{
+    for(const BatchFrame* frame=m__batches; frame; frame=frame->outer) {
+        if(frame->team == this) {
+            return frame;
+        }
+    }
+    return 0;
+}
+
+
+void ThreadTeam::doTasks(unsigned iThread)
+{
+    // Every thread working on this batch sees the caller's batches as its
+    // own, so that a nested run() on any of those teams can find them.
+    const BatchFrame* savedBatches(m__batches);
+    BatchFrame frame = { this, iThread, m__callerBatches };
+    m__batches = &frame;
+
+    for(;;)
+    {
+        unsigned iTask;
+        {
+            lock_t lock(m__mutex);
+            if(m__nextTask >= m__nTasks) {
+                break;
+            }
+            iTask = m__nextTask++;
+        }
+
+        std::string errMsg(runTask(*m__task, iTask, iThread));
+        if(!errMsg.empty()) {
+            lock_t lock(m__mutex);
+            if(!m__failed) {
+                m__failed = true;
+                m__errMsg = errMsg;
+            }
+        }
+    }
+
+    m__batches = savedBatches;
+}
+
+
+/////////////////////////
+//
+// End
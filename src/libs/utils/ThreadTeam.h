@@ -0,0 +1,167 @@
+// -*- C++ -*-
+// Header file for class ThreadTeam
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _ThreadTeam_H_
+#define _ThreadTeam_H_
+
+// Includes
+//
+#include <string>
+#include <vector>
+#include <boost/utility.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+
+// Forward Declarations
+//
+namespace boost {
+ class thread;
+};
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+
+
+ // Class ThreadTeam
+ /**
+  * A fixed team of worker threads that share out a batch of independent
+  * tasks.
+  *
+  * The threads are started once, by the c'tor, and sleep between batches.
+  * So a batch costs only a few lock/unlock operations more than running the
+  * tasks serially, which makes it worthwhile to parallelize even
+  * short-lived work, like the columns of a finite-difference Jacobian.
+  *
+  * The thread calling \c run() is a member of the team:  it works on the
+  * batch alongside the others.  Tasks are handed out one at a time, in
+  * order, to whichever thread is free.
+  *
+  * \c run() may be called from any thread, but only one batch runs at a
+  * time.  Concurrent calls to \c run() are serialized.  A task may call
+  * \c run() on its own team (e.g. a fit run as a task, whose
+  * finite-difference Jacobian uses the same team), directly or from a task
+  * of another team.  That nested batch runs serially, on the calling
+  * thread.
+  *
+  * Link with <tt>$(THREAD_LIBS)</tt> when using this class.
+  */
+ class ThreadTeam : private boost::noncopyable
+ {
+ public:
+     /// Interface for a batch of tasks.
+     /**
+      * Implement \c operator() in a subclass and pass an instance to \c
+      * ThreadTeam::run().
+      */
+     struct Task
+     {
+         virtual ~Task() {}
+
+         /// Perform one task.
+         /**
+          * Called concurrently from several threads, so it must be
+          * re-entrant.
+          *
+          * \param iTask
+          * The index of the task to run, in [0, \a nTasks).
+          *
+          * \param iThread
+          * The index of the calling thread, in [0, \c ThreadTeam::size()).
+          * Use it to select per-thread storage.  The thread calling \c
+          * ThreadTeam::run() is always thread \c 0.
+          */
+         virtual void operator()(unsigned iTask, unsigned iThread) = 0;
+     };
+
+     /// Constructor
+     /**
+      * \param nThreads
+      * The size of the team, including the thread calling \c run().  \c 0
+      * selects one thread per hardware thread.  \c 1 creates no threads at
+      * all; \c run() will execute each batch serially.
+      */
+     explicit ThreadTeam(unsigned nThreads=0);
+
+     /// Destructor
+     /**
+      * Stops and joins the worker threads.
+      */
+     ~ThreadTeam();
+
+     /// The number of threads in the team, including the caller of \c
+     /// run().
+     unsigned size() const
+     { return (m__workers.size() + 1); }
+
+     /// Runs tasks \c 0 through \a nTasks-1 of \a task, and waits for them
+     /// to finish.
+     /**
+      * If any of the tasks throws an exception, the remaining tasks still
+      * run.  Afterwards, \c run() throws a \c std::runtime_error containing
+      * the message of the first exception.
+      *
+      * When called from one of this team's own tasks, runs the tasks in
+      * order on the calling thread.  Each gets the \a iThread of the
+      * calling task.
+      */
+     void run(Task& task, unsigned nTasks);
+
+ private:
+     struct BatchFrame;
+
+     void workerLoop(unsigned iThread);
+     void doTasks(unsigned iThread);
+
+     /// The frame of the batch of this team that the calling thread is
+     /// working on, or 0.
+     const BatchFrame* findBatch() const;
+
+     // The batches that the current thread is working on, innermost
+     // first.
+     static __thread const BatchFrame* m__batches;
+
+     std::vector<boost::thread*> m__workers;
+
+     // Held by run() for the duration of a batch.
+     boost::mutex m__runMutex;
+
+     // Guards all of the members below.
+     boost::mutex m__mutex;
+     boost::condition_variable m__startCond;
+     boost::condition_variable m__doneCond;
+     Task* m__task;
+     unsigned m__nTasks;
+     unsigned m__nextTask;
+     unsigned m__nBusy;
+     unsigned m__generation;
+     const BatchFrame* m__callerBatches;
+     bool m__shutdown;
+     bool m__failed;
+     std::string m__errMsg;
+ };
+
+
+}; //end namespace
+
+
+#endif //_ThreadTeam_H_
+/////////////////////////
+//
+// End
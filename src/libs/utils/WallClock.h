@@ -0,0 +1,48 @@
+// -*- C++ -*-
+// Header file for the wall-clock timer.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _WallClock_H_
+#define _WallClock_H_
+
+// Includes
+//
+#include <time.h>
+
+
+// Enclosing namespace
+//
+namespace jpw_nld {
+
+ /// Seconds of wall-clock time since an arbitrary fixed point.
+ /**
+  * Uses the monotonic clock, so the difference of two calls is an elapsed
+  * time, unaffected by changes to the system time.
+  */
+ inline double wallClock()
+ {
+     struct timespec now;
+     clock_gettime(CLOCK_MONOTONIC, &now);
+     return (now.tv_sec + 1.0e-9*now.tv_nsec);
+ }
+
+}; //end namespace
+
+
+#endif //_WallClock_H_
+/////////////////////////
+//
+// End
@@ -236,6 +236,24 @@ void jpw_math::statistics::init_rand(unsigned s1, unsigned s2, bool verbose)
 }
 
 
+void jpw_math::statistics::save_rand_state(unsigned short state[3])
+{
+    // seed48() is the only way to read the state; put it right back.
+    seed48v_t scratch = { 0, 0, 0 };
+    unsigned short* current = seed48(scratch);
+    std::copy(current, current+3, state);
+    seed48(state);
+}
+
+
+void jpw_math::statistics::restore_rand_state(const unsigned short state[3])
+{
+    seed48v_t elseed = { state[0], state[1], state[2] };
+    seed48(elseed);
+    g__pRNG_Initialized = true;
+}
+
+
 double jpw_math::statistics::gaussrand(void)
 {
     static int iset=1;
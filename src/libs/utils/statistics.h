@@ -74,6 +74,17 @@ namespace jpw_math {
    */
   void init_rand(unsigned s1, unsigned s2, bool verbose=true);
 
+  /// Copies the current 48-bit state of the *rand48() pRNG into \a state.
+  /**
+   * Pass the result to \c restore_rand_state() to replay the same sequence
+   * of random numbers.  (Only the \c drand48() sequence is saved;
+   * \c gaussrand() holds one value back between calls.)
+   */
+  void save_rand_state(unsigned short state[3]);
+
+  /// Restores a state saved by \c save_rand_state().
+  void restore_rand_state(const unsigned short state[3]);
+
   /// Returns a random index from 0 to nn-1
   inline index_t randidx(index_t nn)
   {
@@ -0,0 +1,155 @@
+// -*- C++ -*-
+// Synthetic PersistenceMaps and timing tools for the fitter benchmarks.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+// RCS $Id$
+//
+#ifndef _BenchMaps_H_
+#define _BenchMaps_H_
+
+// Includes
+//
+#include "jpw_nld.h"
+#include "WallClock.h"
+#include "Matrix.h"
+#include "statistics.h"
+#include "PersistenceMap.h"
+#include "BarrierModels.h"
+
+
+// Enclosing namespace
+//
+namespace fitbench {
+
+
+  /// One benchmark map:  the "true" barrier-model parameters, in their
+  /// unscaled form, plus the size of the map and the noise added to it.
+  struct BenchCase
+  {
+      const char* name;
+      unsigned nBins;
+      double beta;
+      double ampl;
+      double width;
+      double tau;
+      double noise;
+  };
+
+
+  /// The standard set of benchmark maps.
+  static const BenchCase BENCH_CASES[] = {
+      { "mid",    52, 0.30, 0.70, 0.20, 0.50, 0.01 },
+      { "narrow", 52, 0.65, 0.85, 0.08, 0.30, 0.01 },
+      { "weak",   64, 0.10, 0.40, 0.30, 1.20, 0.02 },
+      { "large", 100, 0.45, 0.60, 0.15, 0.80, 0.01 },
+  };
+  static const unsigned N_BENCH_CASES =
+      sizeof(BENCH_CASES)/sizeof(BENCH_CASES[0]);
+
+  /// Fixed seeds, so that every run sees identical maps.
+  static const unsigned BENCH_SEED1=0x1234;
+  static const unsigned BENCH_SEED2=0x56789abc;
+
+
+  /// Fills \a params with the rescaled form of the parameters in \a bc.
+  inline void trueParams(const BenchCase& bc, jpw_math::dvector_t& params)
+  {
+      using jpw_nld::measure::FullBarrierModel_t;
+      params.resize(FullBarrierModel_t::N_PARAMETERS);
+      params[0] = bc.beta;
+      params[1] = FullBarrierModel_t::scale_ampl(bc.ampl);
+      params[2] = FullBarrierModel_t::scale_width(bc.width);
+      params[3] = FullBarrierModel_t::scale_tau(bc.tau);
+  }
+
+
+  /// Fills \a params with the rescaled form of a starting point that's a
+  /// fixed distance away from the true parameters of \a bc.
+  /**
+   * Stands in for the output of a \c FitGA run, without its cost.  \a
+   * distance scales the offset from the true parameters; \c 1 is typical
+   * of a converged \c FitGA run.
+   */
+  inline void startParams(const BenchCase& bc, jpw_math::dvector_t& params,
+                          double distance=1.0)
+  {
+      using jpw_nld::measure::FullBarrierModel_t;
+      params.resize(FullBarrierModel_t::N_PARAMETERS);
+      params[0] = bc.beta + 0.04*distance;
+      params[1] = FullBarrierModel_t::scale_ampl((1.0 - 0.1*distance)*
+                                                 bc.ampl);
+      params[2] = FullBarrierModel_t::scale_width((1.0 + 0.25*distance)*
+                                                  bc.width);
+      params[3] = FullBarrierModel_t::scale_tau((1.0 - 0.2*distance)*
+                                                bc.tau);
+  }
+
+
+  /// Fills \a params with a starting point near the edge of the model's
+  /// domain, far from the true parameters of \a bc.
+  /**
+   * Stands in for a \c FitGA run that stopped near a boundary:  the
+   * amplitude close to 1, the width close to its maximum, the decay time
+   * long, and beta offset by most of a period.
+   */
+  inline void edgeParams(const BenchCase& bc, jpw_math::dvector_t& params)
+  {
+      using jpw_nld::measure::FullBarrierModel_t;
+      params.resize(FullBarrierModel_t::N_PARAMETERS);
+      params[0] = bc.beta + 0.9;
+      params[1] = FullBarrierModel_t::scale_ampl(0.9);
+      params[2] = FullBarrierModel_t::scale_width(0.9);
+      params[3] = FullBarrierModel_t::scale_tau(3.0);
+  }
+
+
+  /// Replaces the contents of \a theMap with the full barrier model
+  /// evaluated at the parameters in \a bc, plus uniform noise.
+  /**
+   * Reseeds the pRNG, so the noise is the same on every call.
+   */
+  inline void makeMap(const BenchCase& bc,
+                      jpw_nld::measure::PersistenceMap& theMap)
+  {
+      using namespace jpw_nld;
+      jpw_math::statistics::init_rand(BENCH_SEED1, BENCH_SEED2, false);
+
+      tslen_t nData(bc.nBins*bc.nBins);
+      theMap.wipe(bc.nBins);
+      measure::FullBarrierModel_t theModel(nData);
+      jpw_math::dvector_t params;
+      trueParams(bc, params);
+      jpw_math::dvector_t modelData(nData);
+      theModel(theMap, params, modelData);
+
+      jpw_math::dmatrix_t newMap(modelData, bc.nBins, bc.nBins);
+      for(unsigned i=0; i<bc.nBins; ++i) {
+          for(unsigned j=0; j<bc.nBins; ++j) {
+              newMap[i][j] += bc.noise*jpw_math::statistics::range_rand(1.0);
+          }
+      }
+      theMap.swap_map(newMap);
+  }
+
+
+  using jpw_nld::wallClock;
+
+
+}; //end namespace
+
+
+#endif //_BenchMaps_H_
+/////////////////////////
+//
+// End
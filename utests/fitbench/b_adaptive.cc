@@ -0,0 +1,174 @@
+// -*- C++ -*-
+// Benchmark:  AdaptiveFit against the usual FitGA-then-LM fit.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_adaptive_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "ThreadTeam.h"
+#include "AdaptiveFit.h"
+#include "details/FitGA.tcc"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+static const unsigned N_THREADS(4);
+// The quality gate, as a multiple of the variance of the noise.
+static const double GATE_MULTIPLE(2.0);
+
+enum Start_t { Warm, Stale, Edge, Cold, N_START_KINDS };
+static const char* const START_LABELS[] = { "warm", "stale", "edge",
+                                            "cold" };
+static const char* const TIER_LABELS[] = { "none", "warm-LM",
+                                           "multi-start", "GA" };
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+typedef measure::AdaptiveFit<> AdaptiveFit_t;
+
+
+// The starting point for each kind of start.  A "stale" start is the
+// true parameters of a different map, as if from a WarmStartIndex entry
+// that's too far away.
+void startFor(Start_t kind, unsigned c, dvector_t& params)
+{
+    switch(kind)
+    {
+    case Warm:
+        startParams(BENCH_CASES[c], params);
+        break;
+    case Stale:
+        trueParams(BENCH_CASES[(c+1)%N_BENCH_CASES], params);
+        break;
+    case Edge:
+        edgeParams(BENCH_CASES[c], params);
+        break;
+    default:
+        params.clear();
+        break;
+    }
+}
+
+
+// The usual procedure:  a FitGA run, then LM from its best member.
+double gaThenLM(const BenchCase& bc, const measure::PersistenceMap& theMap,
+                double& chiSq)
+{
+    AdaptiveFit_t::FitGA_t theGA;
+    measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+    dvector_t params;
+
+    double t0(wallClock());
+    theGA(params, theMap, fitter.theModel());
+    fitter(params, theMap, LM_FACTOR);
+    chiSq = fitter.chiSquared();
+    return (wallClock() - t0);
+}
+
+
+int main()
+{
+    ThreadTeam team(N_THREADS);
+    double adaptiveTotal(0.0), baselineTotal(0.0);
+    unsigned nFits(0);
+    unsigned tierCounts[AdaptiveFit_t::N_TIERS] = { 0, 0, 0, 0 };
+
+    for(unsigned c=0; c<N_BENCH_CASES; ++c)
+    {
+        const BenchCase& bc(BENCH_CASES[c]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+        AdaptiveFit_t driver(bc.nBins*bc.nBins, &team);
+        // Uniform noise in [-noise, noise] has a variance of noise^2/3.
+        driver.setMaxReducedChiSq(GATE_MULTIPLE*bc.noise*bc.noise/3.0);
+
+        double baseChiSq;
+        jpw_math::statistics::init_rand(BENCH_SEED2, BENCH_SEED1, false);
+        double baseTime(gaThenLM(bc, theMap, baseChiSq));
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins << "):"
+             << endl
+             << "  " << std::left << setw(6) << "GA+LM" << std::right
+             << "                   chi^2=" << std::scientific
+             << std::setprecision(4) << baseChiSq
+             << " time=" << std::fixed << std::setprecision(4) << baseTime
+             << "s" << endl;
+
+        for(unsigned s=0; s<N_START_KINDS; ++s)
+        {
+            dvector_t params;
+            startFor(static_cast<Start_t>(s), c, params);
+            jpw_math::statistics::init_rand(BENCH_SEED2, BENCH_SEED1,
+                                            false);
+            double t0(wallClock());
+            AdaptiveFit_t::Tier_t tier = driver(params, theMap, LM_FACTOR);
+            double seconds(wallClock() - t0);
+
+            cout << "  " << std::left << setw(6) << START_LABELS[s]
+                 << " tier=" << setw(12) << TIER_LABELS[tier]
+                 << std::right << " chi^2=" << std::scientific
+                 << std::setprecision(4) << driver.chiSquared()
+                 << " time=" << std::fixed << std::setprecision(4)
+                 << seconds << "s" << endl;
+
+            ++tierCounts[tier];
+            adaptiveTotal += seconds;
+            baselineTotal += baseTime;
+            ++nFits;
+        }
+    }
+
+    cout << endl << "Tiers:";
+    for(unsigned t=0; t<AdaptiveFit_t::N_TIERS; ++t) {
+        cout << ' ' << TIER_LABELS[t] << '=' << tierCounts[t];
+    }
+    cout << endl << "Mean time per map:  adaptive=" << std::fixed
+         << std::setprecision(4) << adaptiveTotal/nFits
+         << "s GA+LM=" << baselineTotal/nFits << "s" << endl;
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
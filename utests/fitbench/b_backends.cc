@@ -0,0 +1,180 @@
+// -*- C++ -*-
+// Benchmark:  the FitLM back-ends, on the same maps and starting points.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_backends_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "FitLM_BarrierAdapter.h"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+static const unsigned N_REPEATS(5);
+// Distances of the starting point from the true parameters.  A negative
+// distance means a start from edgeParams().
+static const double START_DISTANCES[] = { 1.0, 3.0, -1.0 };
+static const unsigned N_START_DISTANCES =
+    sizeof(START_DISTANCES)/sizeof(START_DISTANCES[0]);
+
+static const fortlib::FitLM::Backend_t BACKENDS[] = {
+    fortlib::FitLM::MinpackLM,
+    fortlib::FitLM::NativeLM,
+    fortlib::FitLM::Dogleg,
+    fortlib::FitLM::GaussNewton,
+};
+static const char* const LABELS[] = { "lmder", "native-LM", "dogleg",
+                                      "gauss-newton" };
+static const unsigned N_BACKENDS = sizeof(BACKENDS)/sizeof(BACKENDS[0]);
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+struct FitResult
+{
+    int status;
+    double chiSq;
+    int iterations;
+    int functionEvals;
+    double seconds;
+};
+
+
+void runFits(measure::FitLM_PBarrier& fitter,
+             const measure::PersistenceMap& theMap,
+             const BenchCase& bc, double distance,
+             fortlib::FitLM::Backend_t backend, FitResult& result)
+{
+    // Unbounded, so that "lmder" really is lmder_().
+    fitter.clearBounds();
+    fitter.setBackend(backend);
+
+    dvector_t params;
+    double t0(wallClock());
+    for(unsigned r=0; r<N_REPEATS; ++r) {
+        if(distance < 0.0) {
+            edgeParams(bc, params);
+        } else {
+            startParams(bc, params, distance);
+        }
+        result.status = fitter(params, theMap, LM_FACTOR);
+    }
+    result.seconds = (wallClock() - t0)/N_REPEATS;
+    result.chiSq = fitter.chiSquared();
+    result.iterations = fitter.iterations();
+    result.functionEvals = fitter.functionEvals();
+}
+
+
+void printResult(const char* label, const FitResult& result)
+{
+    cout << "  " << std::left << setw(12) << label << std::right
+         << " status=" << setw(2) << result.status
+         << " chi^2=" << std::scientific << std::setprecision(4)
+         << result.chiSq
+         << " j-evals=" << setw(3) << result.iterations
+         << " f-evals=" << setw(3) << result.functionEvals
+         << " time=" << std::fixed << std::setprecision(4)
+         << result.seconds << "s" << endl;
+}
+
+
+int main()
+{
+    int totalIters[N_BACKENDS];
+    int totalEvals[N_BACKENDS];
+    double totalTime[N_BACKENDS];
+    for(unsigned b=0; b<N_BACKENDS; ++b) {
+        totalIters[b] = 0;
+        totalEvals[b] = 0;
+        totalTime[b] = 0.0;
+    }
+
+    for(unsigned c=0; c<N_BENCH_CASES; ++c)
+    {
+        const BenchCase& bc(BENCH_CASES[c]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+        measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+
+        for(unsigned d=0; d<N_START_DISTANCES; ++d)
+        {
+            cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins
+                 << "), ";
+            if(START_DISTANCES[d] < 0.0) {
+                cout << "start near the domain's edge:" << endl;
+            } else {
+                cout << "start distance " << std::fixed
+                     << std::setprecision(1) << START_DISTANCES[d] << ':'
+                     << endl;
+            }
+
+            for(unsigned b=0; b<N_BACKENDS; ++b)
+            {
+                FitResult result;
+                runFits(fitter, theMap, bc, START_DISTANCES[d],
+                        BACKENDS[b], result);
+                printResult(LABELS[b], result);
+
+                totalIters[b] += result.iterations;
+                totalEvals[b] += result.functionEvals;
+                totalTime[b] += result.seconds;
+            }
+        }
+    }
+
+    cout << endl << "Totals:" << endl;
+    for(unsigned b=0; b<N_BACKENDS; ++b) {
+        cout << "  " << std::left << setw(12) << LABELS[b] << std::right
+             << " j-evals=" << setw(4) << totalIters[b]
+             << " f-evals=" << setw(4) << totalEvals[b]
+             << " time-to-solution=" << std::fixed << std::setprecision(4)
+             << totalTime[b] << "s" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,169 @@
+// -*- C++ -*-
+// Benchmark:  bounded (projected) vs. unbounded Levenberg-Marquardt fits.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_bounds_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "ParamBounds.h"
+#include "FitLM_BarrierAdapter.h"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+static const unsigned N_REPEATS(5);
+// Distances of the starting point from the true parameters.  A negative
+// distance means a start from edgeParams().
+static const double START_DISTANCES[] = { 1.0, 3.0, 4.5, -1.0 };
+static const unsigned N_START_DISTANCES =
+    sizeof(START_DISTANCES)/sizeof(START_DISTANCES[0]);
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+struct FitResult
+{
+    int status;
+    double chiSq;
+    int iterations;
+    int functionEvals;
+    double seconds;
+};
+
+
+void runFits(measure::FitLM_PBarrier& fitter,
+             const measure::PersistenceMap& theMap,
+             const BenchCase& bc, double distance, bool bounded,
+             FitResult& result)
+{
+    if(bounded) {
+        typedef measure::FullBarrierModel_t Model_t;
+        fortlib::ParamBounds theBounds(Model_t::N_PARAMETERS);
+        Model_t::paramBounds(theBounds);
+        fitter.setBounds(theBounds);
+    } else {
+        fitter.clearBounds();
+    }
+
+    dvector_t params;
+    double t0(wallClock());
+    for(unsigned r=0; r<N_REPEATS; ++r) {
+        if(distance < 0.0) {
+            edgeParams(bc, params);
+        } else {
+            startParams(bc, params, distance);
+        }
+        result.status = fitter(params, theMap, LM_FACTOR);
+    }
+    result.seconds = (wallClock() - t0)/N_REPEATS;
+    result.chiSq = fitter.chiSquared();
+    result.iterations = fitter.iterations();
+    result.functionEvals = fitter.functionEvals();
+}
+
+
+void printResult(const char* label, const FitResult& result)
+{
+    cout << "  " << std::left << setw(9) << label << std::right
+         << " status=" << setw(2) << result.status
+         << " chi^2=" << std::scientific << std::setprecision(4)
+         << result.chiSq
+         << " iterations=" << setw(3) << result.iterations
+         << " f-evals=" << setw(3) << result.functionEvals
+         << " time=" << std::fixed << std::setprecision(4)
+         << result.seconds << "s" << endl;
+}
+
+
+int main()
+{
+    static const char* const LABELS[2] = { "lmder", "projected" };
+    int totalIters[2] = { 0, 0 };
+    double totalTime[2] = { 0.0, 0.0 };
+
+    for(unsigned c=0; c<N_BENCH_CASES; ++c)
+    {
+        const BenchCase& bc(BENCH_CASES[c]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+        measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+
+        for(unsigned d=0; d<N_START_DISTANCES; ++d)
+        {
+            cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins
+                 << "), ";
+            if(START_DISTANCES[d] < 0.0) {
+                cout << "start near the domain's edge:" << endl;
+            } else {
+                cout << "start distance " << std::fixed
+                     << std::setprecision(1) << START_DISTANCES[d] << ':'
+                     << endl;
+            }
+
+            for(unsigned b=0; b<2; ++b)
+            {
+                FitResult result;
+                runFits(fitter, theMap, bc, START_DISTANCES[d], (b == 1),
+                        result);
+                printResult(LABELS[b], result);
+
+                totalIters[b] += result.iterations;
+                totalTime[b] += result.seconds;
+            }
+        }
+    }
+
+    cout << endl << "Totals:" << endl;
+    for(unsigned b=0; b<2; ++b) {
+        cout << "  " << std::left << setw(9) << LABELS[b] << std::right
+             << " iterations=" << setw(4) << totalIters[b]
+             << " time-to-solution=" << std::fixed << std::setprecision(4)
+             << totalTime[b] << "s" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,148 @@
+// -*- C++ -*-
+// Benchmark:  the cost of capturing fits for an offline replay.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_capture_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+
+#include "FitCapture.h"
+#include "FitLM_BarrierAdapter.h"
+#include "FitGA.h"
+#include "details/FitGA.tcc"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using std::string;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+static const double START_DISTANCE(3.0);
+static const unsigned N_REPEATS(20);
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+typedef optimize::FitGA<measure::FullBarrierModel_t,
+                        measure::PersistenceMap> FitGA_t;
+
+
+double timeFits(measure::FitLM_PBarrier& fitter, const BenchCase& bc,
+                const measure::PersistenceMap& theMap)
+{
+    dvector_t params;
+    double t0(wallClock());
+    for(unsigned r=0; r<N_REPEATS; ++r) {
+        startParams(bc, params, START_DISTANCE);
+        fitter(params, theMap, LM_FACTOR);
+    }
+    return (wallClock() - t0)/N_REPEATS;
+}
+
+
+// Saves 'capture', then checks that it loads back unchanged.
+bool saveCapture(const measure::FitCapture& capture, const string& filename)
+{
+    capture.save(filename);
+    measure::FitCapture loaded;
+    loaded.load(filename);
+    return ( loaded.theMap().data().equivalent(capture.theMap().data(), 0.0) &&
+             (loaded.startParams() == capture.startParams()) &&
+             (loaded.fittedParams() == capture.fittedParams()) &&
+             (loaded.chiSq() == capture.chiSq()) );
+}
+
+
+int main()
+{
+    cout << "LM fits from start distance " << std::fixed
+         << std::setprecision(1) << START_DISTANCE << ", and one FitGA "
+         << "run:" << endl;
+
+    for(unsigned c=0; c<N_BENCH_CASES; ++c)
+    {
+        const BenchCase& bc(BENCH_CASES[c]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+        measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+
+        // Once untimed, to warm up the caches.
+        timeFits(fitter, bc, theMap);
+        measure::FitCapture capture;
+        double plain(timeFits(fitter, bc, theMap));
+        fitter.setCapture(&capture);
+        double captured(timeFits(fitter, bc, theMap));
+        fitter.setCapture(0);
+
+        string lmFile(string("capture_") + bc.name + "_lm.fit");
+        bool lmOK(saveCapture(capture, lmFile));
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins << "):"
+             << endl
+             << "  LM  time=" << std::fixed << std::setprecision(4) << plain
+             << "s captured=" << captured << "s overhead="
+             << std::setprecision(1) << setw(4)
+             << 100.0*(captured - plain)/plain << "%  "
+             << lmFile << (lmOK ? "" : " (SAVE FAILED)") << endl;
+
+        // The GA takes far longer; one map is enough.
+        if(c) {
+            continue;
+        }
+        FitGA_t theGA;
+        measure::FullBarrierModel_t theModel(bc.nBins*bc.nBins);
+        dvector_t params;
+        jpw_math::statistics::init_rand(BENCH_SEED2, BENCH_SEED1, false);
+        theGA.setCapture(&capture);
+        theGA(params, theMap, theModel);
+        string gaFile(string("capture_") + bc.name + "_ga.fit");
+        bool gaOK(saveCapture(capture, gaFile));
+
+        cout << "  GA  time=" << std::setprecision(4) << capture.seconds()
+             << "s chi^2=" << std::scientific << capture.chiSq() << "  "
+             << gaFile << (gaOK ? "" : " (SAVE FAILED)") << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,231 @@
+// -*- C++ -*-
+// Benchmark:  parameter covariance from lmder's R vs. inverting J^T*J.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_covar_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+#include "FORTLib.h"
+#include "FitLM_BarrierAdapter.h"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using jpw_math::dmatrix_t;
+using namespace fitbench;
+using namespace fortlib::square_matrix_inversion;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+static const unsigned N_REPEATS(20);
+static const unsigned N_INVERSIONS(100000);
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+// The naive covariance:  evaluate J at the fitted parameters, form J^T*J,
+// and invert it.
+void explicitCovariance(measure::FullBarrierModel_t& theModel,
+                        const measure::PersistenceMap& theMap,
+                        dvector_t& params, dmatrix_t& covar)
+{
+    int nData(theMap.size());
+    int nParams(params.size());
+    dvector_t deltas(nData);
+    dvector_t jacob(nData*nParams);
+    theModel(nData, theMap, nParams, &params[0], &deltas[0], &jacob[0],
+             nData, fortlib::FitLM::ComputeJacobian);
+
+    dmatrix_t jtj(nParams, nParams, 0.0);
+    for(int j=0; j<nParams; ++j) {
+        for(int k=0; k<=j; ++k) {
+            double ajk(0.0);
+            for(int i=0; i<nData; ++i) {
+                ajk += jacob[i + nData*j]*jacob[i + nData*k];
+            }
+            jtj[j][k] = ajk;
+            jtj[k][j] = ajk;
+        }
+    }
+    if(sqmInvert_GJE(jtj, covar)) {
+        sqmInvert_SVD(jtj, covar);
+    }
+}
+
+
+double maxRelDiff(const dmatrix_t& a, const dmatrix_t& b)
+{
+    double maxDiff(0.0);
+    for(unsigned i=0; i<a.nRows(); ++i) {
+        for(unsigned j=0; j<a.nColumns(); ++j) {
+            // Relative to the geometric mean of the diagonals, so that
+            // small off-diagonal terms don't blow up the ratio.
+            double scale = std::sqrt(std::fabs(b[i][i]*b[j][j]));
+            maxDiff = std::max(maxDiff, std::fabs(a[i][j] - b[i][j])/scale);
+        }
+    }
+    return maxDiff;
+}
+
+
+void compareFits(const BenchCase& bc, bool bounded)
+{
+    measure::PersistenceMap theMap(bc.nBins);
+    makeMap(bc, theMap);
+    tslen_t nData(bc.nBins*bc.nBins);
+    measure::FitLM_PBarrier fitter(nData);
+    if(!bounded) {
+        fitter.clearBounds();
+    }
+    fitter.retainJacobian(true);
+
+    dvector_t params;
+    startParams(bc, params);
+    int status = fitter(params, theMap, LM_FACTOR);
+    const dmatrix_t& fromFit(fitter.covariance());
+
+    measure::FullBarrierModel_t theModel(nData);
+    dmatrix_t explicitCovar(params.size(), params.size());
+    double t0(wallClock());
+    for(unsigned r=0; r<N_REPEATS; ++r) {
+        explicitCovariance(theModel, theMap, params, explicitCovar);
+    }
+    double explicitTime = (wallClock() - t0)/N_REPEATS;
+
+    // The retained Jacobian should be exactly the one at 'params'.
+    int nParams(params.size());
+    dvector_t deltas(nData);
+    dvector_t jacob(nData*nParams);
+    theModel(nData, theMap, nParams, &params[0], &deltas[0], &jacob[0],
+             nData, fortlib::FitLM::ComputeJacobian);
+    const dmatrix_t& retained(fitter.jacobian());
+    double jacobDiff(0.0);
+    for(int j=0; j<nParams; ++j) {
+        for(tslen_t i=0; i<nData; ++i) {
+            jacobDiff = std::max(jacobDiff, std::fabs(retained[j][i]
+                                                      - jacob[i + nData*j]));
+        }
+    }
+
+    // The 1-sigma errors, scaled by the fit's residuals.
+    double scale = fitter.chiSquared()/(nData - params.size());
+    cout << "  " << std::left << setw(9)
+         << (bounded ? "projected" : "lmder") << std::right
+         << " status=" << status << " sigma=[";
+    for(unsigned j=0; j<params.size(); ++j) {
+        cout << (j ? " " : "") << std::scientific << std::setprecision(2)
+             << std::sqrt(scale*fromFit[j][j]);
+    }
+    cout << "] max-rel-diff=" << std::setprecision(2)
+         << maxRelDiff(fromFit, explicitCovar)
+         << " jacobian-diff=" << jacobDiff
+         << " explicit-time=" << std::fixed << std::setprecision(6)
+         << explicitTime << "s" << endl;
+}
+
+
+double timeInversions(const dmatrix_t& dm, bool useSVD)
+{
+    dmatrix_t inv(dm.nRows(), dm.nColumns());
+    double t0(wallClock());
+    for(unsigned r=0; r<N_INVERSIONS; ++r) {
+        if(useSVD) {
+            sqmInvert_SVD(dm, inv);
+        } else {
+            sqmInvert_GJE(dm, inv);
+        }
+    }
+    return (wallClock() - t0)/N_INVERSIONS;
+}
+
+
+int main()
+{
+    cout << "Covariance from the fit vs. explicit inverse(J^T*J):" << endl;
+    for(unsigned c=0; c<N_BENCH_CASES; ++c)
+    {
+        const BenchCase& bc(BENCH_CASES[c]);
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins << "):"
+             << endl;
+        compareFits(bc, false);
+        compareFits(bc, true);
+    }
+
+    // Well-conditioned test matrices:  diagonally dominant.
+    cout << endl << "Mean time per inversion:" << endl;
+    static const unsigned SIZES[] = { 1, 2, 3, 4, 5 };
+    for(unsigned s=0; s<sizeof(SIZES)/sizeof(SIZES[0]); ++s)
+    {
+        unsigned n(SIZES[s]);
+        dmatrix_t dm(n, n);
+        for(unsigned i=0; i<n; ++i) {
+            for(unsigned j=0; j<n; ++j) {
+                dm[i][j] = ( (i == j) ? n + 1.0 : 1.0/(i + j + 1.0) );
+            }
+        }
+        dmatrix_t inv(n, n);
+        sqmInvert_GJE(dm, inv);
+        double maxErr(0.0);
+        for(unsigned i=0; i<n; ++i) {
+            for(unsigned j=0; j<n; ++j) {
+                double sum(0.0);
+                for(unsigned k=0; k<n; ++k) {
+                    sum += dm[i][k]*inv[k][j];
+                }
+                maxErr = std::max(maxErr,
+                                  std::fabs(sum - ((i == j) ? 1.0 : 0.0)));
+            }
+        }
+
+        cout << "  " << n << 'x' << n
+             << ":  GJE=" << std::fixed << std::setprecision(1)
+             << 1.0e9*timeInversions(dm, false) << "ns"
+             << "  SVD=" << 1.0e9*timeInversions(dm, true) << "ns"
+             << "  |A*inv(A) - I|=" << std::scientific
+             << std::setprecision(1) << maxErr << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
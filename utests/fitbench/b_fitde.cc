@@ -0,0 +1,222 @@
+// -*- C++ -*-
+// Benchmark:  FitDE against FitGA, in evaluations to a target chi^2.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_fitde_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+
+#include "PhiloxRNG.h"
+#include "FitLM_BarrierAdapter.h"
+#include "FitGA.h"
+#include "FitDE.h"
+#include "details/FitGA.tcc"
+#include "details/FitDE.tcc"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using jpw_math::statistics::PhiloxRNG;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const unsigned N_SEEDS(4);
+static const double LM_FACTOR(100.0);
+// The targets, as multiples of the LM minimum.  The run stops at the
+// last.
+static const double TARGETS[] = { 10.0, 2.0, 1.01 };
+static const unsigned N_TARGETS = sizeof(TARGETS)/sizeof(TARGETS[0]);
+static const unsigned BENCH_MAPS[] = { 0, 1, 2 };
+static const unsigned N_BENCH_MAPS = ( sizeof(BENCH_MAPS)
+                                       / sizeof(BENCH_MAPS[0]) );
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+typedef measure::FullBarrierModel_t Model_t;
+typedef optimize::FitGA<Model_t, measure::PersistenceMap> FitGA_t;
+typedef optimize::FitDE<Model_t, measure::PersistenceMap> FitDE_t;
+
+
+// Records the evaluations made by the time the best chi^2 reaches each
+// target.
+template<class OPT_T>
+struct TargetMonitor : public fortlib::FitControl::ProgressMonitor
+{
+    TargetMonitor(const OPT_T& optimizer, double chiSqMin)
+        : m__optimizer(optimizer)
+        , m__chiSqMin(chiSqMin)
+    {
+        std::fill(evals, evals+N_TARGETS, 0);
+    }
+
+    bool operator()(unsigned, double chiSq, const double*, index_t)
+    {
+        for(unsigned t=0; t<N_TARGETS; ++t) {
+            if(!evals[t] && (chiSq <= TARGETS[t]*m__chiSqMin)) {
+                evals[t] = m__optimizer.functionEvals();
+            }
+        }
+        return !evals[N_TARGETS-1];
+    }
+
+    const OPT_T& m__optimizer;
+    double m__chiSqMin;
+    unsigned evals[N_TARGETS];
+};
+
+
+struct Tally
+{
+    Tally()
+        : ratioSum(0.0), seconds(0.0), nEvals(0)
+    {
+        std::fill(nHits, nHits+N_TARGETS, 0);
+        std::fill(hitEvals, hitEvals+N_TARGETS, 0);
+    }
+
+    template<class OPT_T>
+    void add(const OPT_T& optimizer, const TargetMonitor<OPT_T>& monitor,
+             double ratio, double t)
+    {
+        ratioSum += ratio;
+        seconds += t;
+        nEvals += optimizer.functionEvals();
+        for(unsigned n=0; n<N_TARGETS; ++n) {
+            if(monitor.evals[n]) {
+                ++nHits[n];
+                hitEvals[n] += monitor.evals[n];
+            }
+        }
+    }
+
+    // For each target, the runs that reached it and their mean
+    // evaluations to it.
+    void print(const char* label) const
+    {
+        cout << "  " << std::left << setw(24) << label << std::right;
+        for(unsigned n=0; n<N_TARGETS; ++n) {
+            cout << ' ' << nHits[n] << '/' << N_SEEDS << '@' << setw(4);
+            if(nHits[n]) {
+                cout << hitEvals[n]/nHits[n];
+            } else {
+                cout << '-';
+            }
+        }
+        cout << "  chi^2/min=" << std::fixed << std::setprecision(2)
+             << setw(5) << ratioSum/N_SEEDS << " f-evals=" << setw(4)
+             << nEvals/N_SEEDS << " time=" << std::setprecision(3)
+             << seconds/N_SEEDS << 's' << endl;
+    }
+
+    double ratioSum;
+    double seconds;
+    unsigned nEvals;
+    unsigned nHits[N_TARGETS];
+    unsigned hitEvals[N_TARGETS];
+};
+
+
+template<class OPT_T>
+void runOptimizer(OPT_T& optimizer, const BenchCase& bc,
+                  const measure::PersistenceMap& theMap, double chiSqMin,
+                  const char* label)
+{
+    Tally tally;
+    for(unsigned s=0; s<N_SEEDS; ++s)
+    {
+        Model_t theModel(bc.nBins*bc.nBins);
+        TargetMonitor<OPT_T> monitor(optimizer, chiSqMin);
+        optimizer.setProgressMonitor(&monitor);
+        optimizer.setRandomStream(PhiloxRNG(BENCH_SEED1, s));
+        dvector_t params;
+        double t0(wallClock());
+        double chiSq(optimizer(params, theMap, theModel));
+        tally.add(optimizer, monitor, chiSq/chiSqMin, wallClock() - t0);
+    }
+    optimizer.setProgressMonitor(0);
+    tally.print(label);
+}
+
+
+int main()
+{
+    for(unsigned m=0; m<N_BENCH_MAPS; ++m)
+    {
+        const BenchCase& bc(BENCH_CASES[BENCH_MAPS[m]]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+
+        // The reference minimum.
+        measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+        dvector_t params;
+        trueParams(bc, params);
+        fitter(params, theMap, LM_FACTOR);
+        double chiSqMin(fitter.chiSquared());
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins
+             << "), LM minimum chi^2=" << std::scientific
+             << std::setprecision(4) << chiSqMin << ", " << N_SEEDS
+             << " streams; runs reaching min x";
+        for(unsigned n=0; n<N_TARGETS; ++n) {
+            cout << ' ' << std::fixed << std::setprecision(2) << TARGETS[n];
+        }
+        cout << " @ mean f-evals:" << endl;
+
+        FitGA_t theGA;
+        runOptimizer(theGA, bc, theMap, chiSqMin, "FitGA");
+
+        FitDE_t theDE;
+        for(unsigned s=0; s<FitDE_t::N_STRATEGIES; ++s)
+        {
+            FitDE_t::Strategy_t strategy(
+                static_cast<FitDE_t::Strategy_t>(s));
+            theDE.setStrategy(strategy);
+            std::string label("FitDE ");
+            label += FitDE_t::strategyName(strategy);
+            runOptimizer(theDE, bc, theMap, chiSqMin, label.c_str());
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,139 @@
+// -*- C++ -*-
+// Benchmark:  FitGA's initial population, pseudo- and quasi-random.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_gainit_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+
+#include "PhiloxRNG.h"
+#include "QuasiRandom.h"
+#include "FitLM_BarrierAdapter.h"
+#include "FitGA.h"
+#include "details/FitGA.tcc"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using jpw_math::statistics::PhiloxRNG;
+using jpw_math::statistics::QuasiRandomSet;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const unsigned N_SEEDS(16);
+static const double LM_FACTOR(100.0);
+static const unsigned INITIAL_SIZES[] = { 200, 100, 50 };
+static const unsigned N_INITIAL_SIZES = ( sizeof(INITIAL_SIZES)
+                                          / sizeof(INITIAL_SIZES[0]) );
+static const unsigned BENCH_MAPS[] = { 0, 1, 2 };
+static const unsigned N_BENCH_MAPS = ( sizeof(BENCH_MAPS)
+                                       / sizeof(BENCH_MAPS[0]) );
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+typedef measure::FullBarrierModel_t Model_t;
+typedef optimize::FitGA<Model_t, measure::PersistenceMap> FitGA_t;
+
+
+int main()
+{
+    for(unsigned m=0; m<N_BENCH_MAPS; ++m)
+    {
+        const BenchCase& bc(BENCH_CASES[BENCH_MAPS[m]]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+
+        // The reference minimum.
+        measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+        dvector_t params;
+        trueParams(bc, params);
+        fitter(params, theMap, LM_FACTOR);
+        double chiSqMin(fitter.chiSquared());
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins
+             << "), LM minimum chi^2=" << std::scientific
+             << std::setprecision(4) << chiSqMin << ", " << N_SEEDS
+             << " streams:" << endl;
+
+        for(unsigned n=0; n<N_INITIAL_SIZES; ++n)
+        {
+            for(unsigned q=0; q<QuasiRandomSet::N_METHODS; ++q)
+            {
+                QuasiRandomSet::Method_t method(
+                    static_cast<QuasiRandomSet::Method_t>(q));
+                FitGA_t theGA;
+                theGA.setInitialPopulationSize(INITIAL_SIZES[n]);
+                theGA.setInitialSampling(method);
+
+                // The geometric means of the best and elite chi^2.
+                double logBest(0.0), logElite(0.0);
+                for(unsigned s=0; s<N_SEEDS; ++s)
+                {
+                    Model_t theModel(bc.nBins*bc.nBins);
+                    theGA.setRandomStream(PhiloxRNG(BENCH_SEED1, s));
+                    trueParams(bc, params);
+                    theGA.begin(params, theMap, theModel);
+                    FitGA_t::popVec_t elite;
+                    dvector_t eliteChiSq;
+                    theGA.emigrants(theGA.nElite(), elite, eliteChiSq);
+                    double chiSq(theGA.end(params, theMap, theModel));
+                    logBest += std::log(chiSq/chiSqMin);
+                    for(unsigned i=0; i<eliteChiSq.size(); ++i) {
+                        logElite += ( std::log(eliteChiSq[i]/chiSqMin)
+                                      / eliteChiSq.size() );
+                    }
+                }
+
+                cout << "  initial=" << setw(3) << INITIAL_SIZES[n] << ' '
+                     << std::left << setw(16)
+                     << QuasiRandomSet::methodName(method) << std::right
+                     << " chi^2/min: best=" << std::fixed
+                     << std::setprecision(1) << setw(7)
+                     << std::exp(logBest/N_SEEDS) << " elite="
+                     << setw(7) << std::exp(logElite/N_SEEDS) << endl;
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
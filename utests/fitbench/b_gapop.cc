@@ -0,0 +1,123 @@
+// -*- C++ -*-
+// Benchmark:  the cost of FitGA's own work, apart from evaluating chi^2.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_gapop_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "PhiloxRNG.h"
+#include "FitGA.h"
+#include "details/FitGA.tcc"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using jpw_math::statistics::PhiloxRNG;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const unsigned N_RUNS(200);
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+// A model whose chi^2 costs next to nothing:  the squared distance from
+// the data.  So the GA's run time is nearly all selection, crossover and
+// mutation.
+struct Paraboloid
+{
+    static const index_t N_PARAMETERS=4;
+
+    explicit Paraboloid(tslen_t) {}
+
+    double chiSquared(const dvector_t& data, const dvector_t& params)
+    {
+        double chiSq(0.0);
+        for(index_t j=0; j<N_PARAMETERS; ++j) {
+            chiSq += (params[j] - data[j])*(params[j] - data[j]);
+        }
+        return chiSq;
+    }
+
+    template<class RNG>
+    static void randomParams(dvector_t& params, RNG& rng)
+    {
+        for(index_t j=0; j<N_PARAMETERS; ++j) {
+            params[j] = rng.range(1.0);
+        }
+    }
+
+    static void limitParams(dvector_t&) {}
+};
+
+
+typedef optimize::FitGA<Paraboloid, dvector_t> FitGA_t;
+
+
+int main()
+{
+    dvector_t target(Paraboloid::N_PARAMETERS, 0.25);
+    Paraboloid theModel(target.size());
+    FitGA_t theGA;
+    dvector_t params;
+
+    // Once untimed, to warm up the caches.
+    theGA.setRandomStream(PhiloxRNG(BENCH_SEED1, N_RUNS));
+    theGA(params, target, theModel);
+
+    double chiSqSum(0.0);
+    double t0(wallClock());
+    for(unsigned r=0; r<N_RUNS; ++r) {
+        theGA.setRandomStream(PhiloxRNG(BENCH_SEED1, r));
+        chiSqSum += theGA(params, target, theModel);
+    }
+    double seconds((wallClock() - t0)/N_RUNS);
+
+    cout << "FitGA on a 4-parameter paraboloid, " << N_RUNS << " runs:"
+         << endl
+         << "  time per run=" << std::fixed << std::setprecision(3)
+         << 1.0e3*seconds << "ms  f-evals per run="
+         << theGA.functionEvals() << "  mean chi^2=" << std::scientific
+         << std::setprecision(3) << chiSqSum/N_RUNS << endl;
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,172 @@
+// -*- C++ -*-
+// Benchmark:  FitGA's stopping rules and runtime settings.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_gastop_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "PhiloxRNG.h"
+#include "FitGA.h"
+#include "LMPolish.h"
+#include "details/FitGA.tcc"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using jpw_math::statistics::PhiloxRNG;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const unsigned N_SEEDS(3);
+static const double LM_FACTOR(100.0);
+// The GA takes long enough that the large map is left out.
+static const unsigned BENCH_MAPS[] = { 0, 1, 2 };
+static const unsigned N_BENCH_MAPS = ( sizeof(BENCH_MAPS)
+                                       / sizeof(BENCH_MAPS[0]) );
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+typedef measure::FullBarrierModel_t Model_t;
+typedef optimize::FitGA<Model_t, measure::PersistenceMap> FitGA_t;
+
+enum Config_t { Defaults, BestStall, MeanStall, FewMutants, Memetic,
+                N_CONFIGS };
+static const char* const CONFIG_LABELS[] = {
+    "defaults",
+    "best stalls 20",
+    "mean stalls 20",
+    "2 mutants, div 0.01",
+    "LM + best stalls 5"
+};
+
+
+// Changes the defaults of theGA for config.
+void configure(FitGA_t& theGA, Config_t config, measure::LMPolish<>& polish)
+{
+    switch(config)
+    {
+    case BestStall:
+        theGA.setStallGenerations(20);
+        break;
+    case MeanStall:
+        theGA.setMeanStallGenerations(20);
+        break;
+    case FewMutants:
+        theGA.setNMutate(2);
+        theGA.setMinDiversity(0.01);
+        break;
+    case Memetic:
+        theGA.setLocalSearch(&polish);
+        theGA.setStallGenerations(5);
+        break;
+    default:
+        break;
+    }
+}
+
+
+int main()
+{
+    for(unsigned m=0; m<N_BENCH_MAPS; ++m)
+    {
+        const BenchCase& bc(BENCH_CASES[BENCH_MAPS[m]]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+
+        // The reference minimum.
+        measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+        dvector_t params;
+        trueParams(bc, params);
+        fitter(params, theMap, LM_FACTOR);
+        double chiSqMin(fitter.chiSquared());
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins
+             << "), LM minimum chi^2=" << std::scientific
+             << std::setprecision(4) << chiSqMin << ", " << N_SEEDS
+             << " streams:" << endl;
+
+        measure::LMPolish<> polish(bc.nBins*bc.nBins);
+        // For the number of generations.
+        measure::FitCapture capture;
+        for(unsigned c=0; c<N_CONFIGS; ++c)
+        {
+            FitGA_t theGA;
+            theGA.setCapture(&capture);
+            configure(theGA, static_cast<Config_t>(c), polish);
+            double ratioSum(0.0), seconds(0.0);
+            unsigned nGenerations(0), nEvals(0);
+            unsigned nReasons[FitGA_t::N_STOP_REASONS] = { 0 };
+            for(unsigned s=0; s<N_SEEDS; ++s)
+            {
+                Model_t theModel(bc.nBins*bc.nBins);
+                theGA.setRandomStream(PhiloxRNG(BENCH_SEED1, s));
+                double t0(wallClock());
+                double chiSq(theGA(params, theMap, theModel));
+                seconds += wallClock() - t0;
+                ratioSum += chiSq/chiSqMin;
+                nGenerations += capture.iterations();
+                nEvals += ( theGA.functionEvals()
+                            + theGA.localSearchEvals() );
+                ++nReasons[theGA.stopReason()];
+            }
+
+            cout << "  " << std::left << setw(20) << CONFIG_LABELS[c]
+                 << std::right << " chi^2/min=" << std::fixed
+                 << std::setprecision(2) << setw(5) << ratioSum/N_SEEDS
+                 << " generations=" << setw(3) << nGenerations/N_SEEDS
+                 << " f-evals=" << setw(4) << nEvals/N_SEEDS
+                 << " time=" << std::setprecision(3) << seconds/N_SEEDS
+                 << 's';
+            for(unsigned r=0; r<FitGA_t::N_STOP_REASONS; ++r) {
+                if(nReasons[r]) {
+                    cout << ' ' << FitGA_t::stopReasonName(
+                        static_cast<FitGA_t::StopReason_t>(r))
+                         << 'x' << nReasons[r];
+                }
+            }
+            cout << endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,126 @@
+// -*- C++ -*-
+// Benchmark:  FitGA, evaluating its population on a ThreadTeam.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_gathreads_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "ThreadTeam.h"
+#include "FitGA.h"
+#include "details/FitGA.tcc"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+// The team sizes to run; 0 is one thread per hardware thread.
+static const unsigned TEAM_SIZES[] = { 2, 4, 0 };
+static const unsigned N_TEAM_SIZES = ( sizeof(TEAM_SIZES)
+                                       / sizeof(TEAM_SIZES[0]) );
+// The GA takes long enough that two maps will do:  the smallest and the
+// largest.
+static const unsigned BENCH_MAPS[] = { 0, 3 };
+static const unsigned N_BENCH_MAPS = ( sizeof(BENCH_MAPS)
+                                       / sizeof(BENCH_MAPS[0]) );
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+typedef optimize::FitGA<measure::FullBarrierModel_t,
+                        measure::PersistenceMap> FitGA_t;
+
+
+// One FitGA run from the benchmark's fixed seed, on 'team' (if any).
+double runGA(const BenchCase& bc, const measure::PersistenceMap& theMap,
+             ThreadTeam* team, dvector_t& params, double& chiSq)
+{
+    FitGA_t theGA;
+    theGA.setThreadTeam(team);
+    measure::FullBarrierModel_t theModel(bc.nBins*bc.nBins);
+    params.clear();
+    jpw_math::statistics::init_rand(BENCH_SEED2, BENCH_SEED1, false);
+
+    double t0(wallClock());
+    chiSq = theGA(params, theMap, theModel);
+    return (wallClock() - t0);
+}
+
+
+int main()
+{
+    for(unsigned m=0; m<N_BENCH_MAPS; ++m)
+    {
+        const BenchCase& bc(BENCH_CASES[BENCH_MAPS[m]]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins << "):"
+             << endl;
+
+        dvector_t serialParams;
+        double serialChiSq;
+        double serialTime(runGA(bc, theMap, 0, serialParams, serialChiSq));
+        cout << "  serial     time=" << std::fixed << std::setprecision(3)
+             << serialTime << "s chi^2=" << std::scientific
+             << std::setprecision(6) << serialChiSq << endl;
+
+        for(unsigned t=0; t<N_TEAM_SIZES; ++t)
+        {
+            ThreadTeam team(TEAM_SIZES[t]);
+            dvector_t params;
+            double chiSq;
+            double seconds(runGA(bc, theMap, &team, params, chiSq));
+            bool identical = ( (chiSq == serialChiSq) &&
+                               (params == serialParams) );
+            cout << "  " << setw(2) << team.size() << " threads"
+                 << " time=" << std::fixed << std::setprecision(3)
+                 << seconds << "s speedup=" << std::setprecision(2)
+                 << serialTime/seconds << "  "
+                 << (identical ? "identical to serial"
+                     : "DIFFERS FROM SERIAL") << endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,191 @@
+// -*- C++ -*-
+// Benchmark:  IslandGA against one large FitGA population.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_islands_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "PhiloxRNG.h"
+#include "ThreadTeam.h"
+#include "IslandGA.h"
+#include "FitLM_BarrierAdapter.h"
+#include "details/FitGA.tcc"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using jpw_math::statistics::PhiloxRNG;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const unsigned N_ISLANDS(4);
+static const unsigned N_SEEDS(4);
+static const double LM_FACTOR(100.0);
+// The GA takes long enough that two maps will do.
+static const unsigned BENCH_MAPS[] = { 0, 1 };
+static const unsigned N_BENCH_MAPS = ( sizeof(BENCH_MAPS)
+                                       / sizeof(BENCH_MAPS[0]) );
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+typedef measure::FullBarrierModel_t Model_t;
+typedef optimize::FitGA<Model_t, measure::PersistenceMap> FitGA_t;
+// One population as large as all of the islands together.
+typedef optimize::FitGA<Model_t, measure::PersistenceMap,
+                        N_ISLANDS*40> BigGA_t;
+typedef optimize::IslandGA<FitGA_t> IslandGA_t;
+
+enum Method_t { Single, Big, Islands, N_METHODS };
+static const char* const METHOD_LABELS[] = { "one GA of 40",
+                                             "one GA of 160",
+                                             "4 islands of 40" };
+
+
+struct Tally
+{
+    Tally() : best(0.0), sum(0.0), worst(0.0), seconds(0.0), nEvals(0) {}
+
+    // Records chi^2 as a multiple of the LM minimum.
+    void add(double chiSq, double chiSqMin, double t, unsigned evals)
+    {
+        double ratio(chiSq/chiSqMin);
+        best = ( (best > 0.0) ? std::min(best, ratio) : ratio );
+        sum += ratio;
+        worst = std::max(worst, ratio);
+        seconds += t;
+        nEvals += evals;
+    }
+
+    double best;
+    double sum;
+    double worst;
+    double seconds;
+    unsigned nEvals;
+};
+
+
+template<class GA_T>
+double runGA(GA_T& theGA, const BenchCase& bc,
+             const measure::PersistenceMap& theMap, unsigned seed,
+             double& seconds)
+{
+    Model_t theModel(bc.nBins*bc.nBins);
+    dvector_t params;
+    theGA.setRandomStream(PhiloxRNG(BENCH_SEED1, seed));
+    double t0(wallClock());
+    double chiSq(theGA(params, theMap, theModel));
+    seconds = wallClock() - t0;
+    return chiSq;
+}
+
+
+int main()
+{
+    ThreadTeam team(N_ISLANDS);
+
+    for(unsigned m=0; m<N_BENCH_MAPS; ++m)
+    {
+        const BenchCase& bc(BENCH_CASES[BENCH_MAPS[m]]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+
+        // The reference minimum.
+        measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+        dvector_t params;
+        trueParams(bc, params);
+        fitter(params, theMap, LM_FACTOR);
+        double chiSqMin(fitter.chiSquared());
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins
+             << "), LM minimum chi^2=" << std::scientific
+             << std::setprecision(4) << chiSqMin << ':' << endl;
+
+        Tally tallies[N_METHODS];
+        for(unsigned s=0; s<N_SEEDS; ++s)
+        {
+            double seconds;
+            FitGA_t single;
+            double chiSq(runGA(single, bc, theMap, s, seconds));
+            tallies[Single].add(chiSq, chiSqMin, seconds,
+                                single.functionEvals());
+
+            BigGA_t big;
+            chiSq = runGA(big, bc, theMap, s, seconds);
+            tallies[Big].add(chiSq, chiSqMin, seconds, big.functionEvals());
+
+            IslandGA_t islands(N_ISLANDS, &team);
+            chiSq = runGA(islands, bc, theMap, s, seconds);
+            tallies[Islands].add(chiSq, chiSqMin, seconds,
+                                 islands.functionEvals());
+
+            // Once, check that the islands don't depend on the threads.
+            if(!s && !m) {
+                IslandGA_t serial(N_ISLANDS);
+                double serialSeconds;
+                double serialChiSq(runGA(serial, bc, theMap, s,
+                                         serialSeconds));
+                cout << "  islands serially time=" << std::fixed
+                     << std::setprecision(3) << serialSeconds
+                     << "s, on " << team.size() << " threads time="
+                     << seconds << "s speedup=" << std::setprecision(2)
+                     << serialSeconds/seconds << "  "
+                     << (serialChiSq == chiSq ? "identical"
+                         : "DIFFERENT") << endl;
+            }
+        }
+
+        for(unsigned k=0; k<N_METHODS; ++k)
+        {
+            const Tally& t(tallies[k]);
+            cout << "  " << std::left << setw(16) << METHOD_LABELS[k]
+                 << std::right << std::fixed << std::setprecision(2)
+                 << " chi^2/min: best=" << setw(5) << t.best << " mean="
+                 << setw(5) << t.sum/N_SEEDS << " worst=" << setw(5)
+                 << t.worst << "  f-evals=" << setw(5)
+                 << t.nEvals/N_SEEDS << " time=" << std::setprecision(3)
+                 << t.seconds/N_SEEDS << 's' << endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
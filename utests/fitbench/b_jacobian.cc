@@ -0,0 +1,182 @@
+// -*- C++ -*-
+// Benchmark:  the Jacobian modes of FitLM_Adapter.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_jacobian_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "ThreadTeam.h"
+#include "FitLM_BarrierAdapter.h"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+static const unsigned N_REPEATS(5);
+// Distances of the starting point from the true parameters.
+static const double START_DISTANCES[] = { 1.0, 3.0 };
+static const unsigned N_START_DISTANCES =
+    sizeof(START_DISTANCES)/sizeof(START_DISTANCES[0]);
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+struct ModeSpec
+{
+    const char* label;
+    fortlib::FitLM::JacobianMode_t mode;
+    bool threaded;
+};
+
+
+static const ModeSpec MODES[] = {
+    { "analytic", fortlib::FitLM::AnalyticJacobian, false },
+    { "broyden", fortlib::FitLM::BroydenUpdate, false },
+    { "fwd-diff", fortlib::FitLM::ForwardDifference, false },
+    { "ctr-diff", fortlib::FitLM::CentralDifference, false },
+    { "fwd-diff*", fortlib::FitLM::ForwardDifference, true },
+    { "ctr-diff*", fortlib::FitLM::CentralDifference, true },
+};
+static const unsigned N_MODES = sizeof(MODES)/sizeof(MODES[0]);
+
+
+struct FitResult
+{
+    int status;
+    double chiSq;
+    unsigned jacobEvals;
+    unsigned jacobUpdates;
+    tslen_t modelCalls;
+    double seconds;
+};
+
+
+void runFits(measure::FitLM_PBarrier& fitter,
+             const measure::PersistenceMap& theMap,
+             const BenchCase& bc, double distance,
+             const ModeSpec& spec, ThreadTeam& team,
+             FitResult& result)
+{
+    fitter.setJacobianMode(spec.mode);
+    fitter.setThreadTeam(spec.threaded ? &team : 0);
+    dvector_t params;
+    double t0(wallClock());
+    for(unsigned r=0; r<N_REPEATS; ++r) {
+        startParams(bc, params, distance);
+        fitter.theModel().clearCallcount();
+        result.status = fitter(params, theMap, LM_FACTOR);
+    }
+    result.seconds = (wallClock() - t0)/N_REPEATS;
+    result.chiSq = fitter.chiSquared();
+    result.jacobEvals = fitter.jacobianEvals();
+    result.jacobUpdates = fitter.jacobianUpdates();
+    result.modelCalls = fitter.theModel().callcount();
+}
+
+
+void printResult(const char* label, const FitResult& result)
+{
+    cout << "  " << std::left << setw(9) << label << std::right
+         << " status=" << setw(2) << result.status
+         << " chi^2=" << std::scientific << std::setprecision(4)
+         << result.chiSq
+         << " J-evals=" << setw(3) << result.jacobEvals
+         << " J-updates=" << setw(3) << result.jacobUpdates
+         << " model-calls=" << setw(4) << result.modelCalls
+         << " time=" << std::fixed << std::setprecision(4)
+         << result.seconds << "s" << endl;
+}
+
+
+int main()
+{
+    ThreadTeam team;
+    unsigned totalJacobEvals[N_MODES] = { 0 };
+    tslen_t totalModelCalls[N_MODES] = { 0 };
+    double totalTime[N_MODES] = { 0.0 };
+
+    cout << "Modes marked '*' use a ThreadTeam of " << team.size()
+         << " threads." << endl << endl;
+
+    for(unsigned c=0; c<N_BENCH_CASES; ++c)
+    {
+        const BenchCase& bc(BENCH_CASES[c]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+        measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+
+        for(unsigned d=0; d<N_START_DISTANCES; ++d)
+        {
+            cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins
+                 << "), start distance " << std::fixed
+                 << std::setprecision(1) << START_DISTANCES[d] << ':'
+                 << endl;
+
+            for(unsigned m=0; m<N_MODES; ++m)
+            {
+                FitResult result;
+                runFits(fitter, theMap, bc, START_DISTANCES[d], MODES[m],
+                        team, result);
+                printResult(MODES[m].label, result);
+
+                totalJacobEvals[m] += result.jacobEvals;
+                totalModelCalls[m] += result.modelCalls;
+                totalTime[m] += result.seconds;
+            }
+        }
+    }
+
+    cout << endl << "Totals:" << endl;
+    for(unsigned m=0; m<N_MODES; ++m) {
+        cout << "  " << std::left << setw(9) << MODES[m].label << std::right
+             << " ComputeJacobian calls=" << setw(4) << totalJacobEvals[m]
+             << " model-calls=" << setw(5) << totalModelCalls[m]
+             << " time-to-solution=" << std::fixed << std::setprecision(4)
+             << totalTime[m] << "s" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,150 @@
+// -*- C++ -*-
+// Benchmark:  fitting maps with undefined elements.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_masked_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+
+#include "FitLM_BarrierAdapter.h"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+static const unsigned N_REPEATS(10);
+// The fraction of the phases with a constant timeseries.
+static const double CONSTANT_FRACTION(0.1);
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+// Sets the elements of 'theMap' to jpw_math::HUGE wherever
+// PersistenceMap::computePersistence() would, if the timeseries were
+// constant at phases [q0, q0+nq).  Those are the elements at one of those
+// phases, or lagged back to one.
+void maskPhases(measure::PersistenceMap& theMap, unsigned q0, unsigned nq)
+{
+    unsigned n(theMap.nRows());
+    jpw_math::dmatrix_t masked(theMap.data());
+    for(unsigned i=0; i<n; ++i) {
+        for(unsigned j=0; j<n; ++j) {
+            unsigned lagged((i + n - j)%n);
+            if( ((i >= q0) && (i < q0+nq)) ||
+                ((lagged >= q0) && (lagged < q0+nq)) )
+            {
+                masked[i][j] = jpw_math::HUGE;
+            }
+        }
+    }
+    theMap.swap_map(masked);
+}
+
+
+// The largest relative error of the unscaled parameters in 'params'.
+double paramError(const BenchCase& bc, dvector_t params)
+{
+    using measure::FullBarrierModel_t;
+    FullBarrierModel_t::canonicalParams(params);
+    double fitted[] = { params[0],
+                        FullBarrierModel_t::descale_ampl(params[1]),
+                        FullBarrierModel_t::descale_width(params[2]),
+                        FullBarrierModel_t::descale_tau(params[3]) };
+    double truth[] = { bc.beta, bc.ampl, bc.width, bc.tau };
+    double worst(0.0);
+    for(unsigned j=0; j<FullBarrierModel_t::N_PARAMETERS; ++j) {
+        double err(std::fabs(fitted[j] - truth[j])/truth[j]);
+        if(err > worst) {
+            worst = err;
+        }
+    }
+    return worst;
+}
+
+
+void fitAndReport(const char* label, const BenchCase& bc,
+                  const measure::PersistenceMap& theMap)
+{
+    measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+    dvector_t params;
+    int status(0);
+    double t0(wallClock());
+    for(unsigned r=0; r<N_REPEATS; ++r) {
+        startParams(bc, params);
+        status = fitter(params, theMap, LM_FACTOR);
+    }
+    double seconds((wallClock() - t0)/N_REPEATS);
+
+    cout << "  " << std::left << setw(7) << label << std::right
+         << " points=" << setw(5) << theMap.size()
+         << " status=" << status
+         << " f-evals=" << setw(3) << fitter.functionEvals()
+         << " time=" << std::fixed << std::setprecision(4) << seconds
+         << "s  chi^2/point=" << std::scientific << std::setprecision(2)
+         << fitter.chiSquared()/theMap.size()
+         << " param-error=" << paramError(bc, params) << endl;
+}
+
+
+int main()
+{
+    for(unsigned c=0; c<N_BENCH_CASES; ++c)
+    {
+        const BenchCase& bc(BENCH_CASES[c]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins << "):"
+             << endl;
+        fitAndReport("clean", bc, theMap);
+
+        unsigned nConstant(static_cast<unsigned>(CONSTANT_FRACTION*bc.nBins
+                                                 + 0.5));
+        maskPhases(theMap, bc.nBins/2, nConstant);
+        fitAndReport("masked", bc, theMap);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
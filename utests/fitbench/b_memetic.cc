@@ -0,0 +1,175 @@
+// -*- C++ -*-
+// Benchmark:  FitGA with and without LM polishing of its elite.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_memetic_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "PhiloxRNG.h"
+#include "FitGA.h"
+#include "LMPolish.h"
+#include "details/FitGA.tcc"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using jpw_math::statistics::PhiloxRNG;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const unsigned N_SEEDS(4);
+static const double LM_FACTOR(100.0);
+// The GA takes long enough that two maps will do.
+static const unsigned BENCH_MAPS[] = { 0, 1 };
+static const unsigned N_BENCH_MAPS = ( sizeof(BENCH_MAPS)
+                                       / sizeof(BENCH_MAPS[0]) );
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+typedef measure::FullBarrierModel_t Model_t;
+typedef optimize::FitGA<Model_t, measure::PersistenceMap> LongGA_t;
+typedef optimize::FitGA<Model_t, measure::PersistenceMap, 40, 20> ShortGA_t;
+
+
+struct Tally
+{
+    Tally()
+        : sum(0.0), worst(0.0), seconds(0.0)
+        , nEvals(0), nLMEvals(0), nJacobians(0)
+    {}
+
+    // Records chi^2 as a multiple of the LM minimum.
+    template<class GA_T>
+    void add(const GA_T& theGA, double chiSq, double chiSqMin, double t)
+    {
+        double ratio(chiSq/chiSqMin);
+        sum += ratio;
+        worst = std::max(worst, ratio);
+        seconds += t;
+        nEvals += theGA.functionEvals();
+        nLMEvals += theGA.localSearchEvals();
+        nJacobians += theGA.localSearchJacobians();
+    }
+
+    void print(const char* label) const
+    {
+        cout << "  " << std::left << setw(22) << label << std::right
+             << std::fixed << std::setprecision(2) << " chi^2/min: mean="
+             << setw(5) << sum/N_SEEDS << " worst=" << setw(5) << worst
+             << "  f-evals: GA=" << setw(4) << nEvals/N_SEEDS << " LM="
+             << setw(3) << nLMEvals/N_SEEDS << "+" << setw(3)
+             << nJacobians/N_SEEDS << "J time=" << std::setprecision(3)
+             << seconds/N_SEEDS << 's' << endl;
+    }
+
+    double sum;
+    double worst;
+    double seconds;
+    unsigned nEvals;
+    unsigned nLMEvals;
+    unsigned nJacobians;
+};
+
+
+template<class GA_T>
+void runGA(GA_T& theGA, const BenchCase& bc,
+           const measure::PersistenceMap& theMap, double chiSqMin,
+           Tally& tally)
+{
+    for(unsigned s=0; s<N_SEEDS; ++s)
+    {
+        Model_t theModel(bc.nBins*bc.nBins);
+        dvector_t params;
+        theGA.setRandomStream(PhiloxRNG(BENCH_SEED1, s));
+        double t0(wallClock());
+        double chiSq(theGA(params, theMap, theModel));
+        tally.add(theGA, chiSq, chiSqMin, wallClock() - t0);
+    }
+}
+
+
+int main()
+{
+    for(unsigned m=0; m<N_BENCH_MAPS; ++m)
+    {
+        const BenchCase& bc(BENCH_CASES[BENCH_MAPS[m]]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+
+        // The reference minimum.
+        measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+        dvector_t params;
+        trueParams(bc, params);
+        fitter(params, theMap, LM_FACTOR);
+        double chiSqMin(fitter.chiSquared());
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins
+             << "), LM minimum chi^2=" << std::scientific
+             << std::setprecision(4) << chiSqMin << ", "
+             << N_SEEDS << " streams:" << endl;
+
+        measure::LMPolish<> polish(bc.nBins*bc.nBins);
+
+        LongGA_t longGA;
+        Tally longPlain;
+        runGA(longGA, bc, theMap, chiSqMin, longPlain);
+        longPlain.print("100 generations");
+
+        ShortGA_t shortGA;
+        Tally shortPlain;
+        runGA(shortGA, bc, theMap, chiSqMin, shortPlain);
+        shortPlain.print("20 generations");
+
+        shortGA.setLocalSearch(&polish);
+        Tally shortMemetic;
+        runGA(shortGA, bc, theMap, chiSqMin, shortMemetic);
+        shortMemetic.print("20 generations + LM");
+
+        longGA.setLocalSearch(&polish);
+        Tally longMemetic;
+        runGA(longGA, bc, theMap, chiSqMin, longMemetic);
+        longMemetic.print("100 generations + LM");
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,136 @@
+// -*- C++ -*-
+// Benchmark:  multi-start LM fits from random starting points.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_multistart_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "ThreadTeam.h"
+#include "MultiStartLM.h"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+static const unsigned N_STARTS(16);
+static const unsigned N_THREADS(4);
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+typedef measure::MultiStartLM<> MultiStart_t;
+
+
+void runMultiStart(MultiStart_t& driver, const BenchCase& bc,
+                   const measure::PersistenceMap& theMap, bool prune)
+{
+    // The same starting points for every run.
+    jpw_math::statistics::init_rand(BENCH_SEED2, BENCH_SEED1, false);
+    driver.clearStarts();
+    driver.addRandomStarts(N_STARTS);
+    driver.setDominanceRatio(prune ? MultiStart_t::DEFAULT_DOMINANCE_RATIO
+                             : 0.0);
+
+    dvector_t best;
+    double t0(wallClock());
+    int status = driver(best, theMap, LM_FACTOR);
+    double seconds(wallClock() - t0);
+
+    int totalIters(0);
+    for(unsigned k=0; k<driver.nStarts(); ++k) {
+        totalIters += driver.results()[k].iterations;
+    }
+
+    dvector_t truth;
+    trueParams(bc, truth);
+    cout << "  " << std::left << setw(9) << (prune ? "pruned" : "all")
+         << std::right
+         << " status=" << status
+         << " chi^2=" << std::scientific << std::setprecision(4)
+         << driver.minima().front().chiSq
+         << " minima=" << setw(2) << driver.minima().size()
+         << " cancelled=" << setw(2) << driver.nCancelled()
+         << " iterations=" << setw(4) << totalIters
+         << " time=" << std::fixed << std::setprecision(4) << seconds
+         << "s" << endl;
+    if(prune) {
+        return;
+    }
+    for(unsigned m=0; m<driver.minima().size(); ++m) {
+        const MultiStart_t::LocalMinimum& lm(driver.minima()[m]);
+        cout << "    chi^2=" << std::scientific << std::setprecision(4)
+             << lm.chiSq << " starts=" << setw(2) << lm.nStarts
+             << " params=[";
+        for(unsigned j=0; j<lm.params.size(); ++j) {
+            cout << (j ? " " : "") << std::fixed << std::setprecision(4)
+                 << lm.params[j];
+        }
+        cout << "]" << endl;
+    }
+}
+
+
+int main()
+{
+    ThreadTeam team(N_THREADS);
+    cout << N_STARTS << " random starts per map, on " << team.size()
+         << " threads:" << endl;
+
+    for(unsigned c=0; c<N_BENCH_CASES; ++c)
+    {
+        const BenchCase& bc(BENCH_CASES[c]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+        MultiStart_t driver(bc.nBins*bc.nBins, &team);
+
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins << "):"
+             << endl;
+        runMultiStart(driver, bc, theMap, false);
+        runMultiStart(driver, bc, theMap, true);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,157 @@
+// -*- C++ -*-
+// Benchmark:  the cost of each FitLM_BarrierAdapter precision tier.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_precision_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+
+#include "FitLM_BarrierAdapter.h"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+static const unsigned N_REPEATS(10);
+static const double START_DISTANCES[] = { 1.0, 3.0 };
+static const unsigned N_DISTANCES = ( sizeof(START_DISTANCES)
+                                      / sizeof(START_DISTANCES[0]) );
+
+static const char* const PRECISION_LABELS[] = { "screening", "standard",
+                                                "publication",
+                                                "scheduled" };
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+typedef measure::FitLM_PBarrier Fitter_t;
+
+
+// Publication first:  the others are compared against it.
+static const Fitter_t::Precision_t RUN_ORDER[] = {
+    Fitter_t::Publication, Fitter_t::Screening, Fitter_t::Standard,
+    Fitter_t::Scheduled
+};
+
+
+// The largest difference between two parameter vectors, relative to the
+// magnitude of each element of 'reference'.
+double maxRelDiff(const dvector_t& params, const dvector_t& reference)
+{
+    double worst(0.0);
+    for(unsigned j=0; j<reference.size(); ++j) {
+        double scale(std::fabs(reference[j]) > 1.0e-12
+                     ? std::fabs(reference[j]) : 1.0);
+        double diff(std::fabs(params[j] - reference[j])/scale);
+        if(diff > worst) {
+            worst = diff;
+        }
+    }
+    return worst;
+}
+
+
+int main()
+{
+    unsigned totalIters[Fitter_t::N_PRECISIONS] = { 0, 0, 0, 0 };
+
+    for(unsigned c=0; c<N_BENCH_CASES; ++c)
+    {
+        const BenchCase& bc(BENCH_CASES[c]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+        Fitter_t fitter(bc.nBins*bc.nBins);
+
+        for(unsigned d=0; d<N_DISTANCES; ++d)
+        {
+            cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins
+                 << "), start distance " << std::fixed
+                 << std::setprecision(1) << START_DISTANCES[d] << ':'
+                 << endl;
+
+            dvector_t reference;
+            double referenceChiSq(0.0);
+            for(unsigned p=0; p<Fitter_t::N_PRECISIONS; ++p)
+            {
+                Fitter_t::Precision_t precision(RUN_ORDER[p]);
+                dvector_t params;
+                int status(0);
+                double t0(wallClock());
+                for(unsigned r=0; r<N_REPEATS; ++r) {
+                    startParams(bc, params, START_DISTANCES[d]);
+                    status = fitter(params, theMap, LM_FACTOR, precision);
+                }
+                double seconds((wallClock() - t0)/N_REPEATS);
+                if(precision == Fitter_t::Publication) {
+                    reference = params;
+                    referenceChiSq = fitter.chiSquared();
+                }
+                totalIters[precision] += fitter.iterations();
+
+                cout << "  " << std::left << setw(11)
+                     << PRECISION_LABELS[precision] << std::right
+                     << " status=" << status
+                     << " iterations=" << setw(3) << fitter.iterations()
+                     << " f-evals=" << setw(3) << fitter.functionEvals()
+                     << " time=" << std::fixed << std::setprecision(4)
+                     << seconds << "s  d(chi^2)=" << std::scientific
+                     << std::setprecision(1) << setw(8)
+                     << (fitter.chiSquared() - referenceChiSq)
+                     /referenceChiSq
+                     << " d(params)=" << maxRelDiff(params, reference)
+                     << endl;
+            }
+        }
+    }
+
+    cout << endl << "Total iterations:";
+    for(unsigned p=0; p<Fitter_t::N_PRECISIONS; ++p) {
+        cout << ' ' << PRECISION_LABELS[p] << '=' << totalIters[p];
+    }
+    cout << endl;
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,208 @@
+// -*- C++ -*-
+// Benchmark:  coarse-to-fine (pyramid) vs. direct fits of large maps.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_pyramid_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "FitLM_Pyramid.h"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+static const unsigned N_REPEATS(2);
+
+// The maps:  the "large" standard case, and a daily map.
+static const BenchCase PYRAMID_CASES[] = {
+    BENCH_CASES[3],
+    { "daily", 365, 0.45, 0.60, 0.15, 0.80, 0.01 },
+};
+static const unsigned N_PYRAMID_CASES =
+    sizeof(PYRAMID_CASES)/sizeof(PYRAMID_CASES[0]);
+
+// Distances of the starting point from the true parameters.  A negative
+// distance means a start from edgeParams().
+static const double START_DISTANCES[] = { 1.0, 3.0, -1.0 };
+static const unsigned N_START_DISTANCES =
+    sizeof(START_DISTANCES)/sizeof(START_DISTANCES[0]);
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+struct FitResult
+{
+    int status;
+    double chiSq;
+    // Iterations on the full map.
+    int iterations;
+    // Points at which the model was evaluated, over all levels.
+    double modelPoints;
+    double seconds;
+};
+
+
+void initParams(const BenchCase& bc, double distance, dvector_t& params)
+{
+    if(distance < 0.0) {
+        edgeParams(bc, params);
+    } else {
+        startParams(bc, params, distance);
+    }
+}
+
+
+// The number of points at which 'fitter' evaluated its model in the last
+// fit.  (A Jacobian costs about as much as two function evaluations.)
+template<class ADAPTER_T>
+double modelPoints(const ADAPTER_T& fitter, unsigned nBins)
+{
+    return ( (fitter.functionEvals() + 2.0*fitter.iterations())*
+             nBins*nBins );
+}
+
+
+void runDirect(const measure::PersistenceMap& theMap,
+               const BenchCase& bc, double distance, FitResult& result)
+{
+    measure::FitLM_PBarrier fitter(bc.nBins*bc.nBins);
+    dvector_t params;
+    double t0(wallClock());
+    for(unsigned r=0; r<N_REPEATS; ++r) {
+        initParams(bc, distance, params);
+        result.status = fitter(params, theMap, LM_FACTOR);
+    }
+    result.seconds = (wallClock() - t0)/N_REPEATS;
+    result.chiSq = fitter.chiSquared();
+    result.iterations = fitter.iterations();
+    result.modelPoints = modelPoints(fitter, bc.nBins);
+}
+
+
+void runPyramid(measure::FitLM_Pyramid<>& pyramid,
+                const measure::PersistenceMap& theMap,
+                const BenchCase& bc, double distance, FitResult& result)
+{
+    dvector_t params;
+    double t0(wallClock());
+    for(unsigned r=0; r<N_REPEATS; ++r) {
+        initParams(bc, distance, params);
+        result.status = pyramid(params, theMap, LM_FACTOR);
+    }
+    result.seconds = (wallClock() - t0)/N_REPEATS;
+    result.chiSq = pyramid.chiSquared();
+    unsigned iFull = pyramid.nLevels() - 1;
+    result.iterations = pyramid.adapter(iFull).iterations();
+    result.modelPoints = 0.0;
+    for(unsigned k=0; k<=iFull; ++k) {
+        result.modelPoints += modelPoints(pyramid.adapter(k),
+                                          pyramid.levelBins(k));
+    }
+}
+
+
+void printResult(const char* label, const FitResult& result)
+{
+    cout << "  " << std::left << setw(8) << label << std::right
+         << " status=" << setw(2) << result.status
+         << " chi^2=" << std::scientific << std::setprecision(4)
+         << result.chiSq
+         << " full-map iterations=" << setw(3) << result.iterations
+         << " model-points=" << std::setprecision(2) << result.modelPoints
+         << " time=" << std::fixed << std::setprecision(4)
+         << result.seconds << "s" << endl;
+}
+
+
+int main()
+{
+    static const char* const LABELS[2] = { "direct", "pyramid" };
+    double totalTime[2] = { 0.0, 0.0 };
+
+    for(unsigned c=0; c<N_PYRAMID_CASES; ++c)
+    {
+        const BenchCase& bc(PYRAMID_CASES[c]);
+        measure::PersistenceMap theMap(bc.nBins);
+        makeMap(bc, theMap);
+        measure::FitLM_Pyramid<> pyramid(bc.nBins);
+
+        cout << bc.name << " (" << bc.nBins << 'x' << bc.nBins
+             << "), levels:";
+        for(unsigned k=0; k<pyramid.nLevels(); ++k) {
+            cout << ' ' << pyramid.levelBins(k);
+        }
+        cout << endl;
+
+        for(unsigned d=0; d<N_START_DISTANCES; ++d)
+        {
+            if(START_DISTANCES[d] < 0.0) {
+                cout << " start near the domain's edge:" << endl;
+            } else {
+                cout << " start distance " << std::fixed
+                     << std::setprecision(1) << START_DISTANCES[d] << ':'
+                     << endl;
+            }
+
+            FitResult result;
+            runDirect(theMap, bc, START_DISTANCES[d], result);
+            printResult(LABELS[0], result);
+            totalTime[0] += result.seconds;
+
+            runPyramid(pyramid, theMap, bc, START_DISTANCES[d], result);
+            printResult(LABELS[1], result);
+            totalTime[1] += result.seconds;
+        }
+    }
+
+    cout << endl << "Totals:" << endl;
+    for(unsigned b=0; b<2; ++b) {
+        cout << "  " << std::left << setw(8) << LABELS[b] << std::right
+             << " time-to-solution=" << std::fixed << std::setprecision(4)
+             << totalTime[b] << "s" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,198 @@
+// -*- C++ -*-
+// Benchmark:  the PhiloxRNG against drand48(), and reproducible FitGA
+// streams.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_rngstreams_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+
+#include "PhiloxRNG.h"
+#include "ThreadTeam.h"
+#include "FitGA.h"
+#include "details/FitGA.tcc"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using jpw_math::statistics::PhiloxRNG;
+using jpw_math::statistics::Rand48;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const unsigned N_DRAWS(10000000);
+static const unsigned N_PARAM_DRAWS(1000000);
+// In the format of parseSeed().
+static const char* const GA_SEED = "5eed0000cafe";
+static const unsigned N_STREAMS(2);
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+typedef optimize::FitGA<measure::FullBarrierModel_t,
+                        measure::PersistenceMap> FitGA_t;
+
+
+// The seconds per draw, and a sum to keep the draws from being optimized
+// away.
+template<class RNG>
+double timeUniform(RNG& rng, double& sum)
+{
+    double t0(wallClock());
+    for(unsigned i=0; i<N_DRAWS; ++i) {
+        sum += rng.uniform();
+    }
+    return (wallClock() - t0)/N_DRAWS;
+}
+
+
+template<class RNG>
+double timeRandomParams(RNG& rng, double& sum)
+{
+    dvector_t params(measure::FullBarrierModel_t::N_PARAMETERS);
+    double t0(wallClock());
+    for(unsigned i=0; i<N_PARAM_DRAWS; ++i) {
+        measure::FullBarrierModel_t::randomParams(params, rng);
+        sum += params[0];
+    }
+    return (wallClock() - t0)/N_PARAM_DRAWS;
+}
+
+
+struct GARun
+{
+    dvector_t params;
+    double chiSq;
+    double seconds;
+
+    bool operator==(const GARun& other) const
+    { return ( (chiSq == other.chiSq) && (params == other.params) ); }
+};
+
+
+// One FitGA run on stream 'stream' of GA_SEED.
+void runGA(const BenchCase& bc, const measure::PersistenceMap& theMap,
+           unsigned stream, GARun& result)
+{
+    FitGA_t theGA;
+    theGA.setRandomStream(PhiloxRNG(GA_SEED, stream));
+    measure::FullBarrierModel_t theModel(bc.nBins*bc.nBins);
+    result.params.clear();
+
+    double t0(wallClock());
+    result.chiSq = theGA(result.params, theMap, theModel);
+    result.seconds = wallClock() - t0;
+}
+
+
+// Runs the GA on stream 'i', concurrently with the others.
+struct ConcurrentGAs : public ThreadTeam::Task
+{
+    ConcurrentGAs(const BenchCase& bc, const measure::PersistenceMap& theMap,
+                  GARun* results)
+        : m__bc(bc)
+        , m__map(theMap)
+        , m__results(results)
+    {}
+
+    void operator()(unsigned i, unsigned /*iThread*/)
+    { runGA(m__bc, m__map, i, m__results[i]); }
+
+    const BenchCase& m__bc;
+    const measure::PersistenceMap& m__map;
+    GARun* m__results;
+};
+
+
+int main()
+{
+    double sum(0.0);
+    jpw_math::statistics::init_rand(BENCH_SEED2, BENCH_SEED1, false);
+    Rand48 rand48;
+    PhiloxRNG philox(GA_SEED);
+
+    cout << "Per draw:" << endl
+         << "  uniform()       drand48=" << std::fixed
+         << std::setprecision(2) << 1.0e9*timeUniform(rand48, sum)
+         << "ns Philox=" << 1.0e9*timeUniform(philox, sum) << "ns" << endl
+         << "  randomParams()  drand48="
+         << 1.0e9*timeRandomParams(rand48, sum)
+         << "ns Philox=" << 1.0e9*timeRandomParams(philox, sum) << "ns"
+         << endl;
+
+    // The GA takes long enough that one map will do.
+    const BenchCase& bc(BENCH_CASES[0]);
+    measure::PersistenceMap theMap(bc.nBins);
+    makeMap(bc, theMap);
+    cout << endl << bc.name << " (" << bc.nBins << 'x' << bc.nBins
+         << "), FitGA seed " << GA_SEED << ':' << endl;
+
+    // The drand48() pRNG is reseeded between runs; it mustn't matter.
+    GARun serial[N_STREAMS], repeat[N_STREAMS], concurrent[N_STREAMS];
+    for(unsigned s=0; s<N_STREAMS; ++s) {
+        runGA(bc, theMap, s, serial[s]);
+        jpw_math::statistics::init_rand(BENCH_SEED1 + s, BENCH_SEED2,
+                                        false);
+        runGA(bc, theMap, s, repeat[s]);
+    }
+    ThreadTeam team(N_STREAMS);
+    ConcurrentGAs task(bc, theMap, concurrent);
+    team.run(task, N_STREAMS);
+
+    for(unsigned s=0; s<N_STREAMS; ++s)
+    {
+        cout << "  stream " << s << " chi^2=" << std::scientific
+             << std::setprecision(6) << serial[s].chiSq << " time="
+             << std::fixed << std::setprecision(3) << serial[s].seconds
+             << "s  repeat "
+             << (repeat[s] == serial[s] ? "identical" : "DIFFERS")
+             << ", concurrent "
+             << (concurrent[s] == serial[s] ? "identical" : "DIFFERS")
+             << endl;
+    }
+
+    // Print the sum, so that the draws can't be optimized away.
+    cout << endl << "(checksum " << std::setprecision(1) << sum << ')'
+         << endl;
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,186 @@
+// -*- C++ -*-
+// Benchmark:  warm-starting fits of a drifting sequence of maps.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_warmstart_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstdio>
+
+#include "WarmStartIndex.h"
+#include "FitLM_BarrierAdapter.h"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+// The length of the sequence of maps, and the number of passes over it.
+static const unsigned N_MAPS(40);
+static const unsigned N_PASSES(2);
+// The parameters drift from BENCH_CASES[0] by this much over the
+// sequence.
+static const double BETA_DRIFT(0.3);
+static const double AMPL_DRIFT(-0.2);
+static const double TAU_DRIFT(0.6);
+// Fall back to the cold start if the nearest map is farther than this.
+static const double MAX_DISTANCE(0.05);
+static const char* const INDEX_FILE = "b_warmstart.idx";
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+// The k'th map in the sequence.
+BenchCase sequenceCase(unsigned k)
+{
+    BenchCase bc(BENCH_CASES[0]);
+    double t = static_cast<double>(k)/(N_MAPS - 1);
+    bc.beta += BETA_DRIFT*t;
+    bc.ampl += AMPL_DRIFT*t;
+    bc.tau += TAU_DRIFT*t;
+    return bc;
+}
+
+
+struct PassResult
+{
+    unsigned nWarm;
+    int iterations;
+    double lookupSeconds;
+    double fitSeconds;
+    double chiSqSum;
+};
+
+
+// Fits every map in 'maps'.  With a non-null 'index', each fit starts from
+// the nearest entry (if it's close enough), and its result is added to the
+// index.  Otherwise, each fit starts from startParams().
+void runPass(const std::vector<measure::PersistenceMap>& maps,
+             measure::WarmStartIndex* index, PassResult& result)
+{
+    result.nWarm = 0;
+    result.iterations = 0;
+    result.lookupSeconds = 0.0;
+    result.fitSeconds = 0.0;
+    result.chiSqSum = 0.0;
+
+    measure::FitLM_PBarrier fitter(maps[0].size());
+    dvector_t params;
+    for(unsigned k=0; k<maps.size(); ++k)
+    {
+        double distance(0.0);
+        double t0(wallClock());
+        bool warm = ( index && index->nearest(maps[k], params, distance) &&
+                      (distance <= MAX_DISTANCE) );
+        double t1(wallClock());
+        if(!warm) {
+            startParams(sequenceCase(k), params, 3.0);
+        }
+
+        int status = fitter(params, maps[k], LM_FACTOR);
+        double t2(wallClock());
+
+        if( index && (status > 0) && (status < fortlib::FitLM::MachinePrec) )
+        {
+            index->insert(maps[k], params, fitter.chiSquared());
+        }
+
+        result.nWarm += (warm ? 1 : 0);
+        result.iterations += fitter.iterations();
+        result.lookupSeconds += t1 - t0;
+        result.fitSeconds += t2 - t1;
+        result.chiSqSum += fitter.chiSquared();
+    }
+}
+
+
+void printResult(const char* label, const PassResult& result)
+{
+    cout << "  " << std::left << setw(16) << label << std::right
+         << " warm-starts=" << setw(2) << result.nWarm
+         << " iterations=" << setw(3) << result.iterations
+         << " sum(chi^2)=" << std::scientific << std::setprecision(4)
+         << result.chiSqSum
+         << " lookup=" << std::fixed << std::setprecision(5)
+         << result.lookupSeconds << "s"
+         << " fits=" << std::setprecision(4) << result.fitSeconds << "s"
+         << endl;
+}
+
+
+int main()
+{
+    std::vector<measure::PersistenceMap> maps;
+    for(unsigned k=0; k<N_MAPS; ++k) {
+        BenchCase bc(sequenceCase(k));
+        maps.push_back(measure::PersistenceMap(bc.nBins));
+        makeMap(bc, maps.back());
+    }
+
+    cout << N_MAPS << " maps (" << maps[0].nRows() << 'x'
+         << maps[0].nColumns() << "), drifting from the \""
+         << BENCH_CASES[0].name << "\" case:" << endl;
+
+    PassResult result;
+    runPass(maps, 0, result);
+    printResult("cold", result);
+
+    const index_t nParams(measure::FullBarrierModel_t::N_PARAMETERS);
+    measure::WarmStartIndex index(nParams);
+    for(unsigned p=0; p<N_PASSES; ++p) {
+        runPass(maps, &index, result);
+        printResult( (p ? "warm, full index" : "warm, rolling"), result);
+    }
+
+    // Round-trip the index through a file.
+    index.save(INDEX_FILE);
+    measure::WarmStartIndex reloaded(nParams);
+    reloaded.load(INDEX_FILE);
+    std::remove(INDEX_FILE);
+    runPass(maps, &reloaded, result);
+    printResult("warm, reloaded", result);
+    cout << "  (index holds " << reloaded.size() << " entries)" << endl;
+
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,179 @@
+// -*- C++ -*-
+// Benchmark:  heap use of fitters built per job, pooled, or resized.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+b_workspace_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "FitLM_WorkspacePool.h"
+#include "FitLM_BarrierAdapter.h"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::endl;
+using std::setw;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using namespace fitbench;
+
+
+//
+// Static variables
+//
+
+
+static const double LM_FACTOR(100.0);
+// Each job fits one of the standard maps, cycling through them.
+static const unsigned N_JOBS(40);
+
+// Heap usage, counted by the replacement operator new, below.
+static unsigned long g_nAllocs(0);
+static unsigned long g_nBytes(0);
+
+
+/////////////////////////
+
+//
+// Heap Counting
+//
+
+
+void* operator new(std::size_t nBytes) throw(std::bad_alloc)
+{
+    ++g_nAllocs;
+    g_nBytes += nBytes;
+    void* p = std::malloc(nBytes ? nBytes : 1);
+    if(!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+
+void operator delete(void* p) throw()
+{
+    std::free(p);
+}
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+struct HeapUse
+{
+    unsigned long nAllocs;
+    unsigned long nBytes;
+    // Heap use inside of the fits alone.
+    unsigned long nFitAllocs;
+    double seconds;
+};
+
+
+enum Strategy_t { PerJob, Pooled, Resized };
+
+
+void runJobs(Strategy_t strategy,
+             const std::vector<measure::PersistenceMap*>& maps,
+             HeapUse& use)
+{
+    fortlib::FitLM_WorkspacePool pool;
+    measure::FitLM_PBarrier reused(maps[0]->size());
+    dvector_t params;
+    params.reserve(measure::FullBarrierModel_t::N_PARAMETERS);
+
+    use.nFitAllocs = 0;
+    unsigned long allocs0(g_nAllocs), bytes0(g_nBytes);
+    double t0(wallClock());
+    for(unsigned k=0; k<N_JOBS; ++k)
+    {
+        const measure::PersistenceMap& theMap(*maps[k%maps.size()]);
+        startParams(BENCH_CASES[k%N_BENCH_CASES], params);
+
+        unsigned long fitAllocs0;
+        if(strategy == Resized) {
+            reused.resize(theMap.size());
+            fitAllocs0 = g_nAllocs;
+            reused(params, theMap, LM_FACTOR);
+        } else {
+            measure::FitLM_PBarrier fitter(theMap.size(),
+                                           (strategy == Pooled) ?
+                                           &pool : 0);
+            fitAllocs0 = g_nAllocs;
+            fitter(params, theMap, LM_FACTOR);
+        }
+        use.nFitAllocs += g_nAllocs - fitAllocs0;
+    }
+    use.seconds = wallClock() - t0;
+    use.nAllocs = g_nAllocs - allocs0;
+    use.nBytes = g_nBytes - bytes0;
+}
+
+
+int main()
+{
+    std::vector<measure::PersistenceMap*> maps;
+    for(unsigned c=0; c<N_BENCH_CASES; ++c) {
+        maps.push_back(new measure::PersistenceMap(BENCH_CASES[c].nBins));
+        makeMap(BENCH_CASES[c], *maps.back());
+    }
+
+    static const char* const LABELS[3] = { "per-job", "pooled",
+                                           "resized" };
+    cout << N_JOBS << " jobs, cycling through map sizes";
+    for(unsigned c=0; c<N_BENCH_CASES; ++c) {
+        cout << (c ? ", " : " ") << BENCH_CASES[c].nBins << 'x'
+             << BENCH_CASES[c].nBins;
+    }
+    cout << ':' << endl;
+
+    for(unsigned s=0; s<3; ++s)
+    {
+        HeapUse use;
+        runJobs(static_cast<Strategy_t>(s), maps, use);
+        cout << "  " << std::left << setw(8) << LABELS[s] << std::right
+             << " allocations=" << setw(5) << use.nAllocs
+             << " in-fit=" << setw(3) << use.nFitAllocs
+             << " MB=" << std::fixed << std::setprecision(2) << setw(7)
+             << use.nBytes/1048576.0
+             << " time=" << std::setprecision(4) << use.seconds << "s"
+             << endl;
+    }
+
+    for(unsigned c=0; c<maps.size(); ++c) {
+        delete maps[c];
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,383 @@
+// -*- C++ -*-
+// Reruns fits recorded by a FitCapture, reporting per-iteration timings.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+fitreplay_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "FitCapture.h"
+#include "FitLM_BarrierAdapter.h"
+#include "FitGA.h"
+#include "details/FitGA.tcc"
+#include "details/BarrierModels.tcc"
+#include "details/Matrix.tcc"
+
+#include "BenchMaps.h"
+
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::setw;
+using std::string;
+using namespace jpw_nld;
+using jpw_math::dvector_t;
+using measure::FitCapture;
+using fitbench::wallClock;
+
+
+//
+// Static variables
+//
+
+
+static const unsigned DEFAULT_REPEATS(1);
+
+
+/////////////////////////
+
+//
+// Functions
+//
+
+
+/// Times each iteration (or generation) of a fit.
+/**
+ * Row \c k holds the time from the \c k'th progress report to the next
+ * one.  Row 0 starts at the beginning of the fit, so it includes the
+ * setup.
+ */
+struct IterationTimer : public fortlib::FitControl::ProgressMonitor
+{
+    std::vector<double> seconds;
+    std::vector<double> chiSq;
+    unsigned nRepeats;
+    // Set if the repeats took different numbers of iterations.
+    bool differed;
+
+    IterationTimer() : nRepeats(0), differed(false), m__last(0.0),
+                       m__row(0) {}
+
+    void startRepeat()
+    {
+        if(nRepeats && (m__row != seconds.size())) {
+            differed = true;
+        }
+        ++nRepeats;
+        m__row = 0;
+        m__last = wallClock();
+    }
+
+    virtual bool operator()(unsigned, double chi, const double*, index_t)
+    {
+        double now(wallClock());
+        if(m__row == seconds.size()) {
+            seconds.push_back(0.0);
+            chiSq.push_back(chi);
+        }
+        seconds[m__row] += now - m__last;
+        ++m__row;
+        m__last = now;
+        return true;
+    }
+
+private:
+    double m__last;
+    unsigned m__row;
+};
+
+
+struct ReplayResult
+{
+    int status;
+    double chiSq;
+    dvector_t params;
+    unsigned iterations;
+    unsigned functionEvals;
+    double seconds;
+};
+
+
+template<class F_POL_T>
+void replayLM(const FitCapture& capture, unsigned nRepeats,
+              IterationTimer& timer, ReplayResult& result)
+{
+    typedef measure::FitLM_BarrierAdapter<F_POL_T> Fitter_t;
+    typedef fortlib::FitLM_Adapter<typename Fitter_t::Model_t,
+                                   measure::PersistenceMap> Base_t;
+
+    Fitter_t fitter(capture.theMap().size());
+    if(capture.bounds().size()) {
+        fitter.setBounds(capture.bounds());
+    } else {
+        fitter.clearBounds();
+    }
+    fitter.setBackend(static_cast<fortlib::FitLM::Backend_t>
+                      (capture.backend()));
+    fitter.setJacobianMode(static_cast<fortlib::FitLM::JacobianMode_t>
+                           (capture.jacobianMode()));
+
+    fortlib::FitControl control(capture.timeBudget());
+    control.setProgressMonitor(&timer);
+
+    // The base class' operator() takes the captured tolerances.
+    Base_t& base(fitter);
+    double t0(wallClock());
+    for(unsigned r=0; r<nRepeats; ++r)
+    {
+        capture.restoreRandState();
+        result.params = capture.startParams();
+        timer.startRepeat();
+        result.status = base(fitter.theModel(), capture.theMap(),
+                             result.params, capture.errorTolerance(),
+                             capture.paramTolerance(), capture.maxIterations(),
+                             capture.factor(), control);
+    }
+    result.seconds = (wallClock() - t0)/nRepeats;
+    result.chiSq = fitter.chiSquared();
+    // The adapter's own counts only cover its operator()().
+    result.iterations = base.iterations();
+    result.functionEvals = base.functionEvals();
+}
+
+
+template<class F_POL_T>
+void replayGA(const FitCapture& capture, unsigned nRepeats,
+              IterationTimer& timer, ReplayResult& result)
+{
+    typedef measure::BarrierModel<F_POL_T> Model_t;
+    typedef optimize::FitGA<Model_t, measure::PersistenceMap> GA_t;
+
+    // Only the crossover weight is still fixed at compile time.
+    unsigned wideXoverWeightX1000 =
+        static_cast<unsigned>(GA_t::WIDE_XOVER_WEIGHT*1000.0 + 0.5);
+    if(capture.wideXoverWeightX1000() != wideXoverWeightX1000) {
+        throw std::runtime_error("The capture used a non-default FitGA "
+                                 "crossover weight.");
+    }
+
+    GA_t theGA;
+    theGA.setPopulationSize(capture.populationSize());
+    theGA.setNGenerations(capture.nGenerations());
+    theGA.setNMutate(capture.nMutate());
+    theGA.setNElite(capture.nElite());
+    theGA.setStallGenerations(capture.stallGenerations());
+    theGA.setMeanStallGenerations(capture.meanStallGenerations());
+    theGA.setStallTolerance(capture.stallTolerance());
+    theGA.setMinDiversity(capture.minDiversity());
+    theGA.setInitialPopulationSize(capture.initialPopulationSize());
+    theGA.setInitialSampling(
+        static_cast<jpw_math::statistics::QuasiRandomSet::Method_t>(
+            capture.initialSampling()));
+    Model_t theModel(capture.theMap().size());
+    // Records the outcome.
+    measure::FitCapture rerun;
+    theGA.setProgressMonitor(&timer);
+    theGA.setCapture(&rerun);
+    theGA.setRandomStream(jpw_math::statistics::PhiloxRNG(
+                              capture.rngSeed(), capture.rngStream()));
+
+    double t0(wallClock());
+    for(unsigned r=0; r<nRepeats; ++r)
+    {
+        capture.restoreRandState();
+        result.params = capture.startParams();
+        timer.startRepeat();
+        theGA(result.params, capture.theMap(), theModel);
+    }
+    result.seconds = (wallClock() - t0)/nRepeats;
+    result.status = rerun.status();
+    result.chiSq = rerun.chiSq();
+    result.iterations = rerun.iterations();
+    result.functionEvals = rerun.functionEvals();
+}
+
+
+template<class F_POL_T>
+void replay(const FitCapture& capture, unsigned nRepeats,
+            IterationTimer& timer, ReplayResult& result)
+{
+    if(capture.fitter() == FitCapture::GeneticAlgorithm) {
+        replayGA<F_POL_T>(capture, nRepeats, timer, result);
+    } else {
+        replayLM<F_POL_T>(capture, nRepeats, timer, result);
+    }
+}
+
+
+void printParams(const dvector_t& params)
+{
+    cout << "[";
+    for(unsigned j=0; j<params.size(); ++j) {
+        cout << (j ? " " : "") << std::fixed << std::setprecision(6)
+             << params[j];
+    }
+    cout << "]";
+}
+
+
+void printOutcome(const char* label, int status, double chiSq,
+                  const dvector_t& params, unsigned iterations,
+                  unsigned functionEvals, double seconds)
+{
+    cout << "  " << std::left << setw(9) << label << std::right
+         << " status=" << setw(2) << status
+         << " chi^2=" << std::scientific << std::setprecision(6) << chiSq
+         << " iterations=" << setw(3) << iterations
+         << " f-evals=" << setw(4) << functionEvals
+         << " time=" << std::fixed << std::setprecision(4) << seconds
+         << "s" << endl
+         << "            params=";
+    printParams(params);
+    cout << endl;
+}
+
+
+bool replayFile(const string& filename, unsigned nRepeats)
+{
+    FitCapture capture;
+    try {
+        capture.load(filename);
+    } catch(std::exception& ex) {
+        cerr << ex.what() << endl;
+        return false;
+    }
+
+    bool isGA(capture.fitter() == FitCapture::GeneticAlgorithm);
+    cout << filename << ":  "
+         << (isGA ? "FitGA" : "FitLM_BarrierAdapter") << ", "
+         << capture.nParams() << " parameters, " << capture.theMap().nRows()
+         << 'x' << capture.theMap().nColumns() << " map" << endl
+         << "  start=";
+    printParams(capture.startParams());
+    cout << endl;
+    if(isGA) {
+        cout << "  population=" << capture.populationSize()
+             << " generations=" << capture.nGenerations() << endl;
+    } else {
+        cout << "  errtol=" << std::scientific << std::setprecision(1)
+             << capture.errorTolerance()
+             << " ptol=" << capture.paramTolerance()
+             << " maxiter=" << capture.maxIterations()
+             << " factor=" << std::fixed << capture.factor()
+             << " backend=" << capture.backend()
+             << " jacobian-mode=" << capture.jacobianMode()
+             << (capture.bounds().size() ? " bounded" : " unbounded")
+             << endl;
+    }
+
+    IterationTimer timer;
+    ReplayResult result;
+    try {
+        switch(capture.nParams())
+        {
+        case measure::policy::Full::N_PARAMETERS:
+            replay<measure::policy::Full>(capture, nRepeats, timer, result);
+            break;
+        case measure::policy::MarkovOnly::N_PARAMETERS:
+            replay<measure::policy::MarkovOnly>(capture, nRepeats, timer,
+                                                result);
+            break;
+        case measure::policy::BarrierOnly::N_PARAMETERS:
+            replay<measure::policy::BarrierOnly>(capture, nRepeats, timer,
+                                                 result);
+            break;
+        default:
+            throw std::runtime_error("No BarrierModel has that many "
+                                     "parameters.");
+        }
+    } catch(std::exception& ex) {
+        cerr << filename << ":  Can't replay:  " << ex.what() << endl;
+        return false;
+    }
+
+    printOutcome("captured", capture.status(), capture.chiSq(),
+                 capture.fittedParams(), capture.iterations(),
+                 capture.functionEvals(), capture.seconds());
+    printOutcome("replayed", result.status, result.chiSq, result.params,
+                 result.iterations, result.functionEvals, result.seconds);
+    bool identical = ( (result.status == capture.status()) &&
+                       (result.chiSq == capture.chiSq()) &&
+                       (result.params == capture.fittedParams()) );
+    cout << "  The replay " << (identical ? "matches" : "DIFFERS FROM")
+         << " the capture." << endl;
+    if(timer.differed) {
+        cout << "  The repeats took different numbers of iterations."
+             << endl;
+    }
+
+    cout << "  " << (isGA ? "generation" : " iteration")
+         << "         chi^2        ms   share" << endl;
+    double total(0.0);
+    for(unsigned k=0; k<timer.seconds.size(); ++k) {
+        total += timer.seconds[k];
+    }
+    for(unsigned k=0; k<timer.seconds.size(); ++k)
+    {
+        double ms(1000.0*timer.seconds[k]/timer.nRepeats);
+        cout << "  " << setw(10) << k
+             << "  " << std::scientific << std::setprecision(4)
+             << timer.chiSq[k]
+             << "  " << std::fixed << std::setprecision(3) << setw(8) << ms
+             << "  " << std::setprecision(1) << setw(5)
+             << (total > 0.0 ? 100.0*timer.seconds[k]/total : 0.0) << "%"
+             << endl;
+    }
+    cout << endl;
+    return identical;
+}
+
+
+int main(int argc, char* argv[])
+{
+    unsigned nRepeats(DEFAULT_REPEATS);
+    std::vector<string> files;
+    for(int a=1; a<argc; ++a)
+    {
+        string arg(argv[a]);
+        if( (arg == "-r") && (a+1 < argc) ) {
+            nRepeats = std::atoi(argv[++a]);
+        } else if( !arg.empty() && (arg[0] == '-') ) {
+            files.clear();
+            break;
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if(files.empty() || !nRepeats) {
+        cerr << "usage:  fitreplay [-r repeats] capture-file ..." << endl;
+        return EXIT_FAILURE;
+    }
+
+    bool allMatched(true);
+    for(unsigned f=0; f<files.size(); ++f) {
+        allMatched &= replayFile(files[f], nRepeats);
+    }
+    return (allMatched ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,339 @@
+// -*- C++ -*-
+// Unit Tests for the argsort and top-K selection functions.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+t_argsort_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <functional>
+
+#include <boost/test/minimal.hpp>
+
+#include "ArgSort.h"
+#include "ThreadTeam.h"
+#include "PhiloxRNG.h"
+
+
+//
+// Using Decls.
+//
+using namespace jpw_math;
+using std::vector;
+using std::deque;
+using std::size_t;
+using std::cout;
+using std::endl;
+using jpw_math::statistics::PhiloxRNG;
+
+
+//
+// Static variables
+//
+
+
+// The seed of the test data.  Change it to get different data.
+static const PhiloxRNG::seed_t SEED=0x5eed1e55;
+
+// The number of distinct values in the data with ties.
+static const unsigned N_DISTINCT=50;
+
+
+//
+// Typedefs
+//
+
+
+typedef vector<double> values_t;
+typedef vector<unsigned> order_t;
+
+
+/////////////////////////
+
+//
+// General Function Definitions
+//
+
+
+// Orders indices by their values, as for a stable sort.
+template<class COMPARE_T>
+struct ByValue
+{
+    ByValue(const values_t& values, COMPARE_T comp)
+        : m__values(values)
+        , m__comp(comp)
+    {}
+
+    bool operator()(unsigned a, unsigned b) const
+    { return m__comp(m__values[a], m__values[b]); }
+
+    const values_t& m__values;
+    COMPARE_T m__comp;
+};
+
+
+// The expected order of all of 'values':  std::stable_sort() of the
+// indices.
+template<class COMPARE_T>
+void stableOrder(const values_t& values, order_t& order, COMPARE_T comp)
+{
+    order.resize(values.size());
+    for(unsigned i=0; i<order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     ByValue<COMPARE_T>(values, comp));
+}
+
+
+// 'n' values, drawn from 'nDistinct' integers if it's nonzero.
+void makeValues(PhiloxRNG& rng, size_t n, unsigned nDistinct,
+                values_t& values)
+{
+    values.resize(n);
+    for(size_t i=0; i<n; ++i) {
+        values[i] = ( nDistinct ? double(rng.index(nDistinct))
+                      : rng.uniform() );
+    }
+}
+
+
+// true if the first 'k' elements of 'order' match those of 'expected'.
+template<class ORDER_T>
+bool sameFirstK(const ORDER_T& order, const order_t& expected, size_t k)
+{
+    k = std::min(k, expected.size());
+    if(order.size() != expected.size()) {
+        return false;
+    }
+    for(size_t i=0; i<k; ++i) {
+        if(order[i] != static_cast<typename ORDER_T::value_type>(
+               expected[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// true if 'order' holds each index of 'values' exactly once.
+template<class ORDER_T>
+bool isPermutation(const ORDER_T& order, size_t n)
+{
+    if(order.size() != n) {
+        return false;
+    }
+    vector<bool> seen(n, false);
+    for(size_t i=0; i<n; ++i) {
+        size_t idx(order[i]);
+        if( (idx >= n) || seen[idx] ) {
+            return false;
+        }
+        seen[idx] = true;
+    }
+    return true;
+}
+
+
+void printHeader(const char* title)
+{
+    cout << "============================================================="
+         << endl
+         << ":  " << title << endl;
+}
+
+
+/////////////////////////
+
+//
+// Tests
+//
+
+
+void testTies(PhiloxRNG& rng)
+{
+    printHeader("Ties are ordered by index");
+
+    values_t values;
+    order_t expected, order;
+    for(unsigned t=0; t<10; ++t)
+    {
+        size_t n(100 + rng.index(900));
+        makeValues(rng, n, N_DISTINCT, values);
+        stableOrder(values, expected, std::less<double>());
+
+        argSort(values, order);
+        BOOST_CHECK( sameFirstK(order, expected, n) );
+
+        size_t k(1 + rng.index(n/2));
+        argTopK(values, order, k);
+        BOOST_CHECK( sameFirstK(order, expected, k) );
+        BOOST_CHECK( isPermutation(order, n) );
+
+        // Any container of an integral type will do for the indices.
+        deque<long> dOrder;
+        argTopK(values, dOrder, k, std::less<double>());
+        BOOST_CHECK( sameFirstK(dOrder, expected, k) );
+    }
+}
+
+
+void testLargeK(PhiloxRNG& rng)
+{
+    printHeader("k >= n sorts everything");
+
+    values_t values;
+    order_t expected, order;
+    makeValues(rng, 257, N_DISTINCT, values);
+    stableOrder(values, expected, std::less<double>());
+
+    size_t n(values.size());
+    size_t kValues[] = { n - 1, n, n + 1, 10*n };
+    for(unsigned j=0; j<sizeof(kValues)/sizeof(kValues[0]); ++j) {
+        argTopK(values, order, kValues[j]);
+        BOOST_CHECK( sameFirstK(order, expected, kValues[j]) );
+        BOOST_CHECK( isPermutation(order, n) );
+    }
+
+    // Degenerate inputs.
+    values_t none;
+    argSort(none, order);
+    BOOST_CHECK( order.empty() );
+    argTopK(none, order, 5);
+    BOOST_CHECK( order.empty() );
+    values_t one(1, 3.0);
+    argTopK(one, order, 0);
+    BOOST_CHECK( (order.size() == 1) && (order[0] == 0) );
+}
+
+
+void testDescending(PhiloxRNG& rng)
+{
+    printHeader("Descending order");
+
+    values_t values;
+    order_t expected, order;
+    for(unsigned t=0; t<5; ++t)
+    {
+        makeValues(rng, 500, (t%2 ? N_DISTINCT : 0), values);
+        stableOrder(values, expected, std::greater<double>());
+
+        argSort(values, order, std::greater<double>());
+        BOOST_CHECK( sameFirstK(order, expected, values.size()) );
+
+        argTopK(values, order, 20, std::greater<double>());
+        BOOST_CHECK( sameFirstK(order, expected, 20) );
+        BOOST_CHECK( isPermutation(order, values.size()) );
+    }
+}
+
+
+void testPartition(PhiloxRNG& rng)
+{
+    printHeader("argPartition() selects the best k");
+
+    values_t values;
+    order_t expected, order;
+    makeValues(rng, 1000, N_DISTINCT, values);
+    stableOrder(values, expected, std::less<double>());
+
+    size_t k(100);
+    argPartition(values, order, k, std::less<double>());
+    BOOST_CHECK( isPermutation(order, values.size()) );
+    // Ties at the k-th value may be split either way, so compare the values.
+    order_t firstK(order.begin(), order.begin() + k);
+    double kthValue(values[expected[k-1]]);
+    for(size_t i=0; i<k; ++i) {
+        BOOST_CHECK( values[firstK[i]] <= kthValue );
+    }
+    for(size_t i=k; i<order.size(); ++i) {
+        BOOST_CHECK( values[order[i]] >= kthValue );
+    }
+}
+
+
+void testParallel(PhiloxRNG& rng)
+{
+    printHeader("The ThreadTeam overload matches the serial one");
+
+    jpw_nld::ThreadTeam team(4);
+    jpw_nld::ThreadTeam soloTeam(1);
+
+    values_t values;
+    order_t expected, order, serial;
+    // Ties, distinct values, and a size that doesn't split evenly.
+    size_t sizes[] = { 4*ARG_TOPK_PARALLEL_MIN_SIZE,
+                       4*ARG_TOPK_PARALLEL_MIN_SIZE,
+                       ARG_TOPK_PARALLEL_MIN_SIZE + 4093 };
+    unsigned nDistinct[] = { N_DISTINCT, 0, 7 };
+    for(unsigned t=0; t<3; ++t)
+    {
+        makeValues(rng, sizes[t], nDistinct[t], values);
+        size_t n(values.size());
+        stableOrder(values, expected, std::less<double>());
+
+        // k*nChunks < n takes the parallel path; the rest fall back to the
+        // serial one.
+        size_t kValues[] = { 1, 40, 1000, n/4, n };
+        for(unsigned j=0; j<sizeof(kValues)/sizeof(kValues[0]); ++j)
+        {
+            size_t k(kValues[j]);
+            argTopK(values, order, k, std::less<double>(), team);
+            BOOST_CHECK( sameFirstK(order, expected, k) );
+            BOOST_CHECK( isPermutation(order, n) );
+
+            argTopK(values, serial, k, std::less<double>(), soloTeam);
+            BOOST_CHECK( sameFirstK(serial, expected, k) );
+        }
+
+        argTopK(values, order, 25, std::greater<double>(), team);
+        argTopK(values, serial, 25, std::greater<double>());
+        BOOST_CHECK( sameFirstK(order, serial, 25) );
+    }
+}
+
+
+//
+// Functions "test_main()"
+// {No need for a separate "cxx_main()" when using boost::test, as it will
+// perform exception handling.}
+//
+
+
+int test_main(int, char*[])
+{
+    PhiloxRNG rng(SEED);
+    cout << "Seed: " << std::hex << std::showbase << SEED << std::dec
+         << std::noshowbase << endl;
+
+    testTies(rng);
+    testLargeK(rng);
+    testDescending(rng);
+    testPartition(rng);
+    testParallel(rng);
+
+    return 0;
+}
+
+
+/////////////////////////
+//
+// End
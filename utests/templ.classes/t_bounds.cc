@@ -0,0 +1,438 @@
+// -*- C++ -*-
+// Unit Tests for ParamBounds and the projected Levenberg-Marquardt fit.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+t_bounds_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <boost/test/minimal.hpp>
+
+#include "ParamBounds.h"
+#include "FitLM.h"
+
+
+//
+// Using Decls.
+//
+using std::cout;
+using std::endl;
+using jpw_nld::fortlib::ParamBounds;
+using jpw_nld::fortlib::FitLM;
+using jpw_nld::fortlib::fort_ivar_t;
+using jpw_nld::fortlib::fort_dvec_t;
+using jpw_nld::fortlib::fort_dmat_t;
+
+
+//
+// Static variables
+//
+
+
+// The tolerance of the fits, and of comparing their results.
+static const double FIT_TOL=1.0e-10;
+static const double RESULT_TOL=1.0e-6;
+
+// The fits' damping factor.
+static const double LM_FACTOR=100.0;
+
+// The target of the periodic fit.  Starting from 0.1, the shortest way
+// there crosses the wrap at 0.
+static const double PERIODIC_TARGET=0.9;
+
+// The largest value of x[0] that a fit-function was called with.
+static double g_maxX0;
+// The smallest magnitude of x[0] that a fit-function was called with.
+static double g_minAbsX0;
+
+
+/////////////////////////
+
+//
+// General Function Definitions
+//
+
+
+void printHeader(const char* title)
+{
+    cout << "============================================================="
+         << endl
+         << ":  " << title << endl;
+}
+
+
+bool near(double a, double b)
+{
+    return ( std::fabs(a - b) <= RESULT_TOL );
+}
+
+
+void resetDomainCheck()
+{
+    g_maxX0 = -std::numeric_limits<double>::infinity();
+    g_minAbsX0 = std::numeric_limits<double>::infinity();
+}
+
+
+void recordX0(double x0)
+{
+    g_maxX0 = std::max(g_maxX0, x0);
+    g_minAbsX0 = std::min(g_minAbsX0, std::fabs(x0));
+}
+
+
+// Linear residuals, with the unconstrained minimum at (3, 1):
+//     f = { x0 - 3, x1 - 1, x0 + x1 - 4 }
+void linearFcn(fort_ivar_t, fort_ivar_t, fort_dvec_t x, fort_dvec_t fvec,
+               fort_dmat_t fjac, fort_ivar_t ldfjac, fort_ivar_t iflag)
+{
+    recordX0(x[0]);
+    if(*iflag == 1) {
+        fvec[0] = x[0] - 3.0;
+        fvec[1] = x[1] - 1.0;
+        fvec[2] = x[0] + x[1] - 4.0;
+    } else if(*iflag == 2) {
+        int ld(*ldfjac);
+        fjac[0] = 1.0;  fjac[ld] = 0.0;
+        fjac[1] = 0.0;  fjac[1 + ld] = 1.0;
+        fjac[2] = 1.0;  fjac[2 + ld] = 1.0;
+    }
+}
+
+
+// Rosenbrock's function, with its unconstrained minimum at (1, 1):
+//     f = { 10*(x1 - x0^2), 1 - x0 }
+void rosenbrockFcn(fort_ivar_t, fort_ivar_t, fort_dvec_t x, fort_dvec_t fvec,
+                   fort_dmat_t fjac, fort_ivar_t ldfjac, fort_ivar_t iflag)
+{
+    recordX0(x[0]);
+    if(*iflag == 1) {
+        fvec[0] = 10.0*(x[1] - x[0]*x[0]);
+        fvec[1] = 1.0 - x[0];
+    } else if(*iflag == 2) {
+        int ld(*ldfjac);
+        fjac[0] = -20.0*x[0];  fjac[ld] = 10.0;
+        fjac[1] = -1.0;        fjac[1 + ld] = 0.0;
+    }
+}
+
+
+// A point on the unit circle, at a phase of x0 turns:
+//     f = { cos(2 pi x0) - cos(2 pi t), sin(2 pi x0) - sin(2 pi t) }
+void circleFcn(fort_ivar_t, fort_ivar_t, fort_dvec_t x, fort_dvec_t fvec,
+               fort_dmat_t fjac, fort_ivar_t, fort_ivar_t iflag)
+{
+    recordX0(x[0]);
+    double theta(2.0*M_PI*x[0]);
+    double target(2.0*M_PI*PERIODIC_TARGET);
+    if(*iflag == 1) {
+        fvec[0] = std::cos(theta) - std::cos(target);
+        fvec[1] = std::sin(theta) - std::sin(target);
+    } else if(*iflag == 2) {
+        fjac[0] = -2.0*M_PI*std::sin(theta);
+        fjac[1] = 2.0*M_PI*std::cos(theta);
+    }
+}
+
+
+// Even in x0, with its minima at x0 = +/-2:
+//     f = { x0^2 - 4, 0.1*x0^2 }
+void evenFcn(fort_ivar_t, fort_ivar_t, fort_dvec_t x, fort_dvec_t fvec,
+             fort_dmat_t fjac, fort_ivar_t, fort_ivar_t iflag)
+{
+    recordX0(x[0]);
+    if(*iflag == 1) {
+        fvec[0] = x[0]*x[0] - 4.0;
+        fvec[1] = 0.1*x[0]*x[0];
+    } else if(*iflag == 2) {
+        fjac[0] = 2.0*x[0];
+        fjac[1] = 0.2*x[0];
+    }
+}
+
+
+/////////////////////////
+
+//
+// Tests
+//
+
+
+void testProjectBounded()
+{
+    printHeader("project() clamps bounded parameters");
+
+    ParamBounds bounds(3);
+    bounds.setRange(0, -1.0, 2.0);
+    bounds.setLower(1, 0.5);
+    BOOST_CHECK( bounds.kind(2) == ParamBounds::Unbounded );
+    BOOST_CHECK( bounds.upper(1) == std::numeric_limits<double>::infinity() );
+
+    double x[] = { -7.0, 0.25, -1.0e300 };
+    bounds.project(x);
+    BOOST_CHECK( x[0] == -1.0 );
+    BOOST_CHECK( x[1] == 0.5 );
+    BOOST_CHECK( x[2] == -1.0e300 );
+
+    double y[] = { 2.5, 1.0e300, 42.0 };
+    bounds.project(y);
+    BOOST_CHECK( y[0] == 2.0 );
+    BOOST_CHECK( y[1] == 1.0e300 );
+    BOOST_CHECK( y[2] == 42.0 );
+
+    // On the bounds, and inside them, nothing moves.
+    double z[] = { -1.0, 0.5, 0.0 };
+    bounds.project(z);
+    BOOST_CHECK( (z[0] == -1.0) && (z[1] == 0.5) );
+    z[0] = 2.0;
+    bounds.project(z);
+    BOOST_CHECK( z[0] == 2.0 );
+    z[0] = 0.3;
+    bounds.project(z);
+    BOOST_CHECK( z[0] == 0.3 );
+}
+
+
+void testProjectPeriodic()
+{
+    printHeader("project() wraps periodic parameters");
+
+    ParamBounds bounds(2);
+    bounds.setPeriodic(0, 0.0, 1.0);
+    bounds.setPeriodic(1, -M_PI, 2.0*M_PI);
+
+    // The upper end of the period wraps to the lower one.
+    double x[] = { 1.0, M_PI };
+    bounds.project(x);
+    BOOST_CHECK( x[0] == 0.0 );
+    BOOST_CHECK( x[1] == -M_PI );
+
+    // Just below the lower end, the wrapped value rounds to the upper end;
+    // it must land on the lower one instead.
+    x[0] = -1.0e-17;
+    x[1] = -M_PI - 1.0e-16;
+    bounds.project(x);
+    BOOST_CHECK( (0.0 <= x[0]) && (x[0] < 1.0) );
+    BOOST_CHECK( (-M_PI <= x[1]) && (x[1] < M_PI) );
+
+    // Whole periods away, in either direction.
+    x[0] = 3.25;
+    x[1] = 0.5 - 6.0*M_PI;
+    bounds.project(x);
+    BOOST_CHECK( near(x[0], 0.25) );
+    BOOST_CHECK( near(x[1], 0.5) );
+    x[0] = -2.75;
+    bounds.project(x);
+    BOOST_CHECK( near(x[0], 0.25) );
+
+    // Inside the period, nothing moves.
+    x[0] = 0.999;
+    bounds.project(x);
+    BOOST_CHECK( x[0] == 0.999 );
+
+    // A bound replaces the period.
+    bounds.setUpper(0, 5.0);
+    BOOST_CHECK( bounds.kind(0) == ParamBounds::Bounded );
+    BOOST_CHECK( bounds.lower(0) == -std::numeric_limits<double>::infinity() );
+}
+
+
+void testProjectReflected()
+{
+    printHeader("project() reflects, then clamps, reflected parameters");
+
+    ParamBounds bounds(2);
+    bounds.setReflected(0, 1.0);
+    bounds.setReflected(1, 1.0, 4.0);
+
+    // Negative values move to the positive branch, unchanged otherwise.
+    double x[] = { -5.0, -3.0 };
+    bounds.project(x);
+    BOOST_CHECK( x[0] == 5.0 );
+    BOOST_CHECK( x[1] == 3.0 );
+
+    // Inside (-1, 1), on either side of 0, the magnitude is clamped.
+    double y[] = { -0.5, 0.25 };
+    bounds.project(y);
+    BOOST_CHECK( y[0] == 1.0 );
+    BOOST_CHECK( y[1] == 1.0 );
+    y[0] = 0.0;
+    y[1] = -1.0;
+    bounds.project(y);
+    BOOST_CHECK( y[0] == 1.0 );
+    BOOST_CHECK( y[1] == 1.0 );
+
+    // Past the upper bound, on either branch.
+    double z[] = { 1.0e300, -9.0 };
+    bounds.project(z);
+    BOOST_CHECK( z[0] == 1.0e300 );
+    BOOST_CHECK( z[1] == 4.0 );
+}
+
+
+void testFitActiveBound()
+{
+    printHeader("The projected fit stops on an active bound");
+
+    FitLM fitter(linearFcn, 3, 2);
+    ParamBounds bounds(2);
+    bounds.setUpper(0, 2.0);
+
+    // Unbounded first, for reference.
+    resetDomainCheck();
+    std::vector<double> x(2, 0.0);
+    FitLM::FitStatus_t status = fitter(3, x, FIT_TOL, FIT_TOL, 0, LM_FACTOR);
+    BOOST_CHECK( (status > FitLM::InputError) &&
+                 (status < FitLM::IterationOverflow) );
+    BOOST_CHECK( near(x[0], 3.0) && near(x[1], 1.0) );
+    BOOST_CHECK( g_maxX0 > 2.0 );
+    BOOST_CHECK( !fitter.bounds() );
+
+    // With x0 <= 2, the minimum moves to (2, 1.5).  The fit must never
+    // evaluate the model past the bound.
+    fitter.setBounds(bounds);
+    BOOST_CHECK( fitter.bounds() != 0 );
+    resetDomainCheck();
+    x[0] = 0.0;
+    x[1] = 0.0;
+    status = fitter(3, x, FIT_TOL, FIT_TOL, 0, LM_FACTOR);
+    BOOST_CHECK( (status > FitLM::InputError) &&
+                 (status < FitLM::IterationOverflow) );
+    BOOST_CHECK( near(x[0], 2.0) && near(x[1], 1.5) );
+    BOOST_CHECK( near(fitter.chiSquared(), 1.5) );
+    BOOST_CHECK( g_maxX0 <= 2.0 );
+    BOOST_CHECK( fitter.iterations() > 0 );
+    BOOST_CHECK( fitter.functionEvals() >= fitter.iterations() );
+
+    // A start past the bound is projected before the first evaluation.
+    resetDomainCheck();
+    x[0] = 10.0;
+    x[1] = -4.0;
+    status = fitter(3, x, FIT_TOL, FIT_TOL, 0, LM_FACTOR);
+    BOOST_CHECK( near(x[0], 2.0) && near(x[1], 1.5) );
+    BOOST_CHECK( g_maxX0 <= 2.0 );
+
+    // clearBounds() goes back to the unconstrained minimum.
+    fitter.clearBounds();
+    BOOST_CHECK( !fitter.bounds() );
+    x[0] = 0.0;
+    x[1] = 0.0;
+    fitter(3, x, FIT_TOL, FIT_TOL, 0, LM_FACTOR);
+    BOOST_CHECK( near(x[0], 3.0) && near(x[1], 1.0) );
+}
+
+
+void testFitCurvedValley()
+{
+    printHeader("The projected fit follows a curved valley to its bound");
+
+    // With x0 <= 0.5, the minimum of Rosenbrock's function moves to
+    // (0.5, 0.25), with chi^2 = 0.25.
+    FitLM fitter(rosenbrockFcn, 2, 2);
+    ParamBounds bounds(2);
+    bounds.setUpper(0, 0.5);
+    fitter.setBounds(bounds);
+
+    const double starts[][2] = { { -1.2, 1.0 }, { 0.0, 0.0 }, { -3.0, 5.0 },
+                                 { 2.0, 2.0 } };
+    for(unsigned s=0; s<sizeof(starts)/sizeof(starts[0]); ++s)
+    {
+        resetDomainCheck();
+        std::vector<double> x(starts[s], starts[s] + 2);
+        FitLM::FitStatus_t status = fitter(2, x, FIT_TOL, FIT_TOL, 0,
+                                           LM_FACTOR);
+        BOOST_CHECK( (status > FitLM::InputError) &&
+                     (status < FitLM::IterationOverflow) );
+        BOOST_CHECK( near(x[0], 0.5) && near(x[1], 0.25) );
+        BOOST_CHECK( near(fitter.chiSquared(), 0.25) );
+        BOOST_CHECK( g_maxX0 <= 0.5 );
+    }
+}
+
+
+void testFitPeriodic()
+{
+    printHeader("The projected fit wraps periodic parameters");
+
+    FitLM fitter(circleFcn, 2, 1);
+    ParamBounds bounds(1);
+    bounds.setPeriodic(0, 0.0, 1.0);
+    fitter.setBounds(bounds);
+
+    resetDomainCheck();
+    std::vector<double> x(1, 0.1);
+    FitLM::FitStatus_t status = fitter(2, x, FIT_TOL, FIT_TOL, 0,
+                                       LM_FACTOR);
+    BOOST_CHECK( (status > FitLM::InputError) &&
+                 (status < FitLM::IterationOverflow) );
+    BOOST_CHECK( (0.0 <= x[0]) && (x[0] < 1.0) );
+    BOOST_CHECK( near(x[0], PERIODIC_TARGET) );
+    BOOST_CHECK( near(fitter.chiSquared(), 0.0) );
+}
+
+
+void testFitReflected()
+{
+    printHeader("The projected fit keeps reflected parameters positive");
+
+    // The minima at +/-2 lie inside the excluded magnitudes, so the fit
+    // ends on the bound, at +2.5, even from a negative start.
+    FitLM fitter(evenFcn, 2, 1);
+    ParamBounds bounds(1);
+    bounds.setReflected(0, 2.5);
+    fitter.setBounds(bounds);
+
+    resetDomainCheck();
+    std::vector<double> x(1, -6.0);
+    FitLM::FitStatus_t status = fitter(2, x, FIT_TOL, FIT_TOL, 0,
+                                       LM_FACTOR);
+    BOOST_CHECK( (status > FitLM::InputError) &&
+                 (status < FitLM::IterationOverflow) );
+    BOOST_CHECK( near(x[0], 2.5) );
+    BOOST_CHECK( g_minAbsX0 >= 2.5 );
+}
+
+
+//
+// Functions "test_main()"
+// {No need for a separate "cxx_main()" when using boost::test, as it will
+// perform exception handling.}
+//
+
+
+int test_main(int, char*[])
+{
+    testProjectBounded();
+    testProjectPeriodic();
+    testProjectReflected();
+    testFitActiveBound();
+    testFitCurvedValley();
+    testFitPeriodic();
+    testFitReflected();
+
+    return 0;
+}
+
+
+/////////////////////////
+//
+// End
@@ -0,0 +1,308 @@
+// -*- C++ -*-
+// Unit Tests for the square_matrix_inversion functions.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+t_inverters_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+#include <boost/test/minimal.hpp>
+
+#include "Matrix.h"
+#include "details/Matrix.tcc"
+
+#include "FORTLib.h"
+
+
+//
+// Using Decls.
+//
+using std::cout;
+using std::endl;
+using jpw_math::dmatrix_t;
+using jpw_nld::fortlib::square_matrix_inversion::sqmInvert_GJE;
+using jpw_nld::fortlib::square_matrix_inversion::sqmInvert_SVD;
+
+
+//
+// Static variables
+//
+
+
+// The largest matrix tested.  Covers the closed-form sizes, 1, 2 and 4,
+// and Gauss-Jordan elimination, 3 and 5.
+static const unsigned MAX_N=5;
+
+// The tolerance of comparing an inverse against the known one.
+static const double RESULT_TOL=1.0e-12;
+
+// What the output matrix is filled with, to check that it's unchanged.
+static const double SENTINEL=-42.0;
+
+
+/////////////////////////
+
+//
+// General Function Definitions
+//
+
+
+void printHeader(const char* title)
+{
+    cout << "============================================================="
+         << endl
+         << ":  " << title << endl;
+}
+
+
+bool near(const dmatrix_t& a, const dmatrix_t& b)
+{
+    if( (a.nRows() != b.nRows()) || (a.nColumns() != b.nColumns()) ) {
+        return false;
+    }
+    for(unsigned i=0; i<a.nRows(); ++i) {
+        for(unsigned j=0; j<a.nColumns(); ++j) {
+            if(std::fabs(a[i][j] - b[i][j]) > RESULT_TOL) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+bool isSentinel(const dmatrix_t& m, unsigned nRows, unsigned nColumns)
+{
+    if( (m.nRows() != nRows) || (m.nColumns() != nColumns) ) {
+        return false;
+    }
+    for(unsigned i=0; i<nRows; ++i) {
+        for(unsigned j=0; j<nColumns; ++j) {
+            if(m[i][j] != SENTINEL) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+// The second-difference matrix, with 2 on the diagonal and -1 next to
+// it.  Its inverse is known in closed form:
+//     inv[i][j] = (min(i,j)+1)*(n-max(i,j))/(n+1)
+void secondDifference(unsigned n, dmatrix_t& m, dmatrix_t& mInv)
+{
+    m = dmatrix_t(n, n, 0.0);
+    mInv = dmatrix_t(n, n);
+    for(unsigned i=0; i<n; ++i) {
+        m[i][i] = 2.0;
+        if(i > 0) {
+            m[i][i-1] = -1.0;
+            m[i-1][i] = -1.0;
+        }
+        for(unsigned j=0; j<n; ++j) {
+            unsigned lo(std::min(i, j));
+            unsigned hi(std::max(i, j));
+            mInv[i][j] = double((lo + 1)*(n - hi))/double(n + 1);
+        }
+    }
+}
+
+
+// A scaled cyclic shift, whose diagonal is all 0 (for n>1), so that
+// every pivot has to come from off of it:
+//     m[i][(i+1)%n] = i+2,  inv[(i+1)%n][i] = 1/(i+2)
+void scaledShift(unsigned n, dmatrix_t& m, dmatrix_t& mInv)
+{
+    m = dmatrix_t(n, n, 0.0);
+    mInv = dmatrix_t(n, n, 0.0);
+    for(unsigned i=0; i<n; ++i) {
+        m[i][(i+1)%n] = i + 2.0;
+        mInv[(i+1)%n][i] = 1.0/(i + 2.0);
+    }
+}
+
+
+// Of rank 2, but its elements aren't exact, so neither are its pivots or
+// its determinant 0.
+dmatrix_t inexactRank2(unsigned n)
+{
+    dmatrix_t m(n, n);
+    for(unsigned i=0; i<n; ++i) {
+        for(unsigned j=0; j<n; ++j) {
+            m[i][j] = 0.1*(i + 1) + 0.3*(j + 1);
+        }
+    }
+    return m;
+}
+
+
+/////////////////////////
+
+//
+// Tests
+//
+
+
+void testKnownInverses()
+{
+    printHeader("Both inverters give the known inverses");
+
+    for(unsigned n=1; n<=MAX_N; ++n)
+    {
+        dmatrix_t m(1, 1), expected(1, 1), result(1, 1);
+
+        secondDifference(n, m, expected);
+        BOOST_CHECK( sqmInvert_GJE(m, result) == 0 );
+        BOOST_CHECK( near(result, expected) );
+        result.wipe();
+        BOOST_CHECK( sqmInvert_SVD(m, result) == 0 );
+        BOOST_CHECK( near(result, expected) );
+
+        scaledShift(n, m, expected);
+        BOOST_CHECK( sqmInvert_GJE(m, result) == 0 );
+        BOOST_CHECK( near(result, expected) );
+        BOOST_CHECK( sqmInvert_SVD(m, result) == 0 );
+        BOOST_CHECK( near(result, expected) );
+    }
+}
+
+
+void testSingular()
+{
+    printHeader("sqmInvert_GJE() rejects singular matrices");
+
+    for(unsigned n=1; n<=MAX_N; ++n)
+    {
+        // All zeroes, and all ones, which is of rank 1.
+        dmatrix_t zeroes(n, n, 0.0);
+        dmatrix_t result(2, 3, SENTINEL);
+        BOOST_CHECK( sqmInvert_GJE(zeroes, result) != 0 );
+        BOOST_CHECK( isSentinel(result, 2, 3) );
+
+        if(n > 1) {
+            dmatrix_t ones(n, n, 1.0);
+            dmatrix_t sameShape(n, n, SENTINEL);
+            BOOST_CHECK( sqmInvert_GJE(ones, sameShape) != 0 );
+            BOOST_CHECK( isSentinel(sameShape, n, n) );
+        }
+
+        if(n > 2) {
+            dmatrix_t sameShape(n, n, SENTINEL);
+            BOOST_CHECK( sqmInvert_GJE(inexactRank2(n), sameShape) != 0 );
+            BOOST_CHECK( isSentinel(sameShape, n, n) );
+        }
+    }
+}
+
+
+void testRankDeficientSVD()
+{
+    printHeader("sqmInvert_SVD() drops the zero singular values");
+
+    for(unsigned n=1; n<=MAX_N; ++n)
+    {
+        dmatrix_t zeroes(n, n, 0.0);
+        dmatrix_t result(1, 1);
+        BOOST_CHECK( sqmInvert_SVD(zeroes, result) == int(n) );
+        BOOST_CHECK( near(result, zeroes) );
+
+        // The pseudo-inverse of the all-ones matrix is itself, over n^2.
+        dmatrix_t ones(n, n, 1.0);
+        BOOST_CHECK( sqmInvert_SVD(ones, result) == int(n - 1) );
+        BOOST_CHECK( near(result, dmatrix_t(n, n, 1.0/(n*n))) );
+
+        if(n > 2) {
+            BOOST_CHECK( sqmInvert_SVD(inexactRank2(n), result) ==
+                         int(n - 2) );
+        }
+    }
+
+    // Rank 2:  the second-difference matrix, with its outer rows and
+    // columns zeroed.  Its pseudo-inverse is the inverse of the middle.
+    dmatrix_t m(1, 1), expected(1, 1), unused(1, 1);
+    secondDifference(4, m, unused);
+    for(unsigned k=0; k<4; ++k) {
+        m[0][k] = m[k][0] = 0.0;
+        m[3][k] = m[k][3] = 0.0;
+    }
+    secondDifference(2, unused, expected);
+    dmatrix_t result(1, 1);
+    BOOST_CHECK( sqmInvert_SVD(m, result) == 2 );
+    BOOST_CHECK( result.nRows() == 4 );
+    for(unsigned i=0; i<4; ++i) {
+        for(unsigned j=0; j<4; ++j) {
+            bool middle( (i == 1 || i == 2) && (j == 1 || j == 2) );
+            double want( middle ? expected[i-1][j-1] : 0.0 );
+            BOOST_CHECK( std::fabs(result[i][j] - want) <= RESULT_TOL );
+        }
+    }
+}
+
+
+void testInPlace()
+{
+    printHeader("Inverting a matrix in place");
+
+    for(unsigned n=1; n<=MAX_N; ++n)
+    {
+        dmatrix_t m(1, 1), expected(1, 1);
+
+        secondDifference(n, m, expected);
+        BOOST_CHECK( sqmInvert_GJE(m, m) == 0 );
+        BOOST_CHECK( near(m, expected) );
+
+        scaledShift(n, m, expected);
+        BOOST_CHECK( sqmInvert_GJE(m, m) == 0 );
+        BOOST_CHECK( near(m, expected) );
+
+        scaledShift(n, m, expected);
+        BOOST_CHECK( sqmInvert_SVD(m, m) == 0 );
+        BOOST_CHECK( near(m, expected) );
+
+        // A failed in-place inversion leaves the matrix alone.
+        dmatrix_t zeroes(n, n, 0.0);
+        BOOST_CHECK( sqmInvert_GJE(zeroes, zeroes) != 0 );
+        BOOST_CHECK( near(zeroes, dmatrix_t(n, n, 0.0)) );
+    }
+}
+
+
+//
+// Functions "test_main()"
+// {No need for a separate "cxx_main()" when using boost::test, as it will
+// perform exception handling.}
+//
+
+
+int test_main(int, char*[])
+{
+    testKnownInverses();
+    testSingular();
+    testRankDeficientSVD();
+    testInPlace();
+
+    return 0;
+}
+
+
+/////////////////////////
+//
+// End
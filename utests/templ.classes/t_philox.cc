@@ -0,0 +1,219 @@
+// -*- C++ -*-
+// Unit Tests for the PhiloxRNG counter-based pRNG.
+//
+// Copyright (C) 2015 by John Weiss
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Artistic License, included as the file
+// "LICENSE" in the source code archive.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// You should have received a copy of the file "LICENSE", containing
+// the License John Weiss originally placed this program under.
+//
+static const char* const
+t_philox_cc__="RCS $Id$";
+
+
+// Includes
+//
+#include <iostream>
+#include <string>
+
+#include <boost/test/minimal.hpp>
+
+#include "PhiloxRNG.h"
+
+
+//
+// Using Decls.
+//
+using std::string;
+using std::cout;
+using std::endl;
+using jpw_math::statistics::PhiloxRNG;
+
+
+//
+// Typedefs
+//
+
+
+typedef PhiloxRNG::word_t word_t;
+typedef PhiloxRNG::seed_t seed_t;
+
+
+//
+// Static variables
+//
+
+
+// 2^53:  uniform() returns a multiple of its inverse.
+static const double TWO_TO_53=9007199254740992.0;
+
+
+// One known-answer test:  a counter and key, and the block they give.
+struct KnownAnswer
+{
+    word_t counter[4];
+    word_t key[2];
+    word_t expected[4];
+};
+
+
+// The philox4x32-10 vectors from the Random123 distribution's
+// kat_vectors file.
+static const KnownAnswer RANDOM123_KAT[] = {
+    { { 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+      { 0x00000000, 0x00000000 },
+      { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+    { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+      { 0xffffffff, 0xffffffff },
+      { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+    { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 },
+      { 0xa4093822, 0x299f31d0 },
+      { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } }
+};
+static const unsigned N_KAT=sizeof(RANDOM123_KAT)/sizeof(RANDOM123_KAT[0]);
+
+
+// The seed and stream of the pinned streams below.
+static const seed_t PINNED_SEED=0x0123456789abcdefULL;
+static const seed_t PINNED_STREAM=42;
+
+
+/////////////////////////
+
+//
+// General Function Definitions
+//
+
+
+void printHeader(const char* title)
+{
+    cout << "============================================================="
+         << endl
+         << ":  " << title << endl;
+}
+
+
+// The first uniform() of a block, computed as PhiloxRNG does.
+double firstUniform(const word_t block[4])
+{
+    double hi(block[0] >> 5);
+    double lo(block[1] >> 6);
+    return ( (hi*67108864.0 + lo)/TWO_TO_53 );
+}
+
+
+/////////////////////////
+
+//
+// Tests
+//
+
+
+void testKnownAnswers()
+{
+    printHeader("PhiloxRNG::block() matches Random123");
+
+    for(unsigned t=0; t<N_KAT; ++t)
+    {
+        const KnownAnswer& kat(RANDOM123_KAT[t]);
+        word_t block[4] = { kat.counter[0], kat.counter[1],
+                            kat.counter[2], kat.counter[3] };
+        PhiloxRNG::block(block, kat.key);
+        for(unsigned i=0; i<4; ++i) {
+            BOOST_CHECK( block[i] == kat.expected[i] );
+        }
+    }
+}
+
+
+// The counter holds the position in its low words and the stream in its
+// high ones; the key is the seed.
+void testStreamLayout()
+{
+    printHeader("Each block hashes the position and the stream");
+
+    PhiloxRNG rng(PINNED_SEED, PINNED_STREAM);
+    BOOST_CHECK( rng.seed() == PINNED_SEED );
+    BOOST_CHECK( rng.stream() == PINNED_STREAM );
+    const word_t key[2] = { static_cast<word_t>(PINNED_SEED),
+                            static_cast<word_t>(PINNED_SEED >> 32) };
+    for(word_t position=0; position<3; ++position)
+    {
+        word_t block[4] = { position, 0,
+                            static_cast<word_t>(PINNED_STREAM), 0 };
+        PhiloxRNG::block(block, key);
+        BOOST_CHECK( rng.uniform() == firstUniform(block) );
+        // The second half of the block.
+        rng.uniform();
+        BOOST_CHECK( rng.position() == position + 1 );
+    }
+}
+
+
+// Pins the values that the seeded FitGA, FitDE and randomParams() runs
+// are built on.  If one of these changes, so does every seeded result.
+void testPinnedValues()
+{
+    printHeader("Seeded streams give the same values as always");
+
+    PhiloxRNG rng(PINNED_SEED, PINNED_STREAM);
+    const double expected[] = { 6604879778035012.0, 2026486309206070.0,
+                                3704482910542172.0, 5366987980513075.0 };
+    for(unsigned i=0; i<4; ++i) {
+        BOOST_CHECK( rng.uniform()*TWO_TO_53 == expected[i] );
+    }
+
+    // split() doesn't depend on how much of the parent has been used.
+    PhiloxRNG child(rng.split(5));
+    BOOST_CHECK( child.seed() == PINNED_SEED );
+    BOOST_CHECK( child.stream() == 0x3fef619d8f90ab07ULL );
+    BOOST_CHECK( child.position() == 0 );
+    BOOST_CHECK( child.uniform()*TWO_TO_53 == 5599703005162814.0 );
+    BOOST_CHECK( child.uniform()*TWO_TO_53 == 8591131531649245.0 );
+    PhiloxRNG fresh(PINNED_SEED, PINNED_STREAM);
+    BOOST_CHECK( fresh.split(5).stream() == child.stream() );
+
+    PhiloxRNG grandchild(fresh.split(1).split(2));
+    BOOST_CHECK( grandchild.stream() == 0x1d991f41ae2cc880ULL );
+    BOOST_CHECK( grandchild.uniform()*TWO_TO_53 == 1425524318800998.0 );
+    BOOST_CHECK( fresh.split(1).stream() != fresh.split(2).stream() );
+
+    PhiloxRNG fromString(string("0x1234abcd5678"));
+    BOOST_CHECK( fromString.seed() == 0x1234abcd5678ULL );
+    BOOST_CHECK( fromString.stream() == 0 );
+    BOOST_CHECK( fromString.uniform()*TWO_TO_53 == 6295057463355311.0 );
+
+    PhiloxRNG indices(99);
+    const unsigned expectedIdx[] = { 706, 388, 726, 764, 447 };
+    for(unsigned i=0; i<5; ++i) {
+        BOOST_CHECK( indices.index(1000) == expectedIdx[i] );
+    }
+}
+
+
+//
+// Functions "test_main()"
+// {No need for a separate "cxx_main()" when using boost::test, as it will
+// perform exception handling.}
+//
+
+
+int test_main(int, char*[])
+{
+    testKnownAnswers();
+    testStreamLayout();
+    testPinnedValues();
+
+    return 0;
+}
+
+
+/////////////////////////
+//
+// End